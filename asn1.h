@@ -117,6 +117,18 @@ struct asn1_oid {
 	u_int16_t value[10];
 };
 
+/*! \brief Definite length strings left in the ASN.1 buffer instead of copied. */
+struct asn1_string_views {
+	/*! \brief Number of recorded string views. */
+	unsigned num_views;
+	struct {
+		/*! \brief String buffer the string was not copied to. */
+		const unsigned char *buf;
+		/*! \brief String in the ASN.1 buffer. (Not null terminated) */
+		const unsigned char *str;
+	} view[16];
+};
+
 #define ASN1_CALL(new_pos, do_it)   \
 	do                              \
 	{                               \
@@ -189,6 +201,13 @@ const unsigned char *asn1_dec_string_bin(struct pri *ctrl, const char *name,
 const unsigned char *asn1_dec_string_max(struct pri *ctrl, const char *name,
 	unsigned tag, const unsigned char *pos, const unsigned char *end, size_t buf_size,
 	unsigned char *str, size_t *str_len);
+const unsigned char *asn1_dec_string_bin_view(struct pri *ctrl, const char *name,
+	unsigned tag, const unsigned char *pos, const unsigned char *end, size_t buf_size,
+	unsigned char *str, size_t *str_len);
+const unsigned char *asn1_dec_string_max_view(struct pri *ctrl, const char *name,
+	unsigned tag, const unsigned char *pos, const unsigned char *end, size_t buf_size,
+	unsigned char *str, size_t *str_len);
+const unsigned char *asn1_string_view(struct pri *ctrl, const unsigned char *buf);
 
 const char *asn1_tag2str(unsigned tag);
 void asn1_dump(struct pri *ctrl, const unsigned char *start_asn1,
@@ -226,9 +245,44 @@ void asn1_dump(struct pri *ctrl, const unsigned char *start_asn1,
 #define ASN1_CONSTRUCTED_END(len_pos, component_end, end)   \
 	ASN1_CALL((component_end), asn1_enc_length_fixup((len_pos), (component_end), (end)))
 
+/*!
+ * \brief Use to begin encoding constructed groupings whose body length is known.
+ *
+ * \note The final length is encoded up front so the body is never moved.
+ */
+#define ASN1_CONSTRUCTED_BEGIN_SIZED(component_end_save, pos, end, tag, length) \
+	do {                                                            \
+		if ((end) < (pos) + 1) {                                    \
+			return NULL;                                            \
+		}                                                           \
+		*(pos)++ = (tag) | ASN1_PC_CONSTRUCTED;                     \
+		ASN1_CALL((pos), asn1_enc_length((pos), (end), (length)));  \
+		(component_end_save) = (pos) + (length);                    \
+	} while (0)
+
 #define ASN1_ENC_ERROR(ctrl, msg) \
 	pri_error((ctrl), "%s error: %s\n", __FUNCTION__, (msg))
 
+/*! \brief Use to end encoding groupings started by ASN1_CONSTRUCTED_BEGIN_SIZED(). */
+#define ASN1_CONSTRUCTED_END_SIZED(ctrl, component_end, pos)        \
+	do {                                                            \
+		if ((pos) != (component_end)) {                             \
+			ASN1_ENC_ERROR((ctrl), "Precomputed length was wrong"); \
+			return NULL;                                            \
+		}                                                           \
+	} while (0)
+
+size_t asn1_enc_length_size(size_t length);
+size_t asn1_enc_tlv_size(size_t length);
+size_t asn1_enc_int_size(int32_t value);
+size_t asn1_enc_oid_size(const struct asn1_oid *oid);
+size_t asn1_enc_string_max_size(const unsigned char *str, size_t max_len);
+
+/*! \brief Encoded size of the boolean type primitive. */
+#define ASN1_ENC_BOOLEAN_SIZE	3
+/*! \brief Encoded size of the null type primitive. */
+#define ASN1_ENC_NULL_SIZE		2
+
 unsigned char *asn1_enc_length(unsigned char *len_pos, unsigned char *end,
 	size_t str_len);
 unsigned char *asn1_enc_length_fixup(unsigned char *len_pos,
@@ -811,6 +811,155 @@ const unsigned char *asn1_dec_string_max(struct pri *ctrl, const char *name,
 	return pos;
 }
 
+/*!
+ * \internal
+ * \brief Leave a decoded definite length string in the ASN.1 buffer.
+ *
+ * \param ctrl D channel controller for any diagnostic messages.
+ * \param str String buffer the string is not copied to.
+ * \param body Start of the string in the ASN.1 buffer.
+ *
+ * \retval TRUE if the string view was recorded.
+ * \retval FALSE if the string must be copied to str.
+ */
+static int asn1_string_view_add(struct pri *ctrl, unsigned char *str,
+	const unsigned char *body)
+{
+	struct asn1_string_views *views;
+
+	views = ctrl->rose_string_views;
+	if (!views || ARRAY_LEN(views->view) <= views->num_views) {
+		return 0;
+	}
+	views->view[views->num_views].buf = str;
+	views->view[views->num_views].str = body;
+	++views->num_views;
+
+	/* Anything not looking for the view sees an empty string. */
+	str[0] = 0;
+
+	return 1;
+}
+
+/*!
+ * \brief Find where a string decoded by an asn1_dec_string_xxx_view() was left.
+ *
+ * \param ctrl D channel controller that decoded the string.
+ * \param buf String buffer passed to the decoder.
+ *
+ * \note The returned string is not null terminated.
+ *
+ * \return String in the ASN.1 buffer or NULL if the string is in buf.
+ */
+const unsigned char *asn1_string_view(struct pri *ctrl, const unsigned char *buf)
+{
+	struct asn1_string_views *views;
+	unsigned idx;
+
+	views = ctrl->rose_string_views;
+	if (!views) {
+		return NULL;
+	}
+	/* Search newest first in case the buffer was decoded into again. */
+	for (idx = views->num_views; idx--;) {
+		if (views->view[idx].buf == buf) {
+			return views->view[idx].str;
+		}
+	}
+	return NULL;
+}
+
+/*!
+ * \brief Decode a binary string primitive in place if possible.
+ *
+ * \param ctrl D channel controller for any diagnostic messages.
+ * \param name Field name
+ * \param tag Component tag that identified this primitive.
+ * \param pos Starting position of the ASN.1 component length.
+ * \param end End of ASN.1 decoding data buffer.
+ * \param buf_size Size of the supplied string buffer. (Must be nonzero)
+ * \param str Where to put the decoded string if it is not left in place.
+ * \param str_len Length of the decoded string.
+ *
+ * \note A definite length string is left in the ASN.1 decoding buffer
+ * when ctrl->rose_string_views has room to record it.  Use
+ * asn1_string_view() to find it.  Otherwise, this is asn1_dec_string_bin().
+ * \note A view is found by the address of str, which is left empty.  A
+ * copy of the structure holding str has an empty string with no view.
+ * \note The parse will fail if the parsed string is too large for
+ * the supplied buffer.
+ *
+ * \retval Start of the next ASN.1 component on success.
+ * \retval NULL on error.
+ */
+const unsigned char *asn1_dec_string_bin_view(struct pri *ctrl, const char *name,
+	unsigned tag, const unsigned char *pos, const unsigned char *end, size_t buf_size,
+	unsigned char *str, size_t *str_len)
+{
+	const unsigned char *body;
+	int length;
+
+	ASN1_CALL(body, asn1_dec_length(pos, end, &length));
+	if (length < 0 || buf_size - 1 < length || !asn1_string_view_add(ctrl, str, body)) {
+		return asn1_dec_string_bin(ctrl, name, tag, pos, end, buf_size, str, str_len);
+	}
+	*str_len = length;
+
+	if (ctrl->debug & PRI_DEBUG_APDU) {
+		/* Dump the string contents. */
+		pri_message(ctrl, "  %s %s =\n", name, asn1_tag2str(tag));
+		asn1_dump_mem(ctrl, 4, body, length);
+	}
+
+	return body + length;
+}
+
+/*!
+ * \brief Decode a string that can be truncated to a maximum length primitive in place if possible.
+ *
+ * \param ctrl D channel controller for any diagnostic messages.
+ * \param name Field name
+ * \param tag Component tag that identified this primitive.
+ * \param pos Starting position of the ASN.1 component length.
+ * \param end End of ASN.1 decoding data buffer.
+ * \param buf_size Size of the supplied string buffer. (Must be nonzero)
+ * \param str Where to put the decoded string if it is not left in place.
+ * \param str_len Length of the decoded string.
+ *
+ * \note A definite length string is left in the ASN.1 decoding buffer
+ * when ctrl->rose_string_views has room to record it.  Use
+ * asn1_string_view() to find it.  Otherwise, this is asn1_dec_string_max().
+ * \note The view is looked up by the str buffer address and str is left
+ * empty.  Copy the string out before copying the structure holding str.
+ * \note The parsed string will be truncated if the string buffer
+ * cannot contain it.
+ *
+ * \retval Start of the next ASN.1 component on success.
+ * \retval NULL on error.
+ */
+const unsigned char *asn1_dec_string_max_view(struct pri *ctrl, const char *name,
+	unsigned tag, const unsigned char *pos, const unsigned char *end, size_t buf_size,
+	unsigned char *str, size_t *str_len)
+{
+	const unsigned char *body;
+	int length;
+
+	ASN1_CALL(body, asn1_dec_length(pos, end, &length));
+	if (length < 0 || !asn1_string_view_add(ctrl, str, body)) {
+		return asn1_dec_string_max(ctrl, name, tag, pos, end, buf_size, str, str_len);
+	}
+
+	/* This is a definite length string.  Truncate it if necessary. */
+	*str_len = (buf_size - 1 < length) ? buf_size - 1 : length;
+
+	if (ctrl->debug & PRI_DEBUG_APDU) {
+		pri_message(ctrl, "  %s %s = \"%.*s\"\n", name, asn1_tag2str(tag),
+			(int) *str_len, (const char *) body);
+	}
+
+	return body + length;
+}
+
 /*!
  * \internal
  * \brief Recursive ASN.1 buffer decoding dump helper.
@@ -956,6 +1105,137 @@ void asn1_dump(struct pri *ctrl, const unsigned char *start_asn1,
 	pri_message(ctrl, "ASN.1 end\n");
 }
 
+/*!
+ * \brief Determine how many octets encoding an ASN.1 component length takes.
+ *
+ * \param length Component body length.
+ *
+ * \return Number of octets needed to encode the length.
+ */
+size_t asn1_enc_length_size(size_t length)
+{
+	u_int32_t body_length;		/* Length of component contents */
+	u_int32_t test_mask;
+	unsigned length_size;		/* Length of the length encoding */
+
+	body_length = length;
+	if (body_length < 128) {
+		return 1;
+	}
+
+	/* Find most significant octet of 32 bit integer that carries meaning. */
+	test_mask = 0xFF000000;
+	for (length_size = 4; --length_size;) {
+		if (body_length & test_mask) {
+			/*
+			 * Found the first 8 bits of a multiple octet length that
+			 * is not all zeroes.
+			 */
+			break;
+		}
+		test_mask >>= 8;
+	}
+	return length_size + 1 + 1;
+}
+
+/*!
+ * \brief Determine the encoded size of an ASN.1 component.
+ *
+ * \param length Component body length.
+ *
+ * \return Number of octets the tag, length, and body of the component take.
+ */
+size_t asn1_enc_tlv_size(size_t length)
+{
+	return 1 + asn1_enc_length_size(length) + length;
+}
+
+/*!
+ * \internal
+ * \brief Determine how many octets encoding an integer value takes.
+ *
+ * \param value Integer value to encode.
+ *
+ * \return Number of integer contents octets less one.
+ */
+static unsigned asn1_enc_int_count(int32_t value)
+{
+	unsigned count;
+	u_int32_t test_mask;
+	u_int32_t val;
+
+	/* Find most significant octet of 32 bit integer that carries meaning. */
+	test_mask = 0xFF800000;
+	val = (u_int32_t) value;
+	for (count = 4; --count;) {
+		if ((val & test_mask) != test_mask && (val & test_mask) != 0) {
+			/*
+			 * The first 9 bits of a multiple octet integer is not
+			 * all ones or zeroes.
+			 */
+			break;
+		}
+		test_mask >>= 8;
+	}
+	return count;
+}
+
+/*!
+ * \brief Determine the encoded size of the integer type primitive.
+ *
+ * \param value Component value to encode.
+ *
+ * \return Number of octets asn1_enc_int() will encode.
+ */
+size_t asn1_enc_int_size(int32_t value)
+{
+	return 3 + asn1_enc_int_count(value);
+}
+
+/*!
+ * \brief Determine the encoded size of the object identifier (OID) primitive.
+ *
+ * \param oid Component value to encode.
+ *
+ * \return Number of octets asn1_enc_oid() will encode.
+ */
+size_t asn1_enc_oid_size(const struct asn1_oid *oid)
+{
+	unsigned num_values;
+	size_t size;
+	u_int32_t value;
+
+	size = 2;
+	for (num_values = 0; num_values < oid->num_values; ++num_values) {
+		/* One octet for each 7 bit chunk of the subidentifier */
+		value = oid->value[num_values];
+		do {
+			++size;
+			value >>= 7;
+		} while (value);
+	}
+	return size;
+}
+
+/*!
+ * \brief Determine the encoded size of a string that can be truncated.
+ *
+ * \param str Null terminated string to encode.
+ * \param max_len Maximum length of string to encode.
+ *
+ * \return Number of octets asn1_enc_string_max() will encode.
+ */
+size_t asn1_enc_string_max_size(const unsigned char *str, size_t max_len)
+{
+	size_t str_len;
+
+	str_len = strlen((char *) str);
+	if (max_len < str_len) {
+		str_len = max_len;
+	}
+	return asn1_enc_tlv_size(str_len);
+}
+
 /*!
  * \brief Encode the length of an ASN.1 component body of predetermined size.
  *
@@ -973,29 +1253,12 @@ unsigned char *asn1_enc_length(unsigned char *len_pos, unsigned char *end, size_
 {
 	u_int32_t body_length;		/* Length of component contents */
 	u_int32_t value;
-	u_int32_t test_mask;
 	unsigned length_size;		/* Length of the length encoding */
 
 	body_length = length;
 
 	/* Determine length encoding length */
-	if (body_length < 128) {
-		length_size = 1;
-	} else {
-		/* Find most significant octet of 32 bit integer that carries meaning. */
-		test_mask = 0xFF000000;
-		for (length_size = 4; --length_size;) {
-			if (body_length & test_mask) {
-				/*
-				 * Found the first 8 bits of a multiple octet length that
-				 * is not all zeroes.
-				 */
-				break;
-			}
-			test_mask >>= 8;
-		}
-		length_size += 1 + 1;
-	}
+	length_size = asn1_enc_length_size(body_length);
 
 	if (end < len_pos + length_size + body_length) {
 		/* No room for the length and component body in the buffer */
@@ -1036,7 +1299,6 @@ unsigned char *asn1_enc_length_fixup(unsigned char *len_pos,
 {
 	u_int32_t body_length;		/* Length of component contents */
 	u_int32_t value;
-	u_int32_t test_mask;
 	unsigned length_size;		/* Length of the length encoding */
 
 	if (component_end < len_pos + *len_pos) {
@@ -1047,23 +1309,7 @@ unsigned char *asn1_enc_length_fixup(unsigned char *len_pos,
 	body_length = component_end - len_pos - *len_pos;
 
 	/* Determine length encoding length */
-	if (body_length < 128) {
-		length_size = 1;
-	} else {
-		/* Find most significant octet of 32 bit integer that carries meaning. */
-		test_mask = 0xFF000000;
-		for (length_size = 4; --length_size;) {
-			if (body_length & test_mask) {
-				/*
-				 * Found the first 8 bits of a multiple octet length that
-				 * is not all zeroes.
-				 */
-				break;
-			}
-			test_mask >>= 8;
-		}
-		length_size += 1 + 1;
-	}
+	length_size = asn1_enc_length_size(body_length);
 
 	component_end = len_pos + length_size + body_length;
 	if (end < component_end) {
@@ -1132,23 +1378,9 @@ unsigned char *asn1_enc_int(unsigned char *pos, unsigned char *end, unsigned tag
 	int32_t value)
 {
 	unsigned count;
-	u_int32_t test_mask;
 	u_int32_t val;
 
-	/* Find most significant octet of 32 bit integer that carries meaning. */
-	test_mask = 0xFF800000;
-	val = (u_int32_t) value;
-	for (count = 4; --count;) {
-		if ((val & test_mask) != test_mask && (val & test_mask) != 0) {
-			/*
-			 * The first 9 bits of a multiple octet integer is not
-			 * all ones or zeroes.
-			 */
-			break;
-		}
-		test_mask >>= 8;
-	}
-
+	count = asn1_enc_int_count(value);
 	if (end < pos + 3 + count) {
 		/* No room for the component in the buffer */
 		return NULL;
@@ -0,0 +1,1931 @@
+/*
+ * libpri: An implementation of Primary Rate ISDN
+ *
+ * See http://www.asterisk.org for more information about
+ * the Asterisk project. Please do not directly contact
+ * any of the maintainers of this project for assistance;
+ * the project provides a web site, mailing lists and IRC
+ * channels for your use.
+ *
+ * This program is free software, distributed under the terms of
+ * the GNU General Public License Version 2 as published by the
+ * Free Software Foundation. See the LICENSE file included with
+ * this program for more details.
+ *
+ * In addition, when this program is distributed with Asterisk in
+ * any form that would qualify as a 'combined work' or as a
+ * 'derivative work' (but not mere aggregation), you can redistribute
+ * and/or modify the combination under the terms of the license
+ * provided with that copy of Asterisk, instead of the license
+ * terms granted here.
+ */
+
+/*!
+ * \file
+ * \brief D channel call handling test program
+ *
+ * Two D channel controllers, network and CPE, are connected back to
+ * back through in memory frame queues and driven from one thread.
+ */
+
+
+#include "compat.h"
+#include "libpri.h"
+#include "pri_internal.h"
+#include "pri_facility.h"
+
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+/* ------------------------------------------------------------------- */
+
+/*! Most frames waiting to be received by one side. */
+#define TEST_MAX_FRAMES		1024
+/*! Largest frame passed between the sides. */
+#define TEST_MAX_FRAME_LEN	1100
+/*! Most calls a test places at once. */
+#define TEST_MAX_CALLS		1500
+/*! Number of threads submitting commands at once. */
+#define TEST_SUBMIT_THREADS	4
+/*! Number of commands each submitting thread submits. */
+#define TEST_SUBMIT_COMMANDS	2000
+
+/*! One side of the back to back D channel connection. */
+struct test_side {
+	/*! D channel controller of this side. */
+	struct pri *ctrl;
+	/*! Other side of the connection. */
+	struct test_side *peer;
+	/*! Name of the side for error messages. */
+	const char *name;
+	/*! Frames sent by the peer waiting to be received. */
+	unsigned char frames[TEST_MAX_FRAMES][TEST_MAX_FRAME_LEN];
+	/*! Length of each waiting frame. */
+	int lens[TEST_MAX_FRAMES];
+	/*! Index of the oldest waiting frame. */
+	unsigned head;
+	/*! Number of waiting frames. */
+	unsigned count;
+	/*! Number of frames this side sends that are to be lost. */
+	unsigned drop_tx;
+	/*! TRUE if received frames are left waiting. */
+	int hold_rx;
+	/*! Number of each event type received. */
+	unsigned events[PRI_EVENT_COMMAND_DONE + 1];
+	/*! Calls of the received PRI_EVENT_RING or PRI_EVENT_ANSWER events. */
+	q931_call *calls[TEST_MAX_CALLS];
+	/*! Number of calls in the calls array. */
+	unsigned num_calls;
+	/*! TRUE if PRI_EVENT_RING events are answered. */
+	int answer;
+};
+
+static struct test_side net_side = {
+	.name = "NET",
+};
+static struct test_side cpe_side = {
+	.name = "CPE",
+};
+
+/*! Number of test failures found. */
+static unsigned test_failures;
+
+/*! Number of error messages the library reported. */
+static unsigned test_errors;
+
+#define TEST_CHECK(ctrl, cond)	\
+	do {	\
+		if (!(cond)) {	\
+			pri_error(ctrl, "Error: %s:%d: Check failed: %s\n", __FILE__, __LINE__,	\
+				#cond);	\
+			++test_failures;	\
+		}	\
+	} while (0)
+
+/* ------------------------------------------------------------------- */
+
+/*! Text that test_pri_message() looks for.  (NULL if not looking) */
+static const char *test_message_match;
+
+/*! Number of messages that contained test_message_match. */
+static unsigned test_message_hits;
+
+static void test_pri_message(struct pri *ctrl, char *stuff)
+{
+	if (test_message_match && strstr(stuff, test_message_match)) {
+		++test_message_hits;
+	}
+}
+
+static void test_pri_error(struct pri *ctrl, char *stuff)
+{
+	++test_errors;
+	fprintf(stderr, "%s", stuff);
+}
+
+static int test_io_read(struct pri *ctrl, void *buf, int buflen)
+{
+	return 0;
+}
+
+static int test_io_write(struct pri *ctrl, void *buf, int buflen)
+{
+	struct test_side *side;
+	struct test_side *peer;
+	unsigned idx;
+
+	side = pri_get_userdata(ctrl);
+	if (side->drop_tx) {
+		/* The frame got lost on the way. */
+		--side->drop_tx;
+		return buflen;
+	}
+	peer = side->peer;
+	if (TEST_MAX_FRAMES <= peer->count || TEST_MAX_FRAME_LEN < buflen) {
+		pri_error(ctrl, "Error: %s could not queue a %d octet frame\n", side->name,
+			buflen);
+		++test_failures;
+		return buflen;
+	}
+	idx = (peer->head + peer->count++) % TEST_MAX_FRAMES;
+	memcpy(peer->frames[idx], buf, buflen);
+	peer->lens[idx] = buflen;
+	return buflen;
+}
+
+/*! Most I-frames passed to test_io_batch() in one call. */
+static int test_batch_iframes;
+
+/*! Number of test_io_batch() calls. */
+static unsigned test_batch_calls;
+
+static int test_io_batch(struct pri *ctrl, const struct iovec *iov, int iovcnt)
+{
+	int iframes;
+	int idx;
+
+	++test_batch_calls;
+	iframes = 0;
+	for (idx = 0; idx < iovcnt; ++idx) {
+		if (!(((unsigned char *) iov[idx].iov_base)[2] & 0x01)) {
+			++iframes;
+		}
+		test_io_write(ctrl, iov[idx].iov_base, iov[idx].iov_len);
+	}
+	if (test_batch_iframes < iframes) {
+		test_batch_iframes = iframes;
+	}
+	return iovcnt;
+}
+
+/*! Output passed to test_log_sink(). */
+struct test_log {
+	/*! Number of times test_log_sink() was called. */
+	unsigned calls;
+	/*! Controller of the last output. */
+	struct pri *ctrl;
+	/*! Level of the last output. */
+	int level;
+	/*! Last output text. */
+	char str[256];
+};
+
+static void test_log_sink(struct pri *ctrl, void *userdata, int level, const char *str)
+{
+	struct test_log *log = userdata;
+
+	++log->calls;
+	log->ctrl = ctrl;
+	log->level = level;
+	snprintf(log->str, sizeof(log->str), "%s", str);
+}
+
+static int test_io_discard(struct pri *ctrl, void *buf, int buflen)
+{
+	return buflen;
+}
+
+/*!
+ * \internal
+ * \brief Act on an event the side received.
+ *
+ * \param side Side that received the event.
+ * \param e Event to handle.
+ *
+ * \return Nothing
+ */
+static void test_event(struct test_side *side, pri_event *e)
+{
+	if (e->e <= PRI_EVENT_COMMAND_DONE) {
+		++side->events[e->e];
+	}
+	switch (e->e) {
+	case PRI_EVENT_RING:
+		if (side->num_calls < TEST_MAX_CALLS) {
+			side->calls[side->num_calls++] = e->ring.call;
+		}
+		if (side->answer) {
+			pri_answer(side->ctrl, e->ring.call, e->ring.channel, 0);
+		}
+		break;
+	case PRI_EVENT_ANSWER:
+		if (side->num_calls < TEST_MAX_CALLS) {
+			side->calls[side->num_calls++] = e->answer.call;
+		}
+		break;
+	case PRI_EVENT_HANGUP_REQ:
+		pri_hangup(side->ctrl, e->hangup.call, e->hangup.cause);
+		break;
+	case PRI_EVENT_HANGUP:
+		pri_hangup(side->ctrl, e->hangup.call, e->hangup.cause);
+		break;
+	default:
+		break;
+	}
+}
+
+/*!
+ * \internal
+ * \brief Handle the events the side has.
+ *
+ * \param side Side to handle events.
+ * \param e Event returned by the library call.
+ *
+ * \return Nothing
+ */
+static void test_events(struct test_side *side, pri_event *e)
+{
+	if (side->ctrl->evq.records) {
+		/* The returned event is the oldest queued event. */
+		while ((e = pri_event_next(side->ctrl))) {
+			test_event(side, e);
+			pri_event_release(side->ctrl);
+		}
+	} else if (e) {
+		test_event(side, e);
+	}
+}
+
+/*!
+ * \internal
+ * \brief Pass waiting frames to the side.
+ *
+ * \param side Side to receive frames.
+ *
+ * \return Number of frames received.
+ */
+static unsigned test_receive(struct test_side *side)
+{
+	unsigned char copy[TEST_MAX_FRAME_LEN];
+	unsigned received;
+	pri_event *e;
+	int len;
+
+	received = 0;
+	while (!side->hold_rx && side->count) {
+		len = side->lens[side->head];
+		memcpy(copy, side->frames[side->head], len);
+		e = pri_receive_frame(side->ctrl, side->frames[side->head], len);
+		TEST_CHECK(side->ctrl, !memcmp(copy, side->frames[side->head], len));
+		side->head = (side->head + 1) % TEST_MAX_FRAMES;
+		--side->count;
+		++received;
+		test_events(side, e);
+	}
+	return received;
+}
+
+/*!
+ * \internal
+ * \brief Exchange frames and run expired timers until nothing happens for a while.
+ *
+ * \param ms Milliseconds to keep running with nothing happening.
+ *
+ * \return Nothing
+ */
+static void test_run(int ms)
+{
+	struct timeval start;
+	struct timeval now;
+	long idle_ms;
+
+	pri_schedule_now(&start);
+	for (;;) {
+		if (test_receive(&net_side) + test_receive(&cpe_side)) {
+			pri_schedule_now(&start);
+		}
+		test_events(&net_side, pri_schedule_run(net_side.ctrl));
+		test_events(&cpe_side, pri_schedule_run(cpe_side.ctrl));
+		if ((!net_side.hold_rx && net_side.count) || (!cpe_side.hold_rx && cpe_side.count)) {
+			continue;
+		}
+		pri_schedule_now(&now);
+		idle_ms = (now.tv_sec - start.tv_sec) * 1000 + (now.tv_usec - start.tv_usec) / 1000;
+		if (ms <= idle_ms) {
+			break;
+		}
+		usleep(1000);
+	}
+}
+
+/*!
+ * \internal
+ * \brief Count the call records in the call pool of the controller.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return Number of call records.
+ */
+static unsigned test_pool_calls(struct pri *ctrl)
+{
+	struct q931_call *call;
+	unsigned count;
+
+	count = 0;
+	for (call = *ctrl->callpool; call; call = call->next) {
+		++count;
+	}
+	return count;
+}
+
+/*!
+ * \internal
+ * \brief Create the back to back D channels and bring up the link.
+ *
+ * \param switchtype Switch type of both sides.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+static int test_connect(int switchtype)
+{
+	memset(net_side.events, 0, sizeof(net_side.events));
+	memset(cpe_side.events, 0, sizeof(cpe_side.events));
+	net_side.peer = &cpe_side;
+	cpe_side.peer = &net_side;
+	net_side.ctrl = pri_new_cb(-1, PRI_NETWORK, switchtype, test_io_read, test_io_write,
+		&net_side);
+	cpe_side.ctrl = pri_new_cb(-1, PRI_CPE, switchtype, test_io_read, test_io_write,
+		&cpe_side);
+	if (!net_side.ctrl || !cpe_side.ctrl) {
+		return -1;
+	}
+	test_run(10);
+	TEST_CHECK(NULL, net_side.events[PRI_EVENT_DCHAN_UP] == 1);
+	TEST_CHECK(NULL, cpe_side.events[PRI_EVENT_DCHAN_UP] == 1);
+	return 0;
+}
+
+/*!
+ * \internal
+ * \brief Place calls from the network side and have the CPE side answer them.
+ *
+ * \param calls Filled with the placed calls.
+ * \param num_calls Number of calls to place.
+ *
+ * \return Nothing
+ */
+static void test_place_calls(q931_call **calls, unsigned num_calls)
+{
+	unsigned idx;
+	int res;
+
+	net_side.num_calls = 0;
+	cpe_side.num_calls = 0;
+	cpe_side.answer = 1;
+	for (idx = 0; idx < num_calls; ++idx) {
+		calls[idx] = pri_new_call(net_side.ctrl);
+		TEST_CHECK(net_side.ctrl, calls[idx] != NULL);
+		if (!calls[idx]) {
+			continue;
+		}
+		res = pri_call(net_side.ctrl, calls[idx], PRI_TRANS_CAP_SPEECH, idx % 30 + 1, 0, 0,
+			"5551000", PRI_NATIONAL_ISDN, "Caller", PRES_ALLOWED_USER_NUMBER_PASSED_SCREEN,
+			"6000", PRI_NATIONAL_ISDN, PRI_LAYER_1_ALAW);
+		TEST_CHECK(net_side.ctrl, res == 0);
+	}
+	test_run(10);
+}
+
+/*!
+ * \internal
+ * \brief Hang up the answered calls from both ends.
+ *
+ * \note Every call record of both sides is expected to go away.
+ *
+ * \return Nothing
+ */
+static void test_hangup_calls(void)
+{
+	unsigned idx;
+
+	for (idx = 0; idx < net_side.num_calls; ++idx) {
+		if (idx % 2) {
+			pri_hangup(net_side.ctrl, net_side.calls[idx], PRI_CAUSE_NORMAL_CLEARING);
+		}
+	}
+	for (idx = 0; idx < cpe_side.num_calls; ++idx) {
+		if (!(idx % 2)) {
+			pri_hangup(cpe_side.ctrl, cpe_side.calls[idx], PRI_CAUSE_NORMAL_CLEARING);
+		}
+	}
+	test_run(10);
+	TEST_CHECK(NULL, test_pool_calls(net_side.ctrl) == 0);
+	TEST_CHECK(NULL, test_pool_calls(cpe_side.ctrl) == 0);
+}
+
+/*!
+ * \internal
+ * \brief Command run by test_command_queue().
+ *
+ * \param ctrl D channel controller.
+ * \param data Index of the command.
+ *
+ * \note Each command also queues an event of its own.
+ *
+ * \return The command index plus one.
+ */
+static int test_command(struct pri *ctrl, void *data)
+{
+	pri_event ev;
+
+	memset(&ev, 0, sizeof(ev));
+	ev.gen.e = PRI_EVENT_DCHAN_UP;
+	pri_event_post(ctrl, &ev);
+	return *(unsigned *) data + 1;
+}
+
+/*!
+ * \internal
+ * \brief Determine if the command queue wakeup of the controller is pending.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return TRUE if the command file descriptor is readable.
+ */
+static int test_command_pending(struct pri *ctrl)
+{
+	struct pollfd fds;
+
+	fds.fd = pri_command_fd(ctrl);
+	fds.events = POLLIN;
+	fds.revents = 0;
+	return poll(&fds, 1, 0) == 1 && (fds.revents & POLLIN);
+}
+
+/*! Command data of a submitting thread. */
+struct test_submitter {
+	/*! Thread submitting the commands. */
+	pthread_t thread;
+	/*! Controller to submit the commands to. */
+	struct pri *ctrl;
+	/*! Index of each command in the order submitted. */
+	unsigned data[TEST_SUBMIT_COMMANDS];
+	/*! Number of commands the D channel thread ran. */
+	unsigned ran;
+	/*! Number of commands that failed to submit. */
+	unsigned failed;
+};
+
+static int test_submitted_command(struct pri *ctrl, void *data)
+{
+	return *(unsigned *) data;
+}
+
+static void *test_submit_thread(void *data)
+{
+	struct test_submitter *submitter = data;
+	unsigned idx;
+
+	for (idx = 0; idx < TEST_SUBMIT_COMMANDS; ++idx) {
+		submitter->data[idx] = idx;
+		if (pri_command_submit(submitter->ctrl, test_submitted_command,
+			&submitter->data[idx])) {
+			++submitter->failed;
+		}
+	}
+	return NULL;
+}
+
+/* ------------------------------------------------------------------- */
+
+/*!
+ * \internal
+ * \brief Test frames too short to parse are reported.
+ *
+ * \return Nothing
+ */
+static void test_short_frames(void)
+{
+	static const unsigned char frame[] = { 0x00, 0x01, 0x7f, 0x00, 0x00 };
+	unsigned errors;
+	int len;
+
+	for (len = 0; len < 5; ++len) {
+		errors = test_errors;
+		TEST_CHECK(NULL, pri_receive_frame(cpe_side.ctrl, frame, len) == NULL);
+		TEST_CHECK(NULL, test_errors == errors + 1);
+	}
+}
+
+/*!
+ * \internal
+ * \brief Test many simultaneous calls are found by their call reference.
+ *
+ * \return Nothing
+ */
+static void test_call_references(void)
+{
+	static q931_call *calls[TEST_MAX_CALLS];
+	unsigned idx;
+	unsigned other;
+	unsigned failed;
+	unsigned pass;
+	int crv;
+	int callmode;
+
+	for (pass = 0; pass < 2; ++pass) {
+		test_place_calls(calls, TEST_MAX_CALLS);
+		TEST_CHECK(NULL, cpe_side.num_calls == TEST_MAX_CALLS);
+		TEST_CHECK(NULL, net_side.num_calls == TEST_MAX_CALLS);
+
+		/* Every answer must be for a different call we placed. */
+		failed = 0;
+		for (idx = 0; idx < net_side.num_calls; ++idx) {
+			for (other = 0; other < TEST_MAX_CALLS; ++other) {
+				if (net_side.calls[idx] == calls[other]) {
+					break;
+				}
+			}
+			if (other == TEST_MAX_CALLS) {
+				++failed;
+			} else {
+				calls[other] = NULL;
+			}
+		}
+		TEST_CHECK(NULL, failed == 0);
+
+		/* Both sides must agree on the call reference of every call. */
+		failed = 0;
+		for (idx = 0; idx < cpe_side.num_calls; ++idx) {
+			crv = pri_get_crv(cpe_side.ctrl, cpe_side.calls[idx], &callmode);
+			for (other = 0; other < net_side.num_calls; ++other) {
+				if (crv == pri_get_crv(net_side.ctrl, net_side.calls[other], &callmode)) {
+					break;
+				}
+			}
+			if (other == net_side.num_calls) {
+				++failed;
+			}
+		}
+		TEST_CHECK(NULL, failed == 0);
+
+		test_hangup_calls();
+	}
+}
+
+/*!
+ * \internal
+ * \brief Test the I-frame pool through a backlog and lost frames.
+ *
+ * \return Nothing
+ */
+static void test_frame_pool(void)
+{
+	static q931_call *calls[50];
+	struct q921_frame_pool *pool;
+	unsigned num_slots;
+	unsigned overflow;
+
+	pool = &net_side.ctrl->link.frame_pool;
+	pri_set_timer(net_side.ctrl, PRI_TIMER_T200, 50);
+	pri_set_timer(cpe_side.ctrl, PRI_TIMER_T200, 50);
+
+	/* Hold back the acknowledgements so the retransmission queue fills up. */
+	cpe_side.hold_rx = 1;
+	overflow = pool->overflow;
+	test_place_calls(calls, ARRAY_LEN(calls));
+	num_slots = pool->num_slots;
+	TEST_CHECK(NULL, num_slots == net_side.ctrl->timers[PRI_TIMER_K] + Q921_FRAME_POOL_BACKLOG);
+	TEST_CHECK(NULL, pool->in_use == num_slots);
+	TEST_CHECK(NULL, pool->overflow - overflow == ARRAY_LEN(calls) - num_slots);
+	TEST_CHECK(NULL, net_side.ctrl->link.tx_queue_len == ARRAY_LEN(calls));
+	cpe_side.hold_rx = 0;
+	test_run(10);
+	TEST_CHECK(NULL, cpe_side.num_calls == ARRAY_LEN(calls));
+	TEST_CHECK(NULL, net_side.num_calls == ARRAY_LEN(calls));
+	TEST_CHECK(NULL, pool->in_use == 0);
+	TEST_CHECK(NULL, net_side.ctrl->link.tx_queue_len == 0);
+	test_hangup_calls();
+
+	/* Lose frames so they have to be sent again from the pool. */
+	net_side.drop_tx = 3;
+	test_place_calls(calls, 5);
+	test_run(300);
+	TEST_CHECK(NULL, cpe_side.num_calls == 5);
+	TEST_CHECK(NULL, net_side.num_calls == 5);
+	TEST_CHECK(NULL, pool->in_use == 0);
+	TEST_CHECK(NULL, pool->num_slots == num_slots);
+	test_hangup_calls();
+}
+
+/*!
+ * \internal
+ * \brief Check the retransmission queue tail, pending cursor and length agree.
+ *
+ * \param link Q.921 link to check.
+ *
+ * \return Number of queued frames not sent yet.
+ */
+static unsigned test_tx_queue_pending(struct q921_link *link)
+{
+	struct q921_frame *f;
+	struct q921_frame *last;
+	unsigned queued;
+	unsigned pending;
+	int seen_pending;
+
+	last = NULL;
+	queued = 0;
+	pending = 0;
+	seen_pending = !link->tx_pending;
+	for (f = link->tx_queue; f; f = f->next) {
+		if (f == link->tx_pending) {
+			seen_pending = 1;
+		}
+		if (link->tx_pending && seen_pending) {
+			/* The cursor and every frame after it are not sent. */
+			TEST_CHECK(NULL, f->status != Q921_TX_FRAME_SENT);
+			++pending;
+		} else {
+			TEST_CHECK(NULL, f->status == Q921_TX_FRAME_SENT);
+		}
+		last = f;
+		++queued;
+	}
+	TEST_CHECK(NULL, seen_pending);
+	TEST_CHECK(NULL, link->tx_queue_tail == last);
+	TEST_CHECK(NULL, link->tx_queue_len == queued);
+	return pending;
+}
+
+/*!
+ * \internal
+ * \brief Test the retransmission queue pending cursor through a REJ recovery.
+ *
+ * \return Nothing
+ */
+static void test_tx_pending(void)
+{
+	static q931_call *calls[12];
+	struct q921_link *link;
+	unsigned k;
+
+	link = &net_side.ctrl->link;
+	k = net_side.ctrl->timers[PRI_TIMER_K];
+	TEST_CHECK(NULL, test_tx_queue_pending(link) == 0);
+
+	/*
+	 * Only K frames go out and the first of them is lost.  The rest
+	 * wait behind the pending cursor until the peer acknowledges.
+	 */
+	net_side.drop_tx = 1;
+	cpe_side.hold_rx = 1;
+	test_place_calls(calls, ARRAY_LEN(calls));
+	TEST_CHECK(NULL, link->tx_queue_len == ARRAY_LEN(calls));
+	TEST_CHECK(NULL, test_tx_queue_pending(link) == ARRAY_LEN(calls) - k);
+	TEST_CHECK(NULL, cpe_side.count == k - 1);
+
+	/*
+	 * The peer rejects the out of sequence frames.  Everything sent is
+	 * sent again and the pending frames follow as the window opens.
+	 */
+	cpe_side.hold_rx = 0;
+	test_run(10);
+	TEST_CHECK(NULL, cpe_side.num_calls == ARRAY_LEN(calls));
+	TEST_CHECK(NULL, net_side.num_calls == ARRAY_LEN(calls));
+	TEST_CHECK(NULL, test_tx_queue_pending(link) == 0);
+	TEST_CHECK(NULL, !link->tx_queue && !link->tx_queue_tail && !link->tx_pending);
+	TEST_CHECK(NULL, link->tx_queue_len == 0);
+	test_hangup_calls();
+}
+
+/*!
+ * \internal
+ * \brief Test the number of I-frame pool slots beyond K can be changed.
+ *
+ * \return Nothing
+ */
+static void test_iframe_backlog(void)
+{
+	static q931_call *calls[30];
+	struct q921_frame_pool *pool;
+	struct pri *ctrl;
+	unsigned overflow;
+	unsigned num_slots;
+
+	ctrl = net_side.ctrl;
+	pool = &ctrl->link.frame_pool;
+	TEST_CHECK(NULL, pri_set_iframe_backlog(NULL, 4) == -1);
+	TEST_CHECK(NULL, pri_set_iframe_backlog(ctrl, -1) == -1);
+
+	/* An idle link gets a pool of the new size when next needed. */
+	TEST_CHECK(NULL, !pri_set_iframe_backlog(ctrl, 4));
+	TEST_CHECK(NULL, pool->num_slots == 0 && !pool->slots);
+	cpe_side.hold_rx = 1;
+	overflow = pool->overflow;
+	test_place_calls(calls, ARRAY_LEN(calls));
+	num_slots = ctrl->timers[PRI_TIMER_K] + 4;
+	TEST_CHECK(NULL, pool->num_slots == num_slots);
+	TEST_CHECK(NULL, pool->in_use == num_slots);
+	TEST_CHECK(NULL, pool->overflow - overflow == ARRAY_LEN(calls) - num_slots);
+
+	/* A busy link keeps its pool until the queue empties. */
+	TEST_CHECK(NULL, !pri_set_iframe_backlog(ctrl, Q921_FRAME_POOL_BACKLOG));
+	TEST_CHECK(NULL, pool->num_slots == num_slots);
+	cpe_side.hold_rx = 0;
+	test_run(10);
+	TEST_CHECK(NULL, cpe_side.num_calls == ARRAY_LEN(calls));
+	TEST_CHECK(NULL, pool->in_use == 0);
+	test_hangup_calls();
+
+	/* The restored backlog is used once the pool is idle again. */
+	TEST_CHECK(NULL, !pri_set_iframe_backlog(ctrl, Q921_FRAME_POOL_BACKLOG));
+	cpe_side.hold_rx = 1;
+	test_place_calls(calls, ARRAY_LEN(calls));
+	TEST_CHECK(NULL, pool->num_slots
+		== ctrl->timers[PRI_TIMER_K] + Q921_FRAME_POOL_BACKLOG);
+	cpe_side.hold_rx = 0;
+	test_run(10);
+	TEST_CHECK(NULL, cpe_side.num_calls == ARRAY_LEN(calls));
+	test_hangup_calls();
+}
+
+/*!
+ * \internal
+ * \brief Test call records are preallocated and reused from the call pool.
+ *
+ * \return Nothing
+ */
+static void test_call_pool(void)
+{
+	static q931_call *calls[40];
+	static q931_call *first[ARRAY_LEN(calls)];
+	struct pri_call_pool_stats before;
+	struct pri_call_pool_stats stats;
+	struct pri *ctrl;
+	unsigned idx;
+	unsigned other;
+	unsigned reused;
+	unsigned total;
+
+	ctrl = net_side.ctrl;
+	TEST_CHECK(NULL, pri_call_pool_prealloc(NULL, 1) == -1);
+	TEST_CHECK(NULL, pri_call_pool_stats(ctrl, NULL) == -1);
+
+	/* Preallocate more than one slab block of call records. */
+	TEST_CHECK(NULL, !pri_call_pool_stats(ctrl, &before));
+	TEST_CHECK(NULL, !pri_call_pool_prealloc(ctrl, before.available + ARRAY_LEN(calls)));
+	TEST_CHECK(NULL, !pri_call_pool_stats(ctrl, &stats));
+	TEST_CHECK(NULL, stats.in_use == before.in_use);
+	TEST_CHECK(NULL, before.available + ARRAY_LEN(calls) <= stats.available);
+	TEST_CHECK(NULL, (stats.available - before.available) % 16 == 0);
+	total = stats.in_use + stats.available;
+
+	/* Having enough free call records already does nothing. */
+	TEST_CHECK(NULL, !pri_call_pool_prealloc(ctrl, ARRAY_LEN(calls)));
+	TEST_CHECK(NULL, !pri_call_pool_stats(ctrl, &before));
+	TEST_CHECK(NULL, before.in_use + before.available == total);
+
+	/* Calls use the preallocated call records. */
+	test_place_calls(calls, ARRAY_LEN(calls));
+	TEST_CHECK(NULL, net_side.num_calls == ARRAY_LEN(calls));
+	TEST_CHECK(NULL, !pri_call_pool_stats(ctrl, &stats));
+	TEST_CHECK(NULL, stats.in_use == before.in_use + ARRAY_LEN(calls));
+	TEST_CHECK(NULL, stats.in_use + stats.available == total);
+	TEST_CHECK(NULL, stats.in_use <= stats.high_water);
+	TEST_CHECK(NULL, stats.alloc_failures == before.alloc_failures);
+	memcpy(first, calls, sizeof(first));
+	test_hangup_calls();
+	TEST_CHECK(NULL, !pri_call_pool_stats(ctrl, &stats));
+	TEST_CHECK(NULL, stats.in_use == before.in_use);
+	TEST_CHECK(NULL, stats.available == before.available);
+
+	/* Calls placed again reuse the freed call records. */
+	test_place_calls(calls, ARRAY_LEN(calls));
+	reused = 0;
+	for (idx = 0; idx < ARRAY_LEN(calls); ++idx) {
+		for (other = 0; other < ARRAY_LEN(first); ++other) {
+			if (calls[idx] == first[other]) {
+				++reused;
+				break;
+			}
+		}
+	}
+	TEST_CHECK(NULL, reused == ARRAY_LEN(calls));
+	TEST_CHECK(NULL, !pri_call_pool_stats(ctrl, &stats));
+	TEST_CHECK(NULL, stats.in_use + stats.available == total);
+	test_hangup_calls();
+}
+
+/*!
+ * \internal
+ * \brief Place a call from the network side with every SETUP field filled in.
+ *
+ * \param call Call to place.
+ *
+ * \return Nothing
+ */
+static void test_setup_long(q931_call *call)
+{
+	struct pri_party_subaddress subaddress;
+	unsigned char apdu[200];
+	struct pri_sr *sr;
+	int sendfacility;
+	int res;
+
+	memset(&subaddress, 0, sizeof(subaddress));
+	subaddress.valid = 1;
+	subaddress.type = 2;
+	subaddress.length = 20;
+	memset(subaddress.data, 'S', subaddress.length);
+
+	sr = pri_sr_new();
+	pri_sr_set_channel(sr, 1, 0, 0);
+	pri_sr_set_bearer(sr, PRI_TRANS_CAP_SPEECH, PRI_LAYER_1_ALAW);
+	pri_sr_set_called(sr, "1234567890123456789012345678901", PRI_NATIONAL_ISDN, 1);
+	pri_sr_set_caller(sr, "9876543210987654321098765432109", "Caller with a long name",
+		PRI_NATIONAL_ISDN, PRES_ALLOWED_USER_NUMBER_PASSED_SCREEN);
+	pri_sr_set_caller_subaddress(sr, &subaddress);
+	pri_sr_set_called_subaddress(sr, &subaddress);
+	pri_sr_set_redirecting(sr, "5555555555555555555555555555555", PRI_NATIONAL_ISDN,
+		PRES_ALLOWED_USER_NUMBER_PASSED_SCREEN, PRI_REDIR_UNCONDITIONAL);
+	pri_sr_set_keypad_digits(sr, "12345678901234567890123456789012");
+	pri_sr_set_useruser(sr, "User-user information");
+	pri_sr_set_aoc_charging_request(sr, PRI_AOC_REQUEST_S | PRI_AOC_REQUEST_D
+		| PRI_AOC_REQUEST_E);
+	/* Two invokes of an unknown operation make the message overflow a pool slot. */
+	memset(apdu, 0, sizeof(apdu));
+	apdu[0] = 0x91;	/* ROSE */
+	apdu[1] = 0xa1;	/* Invoke component */
+	apdu[2] = 0x81;
+	apdu[3] = sizeof(apdu) - 4;
+	apdu[4] = 0x02;	/* Invoke id */
+	apdu[5] = 0x01;
+	apdu[6] = 0x05;
+	apdu[7] = 0x02;	/* Operation value */
+	apdu[8] = 0x01;
+	apdu[9] = 0x7f;
+	apdu[10] = 0x04;	/* Argument */
+	apdu[11] = 0x81;
+	apdu[12] = sizeof(apdu) - 13;
+	pri_call_apdu_queue(call, Q931_SETUP, apdu, sizeof(apdu), NULL);
+	pri_call_apdu_queue(call, Q931_SETUP, apdu, sizeof(apdu), NULL);
+
+	/* The charging requests and diversion leg go in facility ies. */
+	sendfacility = net_side.ctrl->sendfacility;
+	pri_facility_enable(net_side.ctrl);
+	res = pri_setup(net_side.ctrl, call, sr);
+	TEST_CHECK(net_side.ctrl, res == 0);
+	net_side.ctrl->sendfacility = sendfacility;
+	pri_sr_free(sr);
+}
+
+/*!
+ * \internal
+ * \brief Test where messages are built: a pool slot, buf, or a right sized heap frame.
+ *
+ * \return Nothing
+ */
+static void test_large_message(void)
+{
+	static q931_call *calls[3];
+	struct q921_frame *leased[Q921_FRAME_POOL_BACKLOG + 16];
+	struct q921_frame_pool *pool;
+	struct q921_link *link;
+	struct q921_frame *f;
+	struct q931_call *ring;
+	unsigned overflow;
+	unsigned num_leased;
+	unsigned idx;
+	int short_len;
+	int res;
+
+	link = &net_side.ctrl->link;
+	pool = &link->frame_pool;
+	net_side.num_calls = 0;
+	cpe_side.num_calls = 0;
+	cpe_side.answer = 1;
+	cpe_side.hold_rx = 1;
+	for (idx = 0; idx < ARRAY_LEN(calls); ++idx) {
+		calls[idx] = pri_new_call(net_side.ctrl);
+	}
+
+	/* A typical message is built in place in a pool slot. */
+	overflow = pool->overflow;
+	res = pri_call(net_side.ctrl, calls[0], PRI_TRANS_CAP_SPEECH, 1, 0, 0, "5551000",
+		PRI_NATIONAL_ISDN, "Caller", PRES_ALLOWED_USER_NUMBER_PASSED_SCREEN, "6000",
+		PRI_NATIONAL_ISDN, PRI_LAYER_1_ALAW);
+	TEST_CHECK(NULL, res == 0);
+	f = link->tx_queue_tail;
+	TEST_CHECK(NULL, f && f->pooled);
+	TEST_CHECK(NULL, pool->overflow == overflow);
+	short_len = f ? f->len : 0;
+
+	/* A message that outgrows a pool slot is finished in buf and copied. */
+	test_setup_long(calls[1]);
+	f = link->tx_queue_tail;
+	TEST_CHECK(NULL, f && !f->pooled && Q921_FRAME_POOL_DATA_SIZE + 4 < f->len);
+	TEST_CHECK(NULL, pool->overflow == overflow + 1);
+
+	/* With no free pool slot the message is copied to a right sized frame. */
+	for (num_leased = 0; num_leased < ARRAY_LEN(leased); ++num_leased) {
+		leased[num_leased] = q921_iframe_lease(link);
+		if (!leased[num_leased]) {
+			break;
+		}
+	}
+	TEST_CHECK(NULL, pool->free_list == NULL);
+	res = pri_call(net_side.ctrl, calls[2], PRI_TRANS_CAP_SPEECH, 2, 0, 0, "5551000",
+		PRI_NATIONAL_ISDN, "Caller", PRES_ALLOWED_USER_NUMBER_PASSED_SCREEN, "6000",
+		PRI_NATIONAL_ISDN, PRI_LAYER_1_ALAW);
+	TEST_CHECK(NULL, res == 0);
+	f = link->tx_queue_tail;
+	TEST_CHECK(NULL, f && !f->pooled && f->len == short_len);
+	TEST_CHECK(NULL, pool->overflow == overflow + 2);
+	for (idx = 0; idx < num_leased; ++idx) {
+		q921_iframe_lease_release(link, leased[idx]);
+	}
+
+	/* Every field of the long SETUP arrives. */
+	cpe_side.hold_rx = 0;
+	test_run(10);
+	TEST_CHECK(NULL, cpe_side.num_calls == ARRAY_LEN(calls));
+	ring = NULL;
+	for (idx = 0; idx < cpe_side.num_calls; ++idx) {
+		if (!strcmp(cpe_side.calls[idx]->keypad_digits, "12345678901234567890123456789012")) {
+			ring = cpe_side.calls[idx];
+		}
+	}
+	TEST_CHECK(NULL, ring != NULL);
+	if (ring) {
+		TEST_CHECK(NULL, !strcmp(ring->called.number.str, "1234567890123456789012345678901"));
+		TEST_CHECK(NULL, !strcmp(ring->remote_id.number.str,
+			"9876543210987654321098765432109"));
+		TEST_CHECK(NULL, ring->called.subaddress.length == 20);
+		TEST_CHECK(NULL, ring->remote_id.subaddress.length == 20);
+	}
+	test_hangup_calls();
+}
+
+/*!
+ * \internal
+ * \brief Lease every free frame pool slot of the link.
+ *
+ * \param link Q.921 link.
+ * \param leased Filled with the leased frames.  (Room for Q921_FRAME_POOL_BACKLOG + 16)
+ * \param octet Value the leased frame data is filled with.
+ *
+ * \return Number of leased frames.
+ */
+static unsigned test_pool_lease(struct q921_link *link, struct q921_frame **leased,
+	unsigned char octet)
+{
+	unsigned num_leased;
+
+	for (num_leased = 0; num_leased < Q921_FRAME_POOL_BACKLOG + 16; ++num_leased) {
+		leased[num_leased] = q921_iframe_lease(link);
+		if (!leased[num_leased]) {
+			break;
+		}
+		memset(leased[num_leased]->h.data, octet, Q921_FRAME_POOL_DATA_SIZE);
+	}
+	return num_leased;
+}
+
+/*!
+ * \internal
+ * \brief Place a short call from the network side.
+ *
+ * \param call Call to place.
+ *
+ * \return Nothing
+ */
+static void test_setup_short(q931_call *call)
+{
+	int res;
+
+	res = pri_call(net_side.ctrl, call, PRI_TRANS_CAP_SPEECH, 1, 0, 0, "5551000",
+		PRI_NATIONAL_ISDN, "Caller", PRES_ALLOWED_USER_NUMBER_PASSED_SCREEN, "6000",
+		PRI_NATIONAL_ISDN, PRI_LAYER_1_ALAW);
+	TEST_CHECK(net_side.ctrl, res == 0);
+}
+
+/*!
+ * \internal
+ * \brief Test a message built after a longer one has none of its octets.
+ *
+ * \note send_message() does not zero the buffer it builds a message in.
+ *
+ * \return Nothing
+ */
+static void test_stale_bytes(void)
+{
+	static q931_call *calls[4];
+	struct q921_frame *leased[Q921_FRAME_POOL_BACKLOG + 16];
+	struct pri_trace_record setups[ARRAY_LEN(calls)];
+	struct pri_trace_record rec;
+	struct q921_link *link;
+	struct pri *ctrl;
+	unsigned long cursor;
+	unsigned num_leased;
+	unsigned num_setups;
+	unsigned idx;
+
+	ctrl = net_side.ctrl;
+	link = &ctrl->link;
+	TEST_CHECK(ctrl, !pri_trace_enable(ctrl, 64, 0));
+	net_side.num_calls = 0;
+	cpe_side.num_calls = 0;
+	cpe_side.answer = 1;
+	for (idx = 0; idx < ARRAY_LEN(calls); ++idx) {
+		calls[idx] = pri_new_call(ctrl);
+		TEST_CHECK(ctrl, calls[idx] != NULL);
+		if (!calls[idx]) {
+			return;
+		}
+	}
+
+	/* The first short SETUP is built in a zeroed pool slot. */
+	num_leased = test_pool_lease(link, leased, 0x00);
+	while (num_leased) {
+		q921_iframe_lease_release(link, leased[--num_leased]);
+	}
+	test_setup_short(calls[0]);
+
+	/* The long SETUP is started in a pool slot and finished in buf. */
+	test_setup_long(calls[1]);
+
+	/* The same short SETUP is built in a filled pool slot and then in buf. */
+	num_leased = test_pool_lease(link, leased, 0xff);
+	while (num_leased) {
+		q921_iframe_lease_release(link, leased[--num_leased]);
+	}
+	test_setup_short(calls[2]);
+	num_leased = test_pool_lease(link, leased, 0xff);
+	test_setup_short(calls[3]);
+	while (num_leased) {
+		q921_iframe_lease_release(link, leased[--num_leased]);
+	}
+	test_run(10);
+	TEST_CHECK(ctrl, cpe_side.num_calls == ARRAY_LEN(calls));
+
+	num_setups = 0;
+	cursor = 0;
+	while (pri_trace_read(ctrl, &cursor, &rec) == 1) {
+		if (rec.direction == PRI_TRACE_TX && rec.msgtype == Q931_SETUP
+			&& num_setups < ARRAY_LEN(setups)) {
+			setups[num_setups++] = rec;
+		}
+	}
+	TEST_CHECK(ctrl, num_setups == ARRAY_LEN(calls));
+	if (num_setups == ARRAY_LEN(calls)) {
+		TEST_CHECK(ctrl, setups[0].len < setups[1].len);
+		/* Only the Q.921 header and the call reference differ. */
+		for (idx = 2; idx < num_setups; ++idx) {
+			TEST_CHECK(ctrl, setups[idx].len == setups[0].len
+				&& setups[idx].caplen == setups[idx].len);
+			TEST_CHECK(ctrl, !memcmp(setups[idx].frame + 8, setups[0].frame + 8,
+				setups[0].caplen - 8));
+		}
+	}
+	TEST_CHECK(ctrl, !pri_trace_enable(ctrl, 0, 0));
+	test_hangup_calls();
+}
+
+/*!
+ * \internal
+ * \brief Test every event raised while a link goes down is queued.
+ *
+ * \note The queue starts with room for one event so it has to grow while
+ * the upper layer still holds the oldest event.
+ *
+ * \return Nothing
+ */
+static void test_event_queue(void)
+{
+	/* DISC command with the poll bit set from the network side. */
+	static const unsigned char disc[] = { 0x02, 0x01, 0x53, 0x00, 0x00 };
+	static q931_call *calls[3];
+	struct pri *ctrl;
+	pri_event *held;
+	pri_event *e;
+	unsigned hangups;
+	unsigned idx;
+	int res;
+
+	ctrl = cpe_side.ctrl;
+	TEST_CHECK(ctrl, !pri_event_queue_enable(ctrl, 1));
+
+	/* Leave the calls unanswered so they are cleared when the link goes down. */
+	cpe_side.answer = 0;
+	cpe_side.num_calls = 0;
+	for (idx = 0; idx < ARRAY_LEN(calls); ++idx) {
+		calls[idx] = pri_new_call(net_side.ctrl);
+		res = pri_call(net_side.ctrl, calls[idx], PRI_TRANS_CAP_SPEECH, idx + 1, 0, 0,
+			"5551000", PRI_NATIONAL_ISDN, "Caller", PRES_ALLOWED_USER_NUMBER_PASSED_SCREEN,
+			"6000", PRI_NATIONAL_ISDN, PRI_LAYER_1_ALAW);
+		TEST_CHECK(net_side.ctrl, res == 0);
+	}
+	test_run(10);
+	TEST_CHECK(ctrl, cpe_side.num_calls == ARRAY_LEN(calls));
+	for (idx = 0; idx < cpe_side.num_calls; ++idx) {
+		pri_proceeding(ctrl, cpe_side.calls[idx], idx + 1, 0);
+	}
+	test_run(10);
+
+	held = pri_receive_frame(ctrl, disc, sizeof(disc));
+	TEST_CHECK(ctrl, held && held->e == PRI_EVENT_DCHAN_DOWN);
+	if (!held) {
+		return;
+	}
+
+	/* Each call is cleared by its own timer while the first event is held. */
+	TEST_CHECK(ctrl, pri_schedule_run(ctrl) != NULL);
+	TEST_CHECK(ctrl, ctrl->evq.count == 1 + ARRAY_LEN(calls));
+	TEST_CHECK(ctrl, ctrl->evq.dropped == 0);
+	TEST_CHECK(ctrl, held->e == PRI_EVENT_DCHAN_DOWN);
+
+	hangups = 0;
+	for (idx = 0; (e = pri_event_next(ctrl)); ++idx) {
+		if (!idx) {
+			TEST_CHECK(ctrl, e->e == PRI_EVENT_DCHAN_DOWN);
+		} else if (e->e == PRI_EVENT_HANGUP) {
+			++hangups;
+			pri_hangup(ctrl, e->hangup.call, e->hangup.cause);
+		}
+		pri_event_release(ctrl);
+	}
+	TEST_CHECK(ctrl, hangups == ARRAY_LEN(calls));
+	TEST_CHECK(ctrl, ctrl->evq.retired == NULL);
+
+	/* The link comes back up and the network side clears its calls. */
+	test_run(300);
+	for (idx = 0; idx < ARRAY_LEN(calls); ++idx) {
+		pri_hangup(net_side.ctrl, calls[idx], PRI_CAUSE_NORMAL_CLEARING);
+	}
+	test_run(300);
+	TEST_CHECK(NULL, test_pool_calls(net_side.ctrl) == 0);
+	TEST_CHECK(NULL, test_pool_calls(ctrl) == 0);
+	TEST_CHECK(ctrl, !pri_event_queue_enable(ctrl, 0));
+}
+
+/*!
+ * \internal
+ * \brief Test the binary trace ring records frames in order and skips overwritten ones.
+ *
+ * \return Nothing
+ */
+static void test_trace(void)
+{
+	static q931_call *calls[1];
+	struct pri_trace_record setup;
+	struct pri_trace_record rec;
+	struct pri *ctrl;
+	unsigned long cursor;
+	unsigned long head;
+	int connect_cref;
+	unsigned records;
+
+	ctrl = cpe_side.ctrl;
+	TEST_CHECK(ctrl, !pri_trace_enable(ctrl, 64, 3));
+	test_place_calls(calls, ARRAY_LEN(calls));
+
+	memset(&setup, 0, sizeof(setup));
+	setup.cref = -1;
+	connect_cref = -1;
+	cursor = 0;
+	for (records = 0; pri_trace_read(ctrl, &cursor, &rec) == 1; ++records) {
+		TEST_CHECK(ctrl, rec.seq == records);
+		TEST_CHECK(ctrl, rec.span == 3);
+		TEST_CHECK(ctrl, rec.caplen == rec.len);
+		TEST_CHECK(ctrl, rec.sapi == Q921_SAPI_CALL_CTRL && rec.tei == 0);
+		if (rec.direction == PRI_TRACE_RX && rec.msgtype == Q931_SETUP) {
+			setup = rec;
+		} else if (rec.direction == PRI_TRACE_TX && rec.msgtype == Q931_CONNECT) {
+			connect_cref = rec.cref;
+		} else if (rec.msgtype < 0) {
+			/* Layer 2 only frames have no layer 3 fields. */
+			TEST_CHECK(ctrl, rec.cref == -1);
+		}
+	}
+	TEST_CHECK(ctrl, 4 <= records && cursor == records);
+
+	/* The answering side sets the call reference flag. */
+	TEST_CHECK(ctrl, 0 <= setup.cref && !(setup.cref & 0x8000));
+	TEST_CHECK(ctrl, connect_cref == (setup.cref | 0x8000));
+
+	/* The record decodes with the normal message dump. */
+	test_message_match = "SETUP";
+	test_message_hits = 0;
+	pri_trace_dump(ctrl, &setup);
+	TEST_CHECK(ctrl, test_message_hits != 0);
+	test_message_match = NULL;
+
+	/* Hanging up sends and receives more frames than a small ring holds. */
+	TEST_CHECK(ctrl, !pri_trace_enable(ctrl, 4, 3));
+	test_hangup_calls();
+	head = ctrl->trace.head;
+	TEST_CHECK(ctrl, 4 < head);
+	cursor = 0;
+	for (records = 0; pri_trace_read(ctrl, &cursor, &rec) == 1; ++records) {
+		TEST_CHECK(ctrl, rec.seq == head - 4 + records);
+	}
+	TEST_CHECK(ctrl, records == 4 && cursor == head);
+	TEST_CHECK(ctrl, !pri_trace_enable(ctrl, 0, 0));
+}
+
+/*!
+ * \internal
+ * \brief Test the I-frames sent while processing one received frame are written together.
+ *
+ * \return Nothing
+ */
+static void test_io_batch_write(void)
+{
+	static q931_call *calls[5];
+	struct pri *ctrl;
+
+	ctrl = net_side.ctrl;
+	TEST_CHECK(ctrl, !pri_set_io_batch_cb(ctrl, test_io_batch));
+	test_batch_calls = 0;
+	test_batch_iframes = 0;
+
+	/*
+	 * Calls placed outside a receive pass are written one at a time.
+	 * Losing the first SETUP makes the CPE side reject the rest.  The
+	 * REJ frame then has every SETUP sent again from one receive pass.
+	 */
+	net_side.drop_tx = 1;
+	cpe_side.hold_rx = 1;
+	test_place_calls(calls, ARRAY_LEN(calls));
+	TEST_CHECK(ctrl, test_batch_calls == ARRAY_LEN(calls));
+	TEST_CHECK(ctrl, test_batch_iframes == 1);
+	cpe_side.hold_rx = 0;
+	test_run(10);
+	TEST_CHECK(ctrl, cpe_side.num_calls == ARRAY_LEN(calls));
+	TEST_CHECK(ctrl, net_side.num_calls == ARRAY_LEN(calls));
+	TEST_CHECK(ctrl, test_batch_iframes == ARRAY_LEN(calls));
+	test_hangup_calls();
+
+	TEST_CHECK(ctrl, !pri_set_io_batch_cb(ctrl, NULL));
+}
+
+/*! Optional ie fields reported by the events of received messages. */
+struct test_lazy_fields {
+	/*! PRI_EVENT_RING user-user information. */
+	char ring_useruser[260];
+	/*! PRI_EVENT_RING redirecting number. */
+	char ring_redirecting[256];
+	/*! PRI_EVENT_RING ANI II digits. */
+	int ring_ani2;
+	/*! PRI_EVENT_ANSWER user-user information. */
+	char answer_useruser[260];
+	/*! PRI_EVENT_HANGUP_REQ user-user information. */
+	char hangup_useruser[260];
+};
+
+/*!
+ * \internal
+ * \brief Give a Q.931 message with the optional ies to the controller.
+ *
+ * \param ctrl D channel controller.
+ * \param cr Call reference of the message including the flag.
+ * \param msgtype Q.931 message type.
+ * \param ies Mandatory ies of the message type.
+ * \param ies_len Length of the mandatory ies.
+ *
+ * \return Event type reported by the message or -1 if none.
+ */
+static int test_lazy_receive(struct pri *ctrl, int cr, int msgtype,
+	const unsigned char *ies, int ies_len)
+{
+	/* Redirecting number, user-user and codeset 6 generic digits ies. */
+	static const unsigned char optional[] = {
+		0x74, 0x05, 0x01, 0x80, '5', '5', '5',
+		0x7e, 0x05, 0x04, 'l', 'a', 'z', 'y',
+		0x96, 0x37, 0x02, 0x04, 0x72,
+	};
+	unsigned char msg[128];
+	int len;
+	int res;
+
+	msg[0] = Q931_PROTOCOL_DISCRIMINATOR;
+	msg[1] = 2;
+	msg[2] = (cr >> 8) & 0xff;
+	msg[3] = cr & 0xff;
+	msg[4] = msgtype;
+	len = 5;
+	memcpy(msg + len, ies, ies_len);
+	len += ies_len;
+	memcpy(msg + len, optional, sizeof(optional));
+	len += sizeof(optional);
+
+	memset(&ctrl->ev, 0, sizeof(ctrl->ev));
+	res = q931_receive(&ctrl->link, (q931_h *) msg, len);
+	if (res == -1 || !(res & Q931_RES_HAVEEVENT)) {
+		return -1;
+	}
+	return ctrl->ev.e;
+}
+
+/*!
+ * \internal
+ * \brief Collect the optional ie fields of a call's events.
+ *
+ * \param ctrl D channel controller.
+ * \param fields Filled with the event fields.
+ *
+ * \return Nothing
+ */
+static void test_lazy_call(struct pri *ctrl, struct test_lazy_fields *fields)
+{
+	static const unsigned char setup_ies[] = {
+		0x04, 0x03, 0x80, 0x90, 0xa3,
+		0x18, 0x03, 0xa9, 0x83, 0x81,
+		0x70, 0x04, 0x81, '1', '2', '3',
+	};
+	static const unsigned char connect_ies[] = {
+		0x18, 0x03, 0xa9, 0x83, 0x81,
+	};
+	static const unsigned char cause_ies[] = {
+		0x08, 0x02, 0x80, 0x90,
+	};
+	struct pri_sr *sr;
+	q931_call *call;
+	int cr;
+
+	memset(fields, 0, sizeof(*fields));
+
+	/* SETUP from the peer reports all of the optional ies. */
+	TEST_CHECK(NULL, test_lazy_receive(ctrl, 0x0123, Q931_SETUP, setup_ies,
+		sizeof(setup_ies)) == PRI_EVENT_RING);
+	libpri_copy_string(fields->ring_useruser, ctrl->ev.ring.useruserinfo,
+		sizeof(fields->ring_useruser));
+	libpri_copy_string(fields->ring_redirecting, ctrl->ev.ring.redirectingnum,
+		sizeof(fields->ring_redirecting));
+	fields->ring_ani2 = ctrl->ev.ring.ani2;
+	call = ctrl->ev.ring.call;
+	pri_hangup(ctrl, call, PRI_CAUSE_NORMAL_CLEARING);
+	TEST_CHECK(NULL, test_lazy_receive(ctrl, 0x0123, Q931_RELEASE, cause_ies,
+		sizeof(cause_ies)) == PRI_EVENT_HANGUP);
+	pri_hangup(ctrl, call, PRI_CAUSE_NORMAL_CLEARING);
+
+	/* CONNECT and DISCONNECT of our own call only report user-user. */
+	call = pri_new_call(ctrl);
+	sr = pri_sr_new();
+	TEST_CHECK(NULL, call && sr);
+	if (!call || !sr) {
+		pri_sr_free(sr);
+		return;
+	}
+	pri_sr_set_channel(sr, 1, 1, 0);
+	pri_sr_set_bearer(sr, PRI_TRANS_CAP_SPEECH, PRI_LAYER_1_ALAW);
+	pri_sr_set_called(sr, "123", PRI_UNKNOWN, 1);
+	TEST_CHECK(NULL, !pri_setup(ctrl, call, sr));
+	pri_sr_free(sr);
+	cr = call->cr | 0x8000;
+	TEST_CHECK(NULL, test_lazy_receive(ctrl, cr, Q931_CONNECT, connect_ies,
+		sizeof(connect_ies))
+		== PRI_EVENT_ANSWER);
+	libpri_copy_string(fields->answer_useruser, ctrl->ev.answer.useruserinfo,
+		sizeof(fields->answer_useruser));
+	TEST_CHECK(NULL, test_lazy_receive(ctrl, cr, Q931_DISCONNECT, cause_ies,
+		sizeof(cause_ies)) == PRI_EVENT_HANGUP_REQ);
+	libpri_copy_string(fields->hangup_useruser, ctrl->ev.hangup.useruserinfo,
+		sizeof(fields->hangup_useruser));
+	pri_hangup(ctrl, call, PRI_CAUSE_NORMAL_CLEARING);
+	test_lazy_receive(ctrl, cr, Q931_RELEASE_COMPLETE, cause_ies, sizeof(cause_ies));
+}
+
+/*!
+ * \internal
+ * \brief Test lazy optional ie decoding reports the same event fields.
+ *
+ * \return Nothing
+ */
+static void test_lazy_ie_decode(void)
+{
+	static struct pri *ctrl;
+	struct test_lazy_fields legacy;
+	struct test_lazy_fields lazy;
+
+	if (!ctrl) {
+		ctrl = pri_new_cb(-1, PRI_CPE, PRI_SWITCH_EUROISDN_E1, test_io_read,
+			test_io_discard, NULL);
+		TEST_CHECK(NULL, ctrl != NULL);
+		if (!ctrl) {
+			return;
+		}
+	}
+
+	pri_lazy_ie_decode_enable(ctrl, 0);
+	test_lazy_call(ctrl, &legacy);
+	TEST_CHECK(NULL, !strcmp(legacy.ring_useruser, "lazy"));
+	TEST_CHECK(NULL, !strcmp(legacy.ring_redirecting, "555"));
+	TEST_CHECK(NULL, legacy.ring_ani2 == 27);
+	TEST_CHECK(NULL, !strcmp(legacy.answer_useruser, "lazy"));
+	TEST_CHECK(NULL, !strcmp(legacy.hangup_useruser, "lazy"));
+
+	pri_lazy_ie_decode_enable(ctrl, 1);
+	test_lazy_call(ctrl, &lazy);
+	TEST_CHECK(NULL, !memcmp(&legacy, &lazy, sizeof(legacy)));
+	pri_lazy_ie_decode_enable(ctrl, 0);
+}
+
+/*!
+ * \internal
+ * \brief Test the ROSE decode arena is given back after every facility ie.
+ *
+ * \return Nothing
+ */
+static void test_facility_arena(void)
+{
+	static const unsigned char msg[] = {
+		Q931_PROTOCOL_DISCRIMINATOR, 0x00, Q931_FACILITY,
+		0x1c, 0x23, 0x91,
+		/* Invoke of an unknown operation */
+		0xa1, 0x06, 0x02, 0x01, 0x05, 0x02, 0x01, 0x7f,
+		/* Result */
+		0xa2, 0x03, 0x02, 0x01, 0x06,
+		/* Error */
+		0xa3, 0x06, 0x02, 0x01, 0x07, 0x02, 0x01, 0x00,
+		/* Reject */
+		0xa4, 0x06, 0x02, 0x01, 0x08, 0x80, 0x01, 0x00,
+		/* Invoke missing its operation-value fails to decode. */
+		0xa1, 0x03, 0x02, 0x01, 0x09,
+	};
+	static struct pri *ctrl;
+	size_t mark;
+	unsigned pass;
+
+	if (!ctrl) {
+		ctrl = pri_new_cb(-1, PRI_CPE, PRI_SWITCH_EUROISDN_E1, test_io_read,
+			test_io_discard, NULL);
+		TEST_CHECK(NULL, ctrl != NULL);
+		if (!ctrl) {
+			return;
+		}
+	}
+
+	/* Each pass decodes every component into the arena from the same mark. */
+	pri_set_debug(ctrl, PRI_DEBUG_APDU);
+	test_message_match = "Component Context";
+	for (pass = 0; pass < 2; ++pass) {
+		mark = ctrl->rose_arena.used;
+		test_message_hits = 0;
+		q931_receive(&ctrl->link, (q931_h *) msg, sizeof(msg));
+		TEST_CHECK(NULL, test_message_hits == 5);
+		TEST_CHECK(NULL, ctrl->rose_arena.buf != NULL);
+		TEST_CHECK(NULL, ctrl->rose_arena.used == mark);
+	}
+	test_message_match = NULL;
+	pri_set_debug(ctrl, 0);
+}
+
+/*!
+ * \internal
+ * \brief Send a Q.931 message built by the test from the network side.
+ *
+ * \param cr Call reference the CPE side gave the call.
+ * \param msgtype Q.931 message type.
+ * \param ies Information elements of the message.
+ * \param ies_len Length of the ies.
+ *
+ * \return Nothing
+ */
+static void test_net_send(int cr, int msgtype, const unsigned char *ies, int ies_len)
+{
+	unsigned char msg[128];
+	int res;
+
+	msg[0] = Q931_PROTOCOL_DISCRIMINATOR;
+	msg[1] = 2;
+	msg[2] = 0x80 | ((cr >> 8) & 0x7f);
+	msg[3] = cr & 0xff;
+	msg[4] = msgtype;
+	memcpy(msg + 5, ies, ies_len);
+	res = q921_transmit_iframe(&net_side.ctrl->link, msg, 5 + ies_len, 1);
+	TEST_CHECK(NULL, res == 0);
+}
+
+/*!
+ * \internal
+ * \brief Place a call from the CPE side that the network side does not answer.
+ *
+ * \return The CPE side call or NULL on error.
+ */
+static q931_call *test_cpe_call(void)
+{
+	q931_call *call;
+	int res;
+
+	net_side.num_calls = 0;
+	cpe_side.num_calls = 0;
+	call = pri_new_call(cpe_side.ctrl);
+	TEST_CHECK(NULL, call != NULL);
+	if (!call) {
+		return NULL;
+	}
+	res = pri_call(cpe_side.ctrl, call, PRI_TRANS_CAP_SPEECH, 1, 0, 0, "6000",
+		PRI_NATIONAL_ISDN, "Caller", PRES_ALLOWED_USER_NUMBER_PASSED_SCREEN, "5551000",
+		PRI_NATIONAL_ISDN, PRI_LAYER_1_ALAW);
+	TEST_CHECK(NULL, res == 0);
+	test_run(10);
+	TEST_CHECK(NULL, net_side.num_calls == 1);
+	return call;
+}
+
+/*!
+ * \internal
+ * \brief Test a message with an unknown ie is still handled.
+ *
+ * \return Nothing
+ */
+static void test_unknown_ie(void)
+{
+	/* Channel id and the unknown optional ie 94 (0x5e). */
+	static const unsigned char connect_ies[] = {
+		0x18, 0x03, 0xa9, 0x83, 0x81,
+		0x5e, 0x02, 0x12, 0x34,
+	};
+	q931_call *call;
+	unsigned answers;
+
+	call = test_cpe_call();
+	if (!call) {
+		return;
+	}
+	answers = cpe_side.events[PRI_EVENT_ANSWER];
+	test_message_match = "!! Unknown IE 94 (cs0)";
+	test_message_hits = 0;
+	test_net_send(call->cr, Q931_CONNECT, connect_ies, sizeof(connect_ies));
+	test_run(10);
+	TEST_CHECK(NULL, test_message_hits == 1);
+	TEST_CHECK(NULL, cpe_side.events[PRI_EVENT_ANSWER] == answers + 1);
+	test_message_match = NULL;
+
+	pri_hangup(cpe_side.ctrl, call, PRI_CAUSE_NORMAL_CLEARING);
+	test_run(10);
+	TEST_CHECK(NULL, test_pool_calls(net_side.ctrl) == 0);
+	TEST_CHECK(NULL, test_pool_calls(cpe_side.ctrl) == 0);
+}
+
+/*!
+ * \internal
+ * \brief Find the cause value of the last STATUS the controller sent.
+ *
+ * \param ctrl D channel controller with the trace ring enabled.
+ *
+ * \return Cause value or -1 if no STATUS with a cause was sent.
+ */
+static int test_status_cause(struct pri *ctrl)
+{
+	struct pri_trace_record rec;
+	unsigned long cursor;
+	int cause;
+	int pos;
+
+	cause = -1;
+	cursor = 0;
+	while (pri_trace_read(ctrl, &cursor, &rec) == 1) {
+		if (rec.direction != PRI_TRACE_TX || rec.msgtype != Q931_STATUS) {
+			continue;
+		}
+		/* Skip the Q.921 header and the Q.931 header with a two octet call reference. */
+		for (pos = 4 + 5; pos + 3 < rec.caplen; pos += 2 + rec.frame[pos + 1]) {
+			if (rec.frame[pos] == Q931_CAUSE) {
+				cause = rec.frame[pos + 3] & 0x7f;
+				break;
+			}
+		}
+	}
+	return cause;
+}
+
+/*!
+ * \internal
+ * \brief Test a message missing a mandatory ie is answered with a STATUS.
+ *
+ * \return Nothing
+ */
+static void test_mandatory_ie(void)
+{
+	/* Channel id left out. */
+	static const unsigned char missing_ies[] = {
+		0x1e, 0x02, 0x80, 0x82,
+	};
+	/* Channel id with the unknown ie 11 (0x0b) that must be understood. */
+	static const unsigned char unknown_ies[] = {
+		0x0b, 0x01, 0x00,
+		0x18, 0x03, 0xa9, 0x83, 0x81,
+	};
+	struct pri *ctrl;
+	q931_call *call;
+	unsigned answers;
+	unsigned errors;
+
+	ctrl = cpe_side.ctrl;
+	call = test_cpe_call();
+	if (!call || !net_side.num_calls) {
+		return;
+	}
+	answers = cpe_side.events[PRI_EVENT_ANSWER];
+	TEST_CHECK(ctrl, !pri_trace_enable(ctrl, 64, 0));
+
+	errors = test_errors;
+	test_net_send(call->cr, Q931_CONNECT, missing_ies, sizeof(missing_ies));
+	test_run(10);
+	TEST_CHECK(ctrl, test_errors == errors + 1);
+	TEST_CHECK(ctrl, test_status_cause(ctrl) == PRI_CAUSE_MANDATORY_IE_MISSING);
+
+	/* Enabling the ring again starts it empty. */
+	TEST_CHECK(ctrl, !pri_trace_enable(ctrl, 64, 0));
+	errors = test_errors;
+	test_net_send(call->cr, Q931_CONNECT, unknown_ies, sizeof(unknown_ies));
+	test_run(10);
+	TEST_CHECK(ctrl, test_errors == errors + 1);
+	TEST_CHECK(ctrl, test_status_cause(ctrl) == PRI_CAUSE_MANDATORY_IE_MISSING);
+	TEST_CHECK(ctrl, cpe_side.events[PRI_EVENT_ANSWER] == answers);
+	TEST_CHECK(ctrl, !pri_trace_enable(ctrl, 0, 0));
+
+	/*
+	 * The CPE side call keeps cause 96 so the network side clears it.
+	 * It has to proceed the call first to be able to send a DISCONNECT.
+	 */
+	pri_proceeding(net_side.ctrl, net_side.calls[0], 1, 0);
+	pri_hangup(net_side.ctrl, net_side.calls[0], PRI_CAUSE_NORMAL_CLEARING);
+	test_run(10);
+	TEST_CHECK(NULL, test_pool_calls(net_side.ctrl) == 0);
+	TEST_CHECK(NULL, test_pool_calls(ctrl) == 0);
+}
+
+/*!
+ * \internal
+ * \brief Test the controller log sink and its level mask.
+ *
+ * \return Nothing
+ */
+static void test_log_sink_output(void)
+{
+	static struct pri *master;
+	static struct pri *slave;
+	struct test_log log;
+	struct pri *ctrl;
+	unsigned messages;
+	unsigned errors;
+
+	ctrl = cpe_side.ctrl;
+	memset(&log, 0, sizeof(log));
+	messages = test_message_hits;
+	errors = test_errors;
+	test_message_match = "sink";
+	TEST_CHECK(NULL, pri_set_log_sink(NULL, test_log_sink, &log, PRI_LOG_ERROR) == -1);
+
+	/* Wanted output goes to the sink with its userdata instead of the global callbacks. */
+	TEST_CHECK(NULL, !pri_set_log_sink(ctrl, test_log_sink, &log,
+		PRI_LOG_ERROR | PRI_LOG_MESSAGE));
+	pri_error(ctrl, "sink error %d\n", 1);
+	TEST_CHECK(NULL, log.calls == 1 && log.ctrl == ctrl && log.level == PRI_LOG_ERROR);
+	TEST_CHECK(NULL, !strcmp(log.str, "sink error 1\n"));
+	pri_message(ctrl, "sink ");
+	TEST_CHECK(NULL, log.calls == 1);
+	pri_message(ctrl, "message %d\n", 2);
+	TEST_CHECK(NULL, log.calls == 2 && log.level == PRI_LOG_MESSAGE);
+	TEST_CHECK(NULL, !strcmp(log.str, "sink message 2\n"));
+
+	/* Output filtered out by the mask is not even formatted. */
+	TEST_CHECK(NULL, !pri_set_log_sink(ctrl, test_log_sink, &log, PRI_LOG_ERROR));
+	TEST_CHECK(NULL, !pri_log_wanted(ctrl, PRI_LOG_MESSAGE));
+	pri_message(ctrl, "sink unwanted %d", 3);
+	TEST_CHECK(NULL, ctrl->msg_line->length == 0);
+	pri_message(ctrl, "\n");
+	TEST_CHECK(NULL, log.calls == 2);
+	TEST_CHECK(NULL, !pri_set_log_sink(ctrl, test_log_sink, &log, 0));
+	TEST_CHECK(NULL, !pri_log_wanted(ctrl, PRI_LOG_ERROR));
+	pri_error(ctrl, "sink unwanted %d\n", 4);
+	TEST_CHECK(NULL, log.calls == 2);
+	TEST_CHECK(NULL, !pri_set_log_sink(ctrl, NULL, NULL, 0));
+	TEST_CHECK(NULL, test_message_hits == messages && test_errors == errors);
+
+	/* An NFAS slave without a sink of its own uses the sink of its master. */
+	if (!master) {
+		master = pri_new_cb(-1, PRI_CPE, PRI_SWITCH_EUROISDN_E1, test_io_read,
+			test_io_discard, NULL);
+		slave = pri_new_cb(-1, PRI_CPE, PRI_SWITCH_EUROISDN_E1, test_io_read,
+			test_io_discard, NULL);
+		TEST_CHECK(NULL, master && slave);
+		if (!master || !slave) {
+			test_message_match = NULL;
+			return;
+		}
+		pri_enslave(master, slave);
+	}
+	memset(&log, 0, sizeof(log));
+	TEST_CHECK(NULL, !pri_set_log_sink(master, test_log_sink, &log, PRI_LOG_ERROR));
+	pri_error(slave, "sink slave\n");
+	TEST_CHECK(NULL, log.calls == 1 && log.ctrl == slave);
+	pri_message(slave, "sink slave\n");
+	TEST_CHECK(NULL, log.calls == 1 && slave->msg_line->length == 0);
+	TEST_CHECK(NULL, test_message_hits == messages);
+
+	/* A sink of the slave's own takes precedence. */
+	TEST_CHECK(NULL, !pri_set_log_sink(slave, test_log_sink, &log, PRI_LOG_MESSAGE));
+	pri_error(slave, "sink slave\n");
+	TEST_CHECK(NULL, log.calls == 1);
+	pri_message(slave, "sink slave\n");
+	TEST_CHECK(NULL, log.calls == 2 && log.level == PRI_LOG_MESSAGE);
+	TEST_CHECK(NULL, !pri_set_log_sink(slave, NULL, NULL, 0));
+	TEST_CHECK(NULL, !pri_set_log_sink(master, NULL, NULL, 0));
+	test_message_match = NULL;
+}
+
+/* ------------------------------------------------------------------- */
+
+/*!
+ * \internal
+ * \brief Test command completions are never discarded by a full event queue.
+ *
+ * \return Nothing
+ */
+static void test_command_queue(void)
+{
+	static unsigned data[12];
+	struct pri *ctrl;
+	pri_event *e;
+	unsigned done;
+	unsigned runs;
+	unsigned idx;
+
+	ctrl = net_side.ctrl;
+	TEST_CHECK(ctrl, !pri_event_queue_enable(ctrl, 4));
+	TEST_CHECK(ctrl, !pri_command_queue_enable(ctrl, 1));
+	for (idx = 0; idx < ARRAY_LEN(data); ++idx) {
+		data[idx] = idx;
+	}
+	for (idx = 0; idx < 10; ++idx) {
+		TEST_CHECK(ctrl, !pri_command_submit(ctrl, test_command, &data[idx]));
+	}
+
+	/* The queue fills up so the rest of the commands must wait. */
+	TEST_CHECK(ctrl, pri_command_run(ctrl) != NULL);
+	TEST_CHECK(ctrl, ctrl->evq.count == 4);
+	TEST_CHECK(ctrl, test_command_pending(ctrl));
+	TEST_CHECK(ctrl, pri_command_queue_enable(ctrl, 0) == -1);
+
+	/* Commands submitted now run after the waiting commands. */
+	for (; idx < ARRAY_LEN(data); ++idx) {
+		TEST_CHECK(ctrl, !pri_command_submit(ctrl, test_command, &data[idx]));
+	}
+
+	done = 0;
+	for (runs = 0; runs < 100 && test_command_pending(ctrl); ++runs) {
+		for (e = pri_command_run(ctrl); e; e = pri_event_next(ctrl)) {
+			if (e->e == PRI_EVENT_COMMAND_DONE) {
+				TEST_CHECK(ctrl, e->command_done.data == &data[done]);
+				TEST_CHECK(ctrl, e->command_done.result == done + 1);
+				++done;
+			}
+			pri_event_release(ctrl);
+		}
+	}
+	TEST_CHECK(ctrl, done == ARRAY_LEN(data));
+	TEST_CHECK(ctrl, !test_command_pending(ctrl));
+
+	TEST_CHECK(ctrl, !pri_command_queue_enable(ctrl, 0));
+	TEST_CHECK(ctrl, !pri_event_queue_enable(ctrl, 0));
+}
+
+/*!
+ * \internal
+ * \brief Test commands submitted by several threads at once are each run once in order.
+ *
+ * \return Nothing
+ */
+static void test_command_threads(void)
+{
+	static struct test_submitter submitters[TEST_SUBMIT_THREADS];
+	struct test_submitter *submitter;
+	struct pollfd fds;
+	struct pri *ctrl;
+	pri_event *e;
+	unsigned done;
+	unsigned idx;
+
+	ctrl = net_side.ctrl;
+	TEST_CHECK(ctrl, !pri_event_queue_enable(ctrl, 64));
+	TEST_CHECK(ctrl, !pri_command_queue_enable(ctrl, 1));
+	for (idx = 0; idx < TEST_SUBMIT_THREADS; ++idx) {
+		submitters[idx].ctrl = ctrl;
+		if (pthread_create(&submitters[idx].thread, NULL, test_submit_thread,
+			&submitters[idx])) {
+			TEST_CHECK(ctrl, 0);
+			return;
+		}
+	}
+
+	/* This thread is the D channel thread. */
+	done = 0;
+	while (done < TEST_SUBMIT_THREADS * TEST_SUBMIT_COMMANDS) {
+		fds.fd = pri_command_fd(ctrl);
+		fds.events = POLLIN;
+		if (poll(&fds, 1, 1000) != 1) {
+			/* A wakeup got lost. */
+			TEST_CHECK(ctrl, 0);
+			break;
+		}
+		for (e = pri_command_run(ctrl); e; e = pri_event_next(ctrl)) {
+			TEST_CHECK(ctrl, e->e == PRI_EVENT_COMMAND_DONE);
+			for (idx = 0; idx < TEST_SUBMIT_THREADS; ++idx) {
+				submitter = &submitters[idx];
+				if (submitter->data <= (unsigned *) e->command_done.data
+					&& (unsigned *) e->command_done.data
+						< submitter->data + TEST_SUBMIT_COMMANDS) {
+					break;
+				}
+			}
+			if (idx < TEST_SUBMIT_THREADS) {
+				/* The commands of each thread complete in the order submitted. */
+				TEST_CHECK(ctrl, e->command_done.result == submitter->ran);
+				++submitter->ran;
+			} else {
+				TEST_CHECK(ctrl, 0);
+			}
+			++done;
+			pri_event_release(ctrl);
+		}
+	}
+	for (idx = 0; idx < TEST_SUBMIT_THREADS; ++idx) {
+		pthread_join(submitters[idx].thread, NULL);
+		TEST_CHECK(ctrl, !submitters[idx].failed);
+		TEST_CHECK(ctrl, submitters[idx].ran == TEST_SUBMIT_COMMANDS);
+	}
+	TEST_CHECK(ctrl, !test_command_pending(ctrl));
+	TEST_CHECK(ctrl, !pri_command_queue_enable(ctrl, 0));
+	TEST_CHECK(ctrl, !pri_event_queue_enable(ctrl, 0));
+}
+
+/* ------------------------------------------------------------------- */
+
+/*!
+ * \brief D channel call handling test program.
+ *
+ * \param argc Program argument count.
+ * \param argv Program argument string array.
+ *
+ * \retval 0 on success.
+ * \retval Nonzero on error.
+ */
+int main(int argc, char *argv[])
+{
+	pri_set_message(test_pri_message);
+	pri_set_error(test_pri_error);
+
+	if (test_connect(PRI_SWITCH_EUROISDN_E1)) {
+		fprintf(stderr, "Could not create D channel controllers\n");
+		return 1;
+	}
+	test_short_frames();
+	test_call_references();
+	test_frame_pool();
+	test_tx_pending();
+	test_iframe_backlog();
+	test_call_pool();
+	test_large_message();
+	test_stale_bytes();
+	test_event_queue();
+	test_trace();
+	test_io_batch_write();
+	test_log_sink_output();
+	test_lazy_ie_decode();
+	test_facility_arena();
+	test_unknown_ie();
+	test_mandatory_ie();
+	test_command_queue();
+	test_command_threads();
+
+	if (test_failures) {
+		fprintf(stderr, "%u call checks failed\n", test_failures);
+		return 1;
+	}
+	printf("Call tests passed\n");
+	return 0;
+}
+
+/* ------------------------------------------------------------------- */
+/* end calltest.c */
@@ -99,6 +99,7 @@
 #define PRI_EVENT_RETRIEVE_ACK	25	/* RETRIEVE_ACKNOWLEDGE received */
 #define PRI_EVENT_RETRIEVE_REJ	26	/* RETRIEVE_REJECT received */
 #define PRI_EVENT_CONNECT_ACK	27	/* CONNECT_ACKNOWLEDGE received */
+#define PRI_EVENT_COMMAND_DONE	28	/* Command submitted by pri_command_submit() completed */
 
 /* Simple states */
 #define PRI_STATE_DOWN		0
@@ -1296,6 +1297,14 @@ struct pri_event_connect_ack {
 	struct pri_subcommands *subcmds;
 };
 
+struct pri_event_command_done {
+	int e;
+	/*! Value returned by the command function. */
+	int result;
+	/*! Data pointer given to pri_command_submit(). */
+	void *data;
+};
+
 typedef union {
 	int e;
 	pri_event_generic gen;		/* Generic view */
@@ -1321,6 +1330,7 @@ typedef union {
 	struct pri_event_retrieve_ack retrieve_ack;
 	struct pri_event_retrieve_rej retrieve_rej;
 	struct pri_event_connect_ack connect_ack;
+	struct pri_event_command_done command_done;
 } pri_event;
 
 struct pri;
@@ -1343,6 +1353,34 @@ struct pri *pri_new_cb(int fd, int nodetype, int switchtype, pri_io_cb io_read,
 /* Create BRI D-channel just as above with user defined I/O callbacks and data */
 struct pri *pri_new_bri_cb(int fd, int ptpmode, int nodetype, int switchtype, pri_io_cb io_read, pri_io_cb io_write, void *userdata);
 
+#define PRI_IO_BATCH_CB
+struct iovec;
+/*!
+ * \brief Type declaration for a callback to write several HDLC frames at once.
+ *
+ * \param pri D channel controller.
+ * \param iov One entry per frame.  (Each frame includes room for the FCS)
+ * \param iovcnt Number of frames to write.
+ *
+ * \return Number of frames written.
+ */
+typedef int (*pri_io_batch_cb)(struct pri *pri, const struct iovec *iov, int iovcnt);
+
+/*!
+ * \brief Set a callback to write frames in batches.
+ *
+ * \param pri D channel controller.
+ * \param io_batch Batch write callback.  (NULL to write each frame with the io_write callback)
+ *
+ * \note The frames sent while processing a received frame or expired timers
+ * are passed to the callback together when the processing completes.  Frames
+ * sent at other times are passed to the callback one at a time.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+int pri_set_io_batch_cb(struct pri *pri, pri_io_batch_cb io_batch);
+
 /* Retrieve the user data associated with the D channel */
 void *pri_get_userdata(struct pri *pri);
 
@@ -1370,6 +1408,226 @@ pri_event *pri_dchannel_run(struct pri *pri, int block);
 /* Check for an outstanding event on the PRI */
 pri_event *pri_check_event(struct pri *pri);
 
+#define PRI_RECEIVE_FRAME
+/*!
+ * \brief Process a received D channel frame held in a caller owned buffer.
+ *
+ * \param pri D channel controller.
+ * \param frame Received Q.921 frame including the two FCS octets.
+ * \param len Length of the frame including the two FCS octets.
+ *
+ * \note The frame is parsed in place without being copied or modified.
+ * The buffer only needs to remain valid for the duration of the call.
+ * \note A frame too short to hold the address, control, and FCS fields
+ * is reported as an error and discarded.
+ * \note This is an alternative to pri_check_event() for applications
+ * that already have the frame in memory and do not use read_func.
+ *
+ * \retval event if the frame generated an event for the upper layer.
+ * \retval NULL if there is no event to handle.
+ */
+pri_event *pri_receive_frame(struct pri *pri, const void *frame, int len);
+
+#define PRI_EVENT_QUEUE
+/*!
+ * \brief Enable or disable the controller event queue.
+ *
+ * \param pri D channel controller.
+ * \param size Number of events the queue starts out holding.  (0 disables the queue)
+ *
+ * \note With the queue enabled, every event generated while processing a
+ * received frame or expired timers is queued with its own copy of the
+ * subcommands instead of only the last one being returned.
+ * pri_check_event(), pri_receive_frame(), pri_schedule_run(), and
+ * pri_dchannel_run() then return the oldest queued event, which stays
+ * queued until pri_event_release() is called.
+ * pri_schedule_run_batch() moves the queued events to its events array.
+ * \note The queue grows when it is full rather than discard an event.
+ * \note The queue size cannot be changed while events are queued.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+int pri_event_queue_enable(struct pri *pri, unsigned size);
+
+/*!
+ * \brief Get the oldest queued event of the controller.
+ *
+ * \param pri D channel controller.
+ *
+ * \note The event stays valid until released by pri_event_release().
+ *
+ * \retval event if an event is queued.
+ * \retval NULL if the queue is empty or not enabled.
+ */
+pri_event *pri_event_next(struct pri *pri);
+
+/*!
+ * \brief Remove the oldest queued event of the controller.
+ *
+ * \param pri D channel controller.
+ *
+ * \return Nothing
+ */
+void pri_event_release(struct pri *pri);
+
+#define PRI_COMMAND_QUEUE
+/*!
+ * \brief Function run by the D channel thread for a submitted command.
+ *
+ * \param pri D channel controller the command was submitted to.
+ * \param data Data pointer given to pri_command_submit().
+ *
+ * \return Value reported in the PRI_EVENT_COMMAND_DONE event.
+ */
+typedef int (*pri_command_func)(struct pri *pri, void *data);
+
+/*!
+ * \brief Enable or disable the controller command queue.
+ *
+ * \param pri D channel controller.
+ * \param enable TRUE to enable the command queue.
+ *
+ * \note The command queue lets other threads hand requests such as
+ * pri_answer() or pri_hangup() to the thread running the D channel
+ * instead of locking the controller around every call.
+ * \note The event queue must be enabled first since every command
+ * completes with a PRI_EVENT_COMMAND_DONE event.
+ * \note The queue cannot be disabled while commands are waiting or
+ * while other threads may still submit commands.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+int pri_command_queue_enable(struct pri *pri, int enable);
+
+/*!
+ * \brief Get the file descriptor signalling waiting commands.
+ *
+ * \param pri D channel controller.
+ *
+ * \note The descriptor becomes readable when commands are waiting.
+ * pri_dchannel_run() and the reactor already wait on it.  Other event
+ * loops need to call pri_command_run() when it is readable.
+ *
+ * \retval fd on success.
+ * \retval -1 if the command queue is not enabled.
+ */
+int pri_command_fd(struct pri *pri);
+
+/*!
+ * \brief Submit a command to be run by the D channel thread.
+ *
+ * \param pri D channel controller.
+ * \param func Function to run on the D channel thread.
+ * \param data Data pointer passed to func and reported in the completion event.
+ *
+ * \note This is the only command queue function that may be called from
+ * other threads.  It does not take any locks.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+int pri_command_submit(struct pri *pri, pri_command_func func, void *data);
+
+/*!
+ * \brief Run the submitted commands of the controller.
+ *
+ * \param pri D channel controller.
+ *
+ * \note Must be called by the thread running the D channel.  Commands
+ * are run in the order submitted and each queues a
+ * PRI_EVENT_COMMAND_DONE event.
+ * \note Completion events are never discarded.  Commands without room
+ * for their completion event stay waiting, and the command file
+ * descriptor stays readable, until queued events are released.
+ *
+ * \retval event The oldest queued event.  (See pri_event_next())
+ * \retval NULL if no events are queued.
+ */
+pri_event *pri_command_run(struct pri *pri);
+
+#define PRI_TRACE
+/*! Most octets of a frame kept in a trace record. */
+#define PRI_TRACE_FRAME_MAX	520
+
+/* Trace record directions */
+#define PRI_TRACE_RX	0	/* Frame received */
+#define PRI_TRACE_TX	1	/* Frame sent */
+
+/*! Binary trace record of one D channel frame. */
+struct pri_trace_record {
+	/*! Sequence number of the record on the controller. */
+	unsigned long seq;
+	/*! Capture time seconds. */
+	long tv_sec;
+	/*! Capture time microseconds. */
+	long tv_usec;
+	/*! Span number given to pri_trace_enable(). */
+	int span;
+	/*! PRI_TRACE_RX or PRI_TRACE_TX */
+	int direction;
+	/*! Q.921 SAPI of the frame. */
+	int sapi;
+	/*! Q.921 TEI of the frame. */
+	int tei;
+	/*! Q.931 call reference as coded in the message. (-1 if not a Q.931 message) */
+	int cref;
+	/*! Q.931 message type. (-1 if not a Q.931 message) */
+	int msgtype;
+	/*! Length of the frame without the FCS. */
+	int len;
+	/*! Number of frame octets captured in frame[]. */
+	int caplen;
+	/*! Captured frame octets. */
+	unsigned char frame[PRI_TRACE_FRAME_MAX];
+};
+
+/*!
+ * \brief Enable or disable the binary trace ring of the controller.
+ *
+ * \param pri D channel controller.
+ * \param size Number of records the ring holds.  (0 disables the ring)
+ * \param span Span number put in the trace records.
+ *
+ * \note Every frame sent or received is copied into the ring with its
+ * metadata without any text formatting.  The oldest records are
+ * overwritten when the ring is full.
+ * \note No thread may be reading the ring while it is enabled or disabled.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+int pri_trace_enable(struct pri *pri, unsigned size, int span);
+
+/*!
+ * \brief Get a copy of the next trace record.
+ *
+ * \param pri D channel controller.
+ * \param cursor Sequence number of the record wanted.  (Start with 0)
+ * Updated to the sequence number of the following record.
+ * \param record Where to put the record copy.
+ *
+ * \note May be called from another thread than the one running the
+ * D channel.  Records overwritten before they are read are skipped.
+ * The skip shows as record->seq being ahead of the cursor passed in.
+ *
+ * \retval 1 if a record was copied.
+ * \retval 0 if no new records are available.
+ * \retval -1 on error.
+ */
+int pri_trace_read(struct pri *pri, unsigned long *cursor, struct pri_trace_record *record);
+
+/*!
+ * \brief Decode a trace record with the normal Q.921 and Q.931 dump output.
+ *
+ * \param pri D channel controller whose configuration is used to decode.
+ * \param record Trace record to decode.
+ *
+ * \return Nothing
+ */
+void pri_trace_dump(struct pri *pri, const struct pri_trace_record *record);
+
 /* Give a name to a given event ID */
 char *pri_event2str(int id);
 
@@ -1532,6 +1790,22 @@ int pri_hangup(struct pri *pri, q931_call *call, int cause);
  */
 void pri_hangup_fix_enable(struct pri *ctrl, int enable);
 
+#define PRI_LAZY_IE_DECODE
+/*!
+ * \brief Set the lazy optional ie decode enable flag.
+ *
+ * \param ctrl D channel controller.
+ * \param enable TRUE to only decode the optional user-user, generic digits,
+ * and redirecting number ies of received messages that report them.
+ * FALSE for legacy behaviour. (Default FALSE if not called.)
+ *
+ * \note Mandatory ie checking and call state handling are not affected.
+ * Skipped ies are not remembered for a later message's event.
+ *
+ * \return Nothing
+ */
+void pri_lazy_ie_decode_enable(struct pri *ctrl, int enable);
+
 #define PRI_DESTROYCALL
 void pri_destroycall(struct pri *pri, q931_call *call);
 
@@ -1565,8 +1839,151 @@ struct timeval *pri_schedule_next(struct pri *pri);
 
 /* Run any pending schedule events */
 extern pri_event *pri_schedule_run(struct pri *pri);
+
+#define PRI_SCHEDULE_CLOCK
+/*!
+ * \brief Get the current time of the clock the scheduler runs on.
+ *
+ * \param now Filled with the current time.
+ *
+ * \note The scheduler clock is CLOCK_MONOTONIC when available so
+ * timers are not disturbed by wall clock time adjustments.
+ * The time is only meaningful to pri_schedule_run_tv() and
+ * pri_schedule_next_ms().
+ *
+ * \return Nothing
+ */
+void pri_schedule_now(struct timeval *now);
+
+/*!
+ * \brief Run any pending schedule events using the supplied current time.
+ *
+ * \param pri D channel controller.
+ * \param now Current scheduler clock time obtained from pri_schedule_now().
+ *
+ * \note Timers started by the expired timers are relative to the supplied
+ * time instead of reading the clock again.  Timers started outside of
+ * this call still read the scheduler clock.  One timestamp per event
+ * loop iteration can drive all controllers in the loop.
+ *
+ * \return Event for upper layer to process or NULL if all expired timers run.
+ */
 extern pri_event *pri_schedule_run_tv(struct pri *pri, const struct timeval *now);
 
+#define PRI_SCHEDULE_RUN_BATCH
+/*!
+ * \brief Run all expired timers and collect every event they generate.
+ *
+ * \param pri D channel controller.
+ * \param now Current scheduler clock time obtained from pri_schedule_now().
+ * \param events Array to fill with the generated events.
+ * \param subcmds Array parallel to events to hold the subcommands of each event.
+ * NULL if the subcommands are not wanted.  (The event subcmds pointers are NULL then.)
+ * \param max_events Number of entries available in the events and subcmds arrays.
+ *
+ * \note Like pri_schedule_run_tv(), timers started by the expired timers
+ * are relative to the supplied time.
+ * \note If the event queue is enabled, the queued events are moved to the
+ * events array oldest first.  Any that do not fit stay queued.
+ *
+ * \return Number of events put in the events array.
+ * If max_events is returned there may be more expired timers to run.
+ */
+int pri_schedule_run_batch(struct pri *pri, const struct timeval *now, pri_event *events, struct pri_subcommands *subcmds, int max_events);
+
+/*!
+ * \brief Determine how long until the next scheduled event expires.
+ *
+ * \param pri D channel controller.
+ * \param now Current scheduler clock time obtained from pri_schedule_now().
+ *
+ * \retval -1 if no timers are active.
+ * \retval ms Milliseconds until the next timer expires. (0 if already expired)
+ */
+int pri_schedule_next_ms(struct pri *pri, const struct timeval *now);
+
+#define PRI_REACTOR
+/*! Event loop serving several D channel controllers from one thread. (Linux only) */
+struct pri_reactor;
+
+/*!
+ * \brief Create a new D channel controller reactor.
+ *
+ * \retval reactor on success.
+ * \retval NULL on error.
+ */
+struct pri_reactor *pri_reactor_new(void);
+
+/*!
+ * \brief Destroy the reactor.
+ *
+ * \param reactor Reactor to destroy.
+ *
+ * \note The registered controllers are not destroyed.
+ *
+ * \return Nothing
+ */
+void pri_reactor_destroy(struct pri_reactor *reactor);
+
+/*!
+ * \brief Register a D channel controller with the reactor.
+ *
+ * \param reactor Reactor to register with.
+ * \param pri D channel controller.  (Must have a D channel file descriptor)
+ *
+ * \note Each D channel of an NFAS group must be registered.
+ * \note Enable the command queue before registering the controller so
+ * the reactor also runs the submitted commands.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+int pri_reactor_add(struct pri_reactor *reactor, struct pri *pri);
+
+/*!
+ * \brief Unregister a D channel controller from the reactor.
+ *
+ * \param reactor Reactor to unregister from.
+ * \param pri D channel controller.
+ *
+ * \retval 0 on success.
+ * \retval -1 if the controller was not registered.
+ */
+int pri_reactor_remove(struct pri_reactor *reactor, struct pri *pri);
+
+/*!
+ * \brief Get the reactor file descriptor.
+ *
+ * \param reactor Reactor to query.
+ *
+ * \note The file descriptor is an epoll file descriptor that becomes
+ * readable when a registered D channel has a frame or the earliest timer
+ * of the registered controllers expires.  It can be added to another
+ * poll loop.  Call pri_reactor_run() with a zero timeout when it is
+ * readable or after starting calls so the timer deadline is updated.
+ *
+ * \retval fd on success.
+ * \retval -1 on error.
+ */
+int pri_reactor_fd(struct pri_reactor *reactor);
+
+/*!
+ * \brief Wait for and process D channel frames and timers of all registered controllers.
+ *
+ * \param reactor Reactor to run.
+ * \param timeout_ms Milliseconds to wait.  (-1 to wait until an event occurs, 0 to poll)
+ * \param pri Filled with the controller the returned event is for.
+ *
+ * \note Like pri_dchannel_run(), events are returned one at a time
+ * and the event is only valid until the controller is used again.
+ * \note If the event queue of the controller is enabled, the rest of
+ * its queued events are returned before anything else is processed.
+ *
+ * \retval event for the upper layer to process.
+ * \retval NULL on timeout, interruption, or error.
+ */
+pri_event *pri_reactor_run(struct pri_reactor *reactor, int timeout_ms, struct pri **pri);
+
 int pri_call(struct pri *pri, q931_call *c, int transmode, int channel,
     int exclusive, int nonisdn, char *caller, int callerplan, char *callername, int callerpres,
     char *called, int calledplan, int ulayer1);
@@ -1712,6 +2129,41 @@ int pri_channel_bridge(q931_call *call1, q931_call *call2);
 void pri_set_message(void (*__pri_error)(struct pri *pri, char *));
 void pri_set_error(void (*__pri_error)(struct pri *pri, char *));
 
+#define PRI_LOG_SINK
+/* Log levels for the controller log sink */
+#define PRI_LOG_ERROR	(1 << 0)	/* pri_set_error() output */
+#define PRI_LOG_MESSAGE	(1 << 1)	/* pri_set_message() output (debug dumps and traces) */
+
+/*!
+ * \brief Controller log sink callback.
+ *
+ * \param pri D channel controller the output is for.
+ * \param userdata Data pointer given to pri_set_log_sink().
+ * \param level PRI_LOG_ERROR or PRI_LOG_MESSAGE.
+ * \param line Output text.  (Message output is passed a complete line at a time)
+ *
+ * \return Nothing
+ */
+typedef void (*pri_log_cb)(struct pri *pri, void *userdata, int level, const char *line);
+
+/*!
+ * \brief Send the output of the controller to its own log sink.
+ *
+ * \param pri D channel controller.
+ * \param func Log sink callback.  (NULL to go back to the pri_set_message()
+ * and pri_set_error() callbacks)
+ * \param userdata Data pointer passed to func.
+ * \param levels Bitmask of PRI_LOG_ERROR and PRI_LOG_MESSAGE output wanted.
+ *
+ * \note Output at levels not wanted is discarded before it is formatted.
+ * \note An NFAS slave without a log sink of its own sends its output to
+ * the log sink of its master.  (See pri_enslave())
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+int pri_set_log_sink(struct pri *pri, pri_log_cb func, void *userdata, int levels);
+
 /* Set overlap mode */
 #define PRI_SET_OVERLAPDIAL
 void pri_set_overlapdial(struct pri *pri,int state);
@@ -1723,6 +2175,56 @@ void pri_set_chan_mapping_logical(struct pri *pri, int state);
 #define PRI_DUMP_INFO_STR
 char *pri_dump_info_str(struct pri *pri);
 
+#define PRI_CALL_POOL
+/*! Call record pool statistics. */
+struct pri_call_pool_stats {
+	/*! Number of call records currently in use. */
+	unsigned in_use;
+	/*! Number of free call records ready for reuse. */
+	unsigned available;
+	/*! Maximum number of call records in use at once. */
+	unsigned high_water;
+	/*! Number of times a call record could not be allocated. */
+	unsigned alloc_failures;
+};
+
+/*!
+ * \brief Preallocate call records so new calls do not need to allocate memory.
+ *
+ * \param pri D channel controller.  (An NFAS group shares one pool.)
+ * \param count Number of free call records to have available.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+int pri_call_pool_prealloc(struct pri *pri, unsigned count);
+
+/*!
+ * \brief Get the call record pool statistics.
+ *
+ * \param pri D channel controller.  (An NFAS group shares one pool.)
+ * \param stats Filled with the call record pool statistics.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+int pri_call_pool_stats(struct pri *pri, struct pri_call_pool_stats *stats);
+
+#define PRI_IFRAME_BACKLOG
+/*!
+ * \brief Set how many Q.921 I-frames may queue beyond the window size K
+ * before the retransmission queue has to allocate memory.
+ *
+ * \param pri D channel controller.
+ * \param backlog Number of preallocated I-frame buffers beyond K.
+ *
+ * \note Takes effect on links with an empty retransmission queue.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+int pri_set_iframe_backlog(struct pri *pri, int backlog);
+
 /* Get file descriptor */
 int pri_fd(struct pri *pri);
 
@@ -1751,7 +2253,8 @@ int pri_proceeding(struct pri *pri, q931_call *c, int channel, int info);
 void pri_set_inbanddisconnect(struct pri *pri, unsigned int enable);
 
 /* Enslave a PRI to another, so they share the same call list
-   (and maybe some timers) */
+   (and maybe some timers).  A slave without a log sink of its own
+   uses the log sink of the master.  (See pri_set_log_sink()) */
 void pri_enslave(struct pri *master, struct pri *slave);
 
 /*!
@@ -35,6 +35,7 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <sys/select.h>
+#include <fcntl.h>
 #include <stdarg.h>
 #include "compat.h"
 #include "libpri.h"
@@ -295,6 +296,133 @@ static int __pri_write(struct pri *pri, void *buf, int buflen)
 	return res;
 }
 
+/*!
+ * \internal
+ * \brief Pass the frames waiting in the batch to the batch write callback.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return Nothing
+ */
+static void pri_tx_batch_flush(struct pri *ctrl)
+{
+	struct pri_tx_batch *batch;
+	int res;
+
+	batch = ctrl->tx_batch;
+	if (!batch || !batch->count) {
+		return;
+	}
+	res = ctrl->write_batch_func(ctrl, batch->iov, batch->count);
+	if (res != batch->count) {
+		pri_error(ctrl, "Short batch write: %d/%d frames (%s)\n", res, batch->count,
+			strerror(errno));
+	}
+	batch->count = 0;
+	batch->used = 0;
+}
+
+/*!
+ * \brief Start a pass whose transmitted frames are written together.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \note Passes may nest.  The frames are written when the outermost pass ends.
+ *
+ * \return Nothing
+ */
+void pri_tx_batch_begin(struct pri *ctrl)
+{
+	++PRI_NFAS_MASTER(ctrl)->tx_batch_depth;
+}
+
+/*!
+ * \brief End a pass started by pri_tx_batch_begin().
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return Nothing
+ */
+void pri_tx_batch_end(struct pri *ctrl)
+{
+	ctrl = PRI_NFAS_MASTER(ctrl);
+	if (--ctrl->tx_batch_depth) {
+		return;
+	}
+
+	/* Write the frames queued on every D channel of the NFAS group. */
+	for (; ctrl; ctrl = ctrl->slave) {
+		pri_tx_batch_flush(ctrl);
+	}
+}
+
+/*!
+ * \brief Write a frame out the D channel.
+ *
+ * \param ctrl D channel controller.
+ * \param buf Frame to write.  (Including room for the FCS)
+ * \param len Length of the frame.
+ *
+ * \note If a batch write callback is set and a batch pass is in progress
+ * the frame is copied to wait for the end of the pass.
+ *
+ * \return Number of octets written or queued.
+ */
+int pri_write_frame(struct pri *ctrl, void *buf, int len)
+{
+	struct pri_tx_batch *batch;
+	struct iovec iov;
+	int res;
+
+	batch = ctrl->tx_batch;
+	if (!batch) {
+		return ctrl->write_func ? ctrl->write_func(ctrl, buf, len) : 0;
+	}
+
+	if (PRI_NFAS_MASTER(ctrl)->tx_batch_depth && len <= PRI_TX_BATCH_SIZE) {
+		if (batch->count == PRI_TX_BATCH_FRAMES
+			|| PRI_TX_BATCH_SIZE - batch->used < len) {
+			/* No room left in the batch. */
+			pri_tx_batch_flush(ctrl);
+		}
+		iov.iov_base = batch->buf + batch->used;
+		iov.iov_len = len;
+		memcpy(iov.iov_base, buf, len);
+		batch->iov[batch->count++] = iov;
+		batch->used += len;
+		return len;
+	}
+
+	/* Keep the frames in order. */
+	pri_tx_batch_flush(ctrl);
+	iov.iov_base = buf;
+	iov.iov_len = len;
+	res = ctrl->write_batch_func(ctrl, &iov, 1);
+	return (res == 1) ? len : 0;
+}
+
+int pri_set_io_batch_cb(struct pri *ctrl, pri_io_batch_cb io_batch)
+{
+	if (!ctrl) {
+		return -1;
+	}
+	if (!io_batch) {
+		pri_tx_batch_flush(ctrl);
+		free(ctrl->tx_batch);
+		ctrl->tx_batch = NULL;
+		ctrl->write_batch_func = NULL;
+		return 0;
+	}
+	if (!ctrl->tx_batch) {
+		ctrl->tx_batch = calloc(1, sizeof(*ctrl->tx_batch));
+		if (!ctrl->tx_batch) {
+			return -1;
+		}
+	}
+	ctrl->write_batch_func = io_batch;
+	return 0;
+}
+
 /*!
  * \internal
  * \brief Determine the default layer 2 persistence option.
@@ -409,6 +537,7 @@ void pri_link_destroy(struct q921_link *link)
 			call->retranstimer = 0;
 			pri_call_apdu_queue_cleanup(call);
 		}
+		q921_frame_pool_destroy(link);
 		free(link);
 	}
 }
@@ -478,6 +607,26 @@ struct q921_link *pri_link_new(struct pri *ctrl, int sapi, int tei)
 	return link;
 }
 
+/*!
+ * \internal
+ * \brief Free the outgrown event rings.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return Nothing
+ */
+static void pri_event_retired_free(struct pri *ctrl)
+{
+	struct pri_event_retired *retired;
+
+	while (ctrl->evq.retired) {
+		retired = ctrl->evq.retired;
+		ctrl->evq.retired = retired->next;
+		free(retired->records);
+		free(retired);
+	}
+}
+
 /*!
  * \internal
  * \brief Destroy the given D channel controller.
@@ -504,8 +653,16 @@ static void pri_ctrl_destroy(struct pri *ctrl)
 			call->retranstimer = 0;
 			pri_call_apdu_queue_cleanup(call);
 		}
+		q921_frame_pool_destroy(&ctrl->link);
+		free(ctrl->tx_batch);
+		free(ctrl->evq.records);
+		pri_event_retired_free(ctrl);
+		pri_command_queue_destroy(ctrl);
+		free(ctrl->trace.slots);
+		free(ctrl->rose_arena.buf);
 		free(ctrl->msg_line);
-		free(ctrl->sched.timer);
+		pri_schedule_destroy(ctrl);
+		q931_call_slab_destroy(&ctrl->localslab);
 		free(ctrl);
 	}
 }
@@ -578,6 +735,8 @@ static struct pri *pri_ctrl_new(int fd, int node, int switchtype, pri_io_cb rd,
 	ctrl->cref = 1;
 	ctrl->nsf = PRI_NSF_NONE;
 	ctrl->callpool = &ctrl->localpool;
+	ctrl->callindex = &ctrl->localindex;
+	ctrl->callslab = &ctrl->localslab;
 	pri_default_timers(ctrl, switchtype);
 	ctrl->q921_rxcount = 0;
 	ctrl->q921_txcount = 0;
@@ -585,6 +744,9 @@ static struct pri *pri_ctrl_new(int fd, int node, int switchtype, pri_io_cb rd,
 	ctrl->q931_txcount = 0;
 
 	ctrl->l2_persistence = pri_l2_persistence_option_default(ctrl);
+	ctrl->iframe_backlog = Q921_FRAME_POOL_BACKLOG;
+	ctrl->cmdq.wake[0] = -1;
+	ctrl->cmdq.wake[1] = -1;
 	ctrl->display_flags.send = pri_display_options_send_default(ctrl);
 	ctrl->display_flags.receive = pri_display_options_receive_default(ctrl);
 	switch (switchtype) {
@@ -762,6 +924,7 @@ char *pri_event2str(int id)
 		{ PRI_EVENT_RETRIEVE_ACK,   "PRI_EVENT_RETRIEVE_ACK" },
 		{ PRI_EVENT_RETRIEVE_REJ,   "PRI_EVENT_RETRIEVE_REJ" },
 		{ PRI_EVENT_CONNECT_ACK,    "PRI_EVENT_CONNECT_ACK" },
+		{ PRI_EVENT_COMMAND_DONE,   "PRI_EVENT_COMMAND_DONE" },
 /* *INDENT-ON* */
 	};
 
@@ -773,44 +936,95 @@ char *pri_event2str(int id)
 	return "Unknown Event";
 }
 
+pri_event *pri_receive_frame(struct pri *ctrl, const void *frame, int len)
+{
+	pri_event *e;
+
+	if (!ctrl || !frame) {
+		return NULL;
+	}
+	if (len < 5) {
+		/* Too short to hold the address, control, and FCS fields. */
+		pri_error(ctrl, "!! Received short frame of %d octets\n", len);
+		return pri_event_next(ctrl);
+	}
+
+	/*
+	 * Receive the q921 packet.  The frame is parsed in place and not
+	 * modified.  (q931_receive() answers a SERVICE message with a copy.)
+	 */
+	ctrl->schedev = 0;
+	pri_tx_batch_begin(ctrl);
+	e = q921_receive(ctrl, (q921_h *) frame, len);
+	pri_tx_batch_end(ctrl);
+	if (ctrl->evq.records) {
+		/*
+		 * Events raised by pri_event_ready() while processing the frame
+		 * are already queued.  The returned event goes after them.
+		 */
+		if (e) {
+			pri_event_post(ctrl, e);
+		}
+		e = pri_event_next(ctrl);
+	} else if (!e && ctrl->schedev) {
+		/* Event raised by pri_event_ready() while processing the frame. */
+		e = &ctrl->ev;
+	}
+	ctrl->schedev = 0;
+	return e;
+}
+
 pri_event *pri_check_event(struct pri *pri)
 {
 	char buf[1024];
 	int res;
-	pri_event *e;
 	res = pri->read_func ? pri->read_func(pri, buf, sizeof(buf)) : 0;
-	if (!res)
-		return NULL;
-	/* Receive the q921 packet */
-	e = q921_receive(pri, (q921_h *)buf, res);
-	return e;
+	if (res <= 0)
+		return pri_event_next(pri);
+	return pri_receive_frame(pri, buf, res);
 }
 
+/*!
+ * \internal
+ * \brief Wait for the D channel, a submitted command, or the next timer.
+ *
+ * \param pri D channel controller.
+ *
+ * \retval 2 if submitted commands are waiting.
+ * \retval 1 if the D channel is readable.
+ * \retval 0 if the next timer expired.
+ * \retval -1 on error or interruption.
+ */
 static int wait_pri(struct pri *pri)
 {	
-	struct timeval *tv, real;
+	struct timeval now, real;
 	fd_set fds;
 	int res;
+	int ms;
+	int maxfd;
 	FD_ZERO(&fds);
 	FD_SET(pri->fd, &fds);
-	tv = pri_schedule_next(pri);
-	if (tv) {
-		gettimeofday(&real, NULL);
-		real.tv_sec = tv->tv_sec - real.tv_sec;
-		real.tv_usec = tv->tv_usec - real.tv_usec;
-		if (real.tv_usec < 0) {
-			real.tv_usec += 1000000;
-			real.tv_sec -= 1;
-		}
-		if (real.tv_sec < 0) {
-			real.tv_sec = 0;
-			real.tv_usec = 0;
+	maxfd = pri->fd;
+	if (0 <= pri->cmdq.wake[0]) {
+		FD_SET(pri->cmdq.wake[0], &fds);
+		if (maxfd < pri->cmdq.wake[0]) {
+			maxfd = pri->cmdq.wake[0];
 		}
 	}
-	res = select(pri->fd + 1, &fds, NULL, NULL, tv ? &real : tv);
+	pri_schedule_now(&now);
+	ms = pri_schedule_next_ms(pri, &now);
+	if (0 <= ms) {
+		real.tv_sec = ms / 1000;
+		real.tv_usec = (ms % 1000) * 1000;
+	}
+	res = select(maxfd + 1, &fds, NULL, NULL, (0 <= ms) ? &real : NULL);
 	if (res < 0) 
 		return -1;
-	return res;
+	if (res && 0 <= pri->cmdq.wake[0] && FD_ISSET(pri->cmdq.wake[0], &fds)) {
+		/* Run the commands first.  The D channel is still readable next time. */
+		return 2;
+	}
+	return res ? 1 : 0;
 }
 
 pri_event *pri_mkerror(struct pri *pri, char *errstr)
@@ -822,6 +1036,410 @@ pri_event *pri_mkerror(struct pri *pri, char *errstr)
 }
 
 
+/*!
+ * \brief Find the subcommands pointer of the given event.
+ *
+ * \param e Event to examine.
+ *
+ * \return Location of the event subcmds pointer.
+ * \retval NULL if the event type does not have subcommands.
+ */
+struct pri_subcommands **pri_event_subcmds(pri_event *e)
+{
+	switch (e->e) {
+	case PRI_EVENT_RING:
+	case PRI_EVENT_INFO_RECEIVED:
+		return &e->ring.subcmds;
+	case PRI_EVENT_HANGUP:
+	case PRI_EVENT_HANGUP_ACK:
+	case PRI_EVENT_HANGUP_REQ:
+		return &e->hangup.subcmds;
+	case PRI_EVENT_RINGING:
+		return &e->ringing.subcmds;
+	case PRI_EVENT_ANSWER:
+		return &e->answer.subcmds;
+	case PRI_EVENT_FACILITY:
+		return &e->facility.subcmds;
+	case PRI_EVENT_PROCEEDING:
+	case PRI_EVENT_PROGRESS:
+		return &e->proceeding.subcmds;
+	case PRI_EVENT_SETUP_ACK:
+		return &e->setup_ack.subcmds;
+	case PRI_EVENT_NOTIFY:
+		return &e->notify.subcmds;
+	case PRI_EVENT_KEYPAD_DIGIT:
+		return &e->digit.subcmds;
+	case PRI_EVENT_HOLD:
+		return &e->hold.subcmds;
+	case PRI_EVENT_HOLD_ACK:
+		return &e->hold_ack.subcmds;
+	case PRI_EVENT_HOLD_REJ:
+		return &e->hold_rej.subcmds;
+	case PRI_EVENT_RETRIEVE:
+		return &e->retrieve.subcmds;
+	case PRI_EVENT_RETRIEVE_ACK:
+		return &e->retrieve_ack.subcmds;
+	case PRI_EVENT_RETRIEVE_REJ:
+		return &e->retrieve_rej.subcmds;
+	case PRI_EVENT_CONNECT_ACK:
+		return &e->connect_ack.subcmds;
+	default:
+		break;
+	}
+	return NULL;
+}
+
+/*!
+ * \brief Copy an event so it survives the controller generating the next event.
+ *
+ * \param dst Where to put the event copy.
+ * \param dst_subcmds Where to put a copy of the event subcommands.
+ * NULL if the subcommands are not wanted.
+ * \param src Event to copy.
+ *
+ * \return Nothing
+ */
+void pri_event_copy(pri_event *dst, struct pri_subcommands *dst_subcmds, const pri_event *src)
+{
+	struct pri_subcommands **subcmds;
+
+	*dst = *src;
+	subcmds = pri_event_subcmds(dst);
+	if (!subcmds || !*subcmds) {
+		return;
+	}
+	if (dst_subcmds) {
+		/* Only copy the subcommands actually used. */
+		dst_subcmds->counter_subcmd = (*subcmds)->counter_subcmd;
+		memcpy(dst_subcmds->subcmd, (*subcmds)->subcmd,
+			(*subcmds)->counter_subcmd * sizeof((*subcmds)->subcmd[0]));
+	}
+	*subcmds = dst_subcmds;
+}
+
+int pri_event_queue_enable(struct pri *ctrl, unsigned size)
+{
+	struct pri_event_record *records;
+
+	if (!ctrl || ctrl->evq.count) {
+		return -1;
+	}
+	pri_event_retired_free(ctrl);
+	if (!size) {
+		free(ctrl->evq.records);
+		ctrl->evq.records = NULL;
+		ctrl->evq.size = 0;
+		ctrl->evq.head = 0;
+		return 0;
+	}
+	records = malloc(size * sizeof(*records));
+	if (!records) {
+		return -1;
+	}
+	free(ctrl->evq.records);
+	ctrl->evq.records = records;
+	ctrl->evq.size = size;
+	ctrl->evq.head = 0;
+	return 0;
+}
+
+/*!
+ * \internal
+ * \brief Double the size of the full controller event queue.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \note The old ring is kept until the next pri_event_release() because
+ * the upper layer may still hold the oldest event from pri_event_next().
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+static int pri_event_queue_grow(struct pri *ctrl)
+{
+	struct pri_event_retired *retired;
+	struct pri_event_record *records;
+	struct pri_event_record *old;
+	unsigned size;
+	unsigned idx;
+
+	size = 2 * ctrl->evq.size;
+	records = malloc(size * sizeof(*records));
+	if (!records) {
+		return -1;
+	}
+	retired = malloc(sizeof(*retired));
+	if (!retired) {
+		free(records);
+		return -1;
+	}
+
+	/* Copy the queued events oldest first to the start of the new ring. */
+	for (idx = 0; idx < ctrl->evq.count; ++idx) {
+		old = &ctrl->evq.records[(ctrl->evq.head + idx) % ctrl->evq.size];
+		pri_event_copy(&records[idx].ev, &records[idx].subcmds, &old->ev);
+	}
+
+	retired->records = ctrl->evq.records;
+	retired->next = ctrl->evq.retired;
+	ctrl->evq.retired = retired;
+	ctrl->evq.records = records;
+	ctrl->evq.size = size;
+	ctrl->evq.head = 0;
+	return 0;
+}
+
+/*!
+ * \brief Put a copy of the event on the tail of the controller event queue.
+ *
+ * \param ctrl D channel controller.
+ * \param e Event to queue.
+ *
+ * \note The event queue grows when it is full.  The event is only
+ * discarded if there is no memory to grow the queue.
+ *
+ * \return Nothing
+ */
+void pri_event_post(struct pri *ctrl, const pri_event *e)
+{
+	struct pri_event_record *record;
+
+	if (ctrl->evq.size <= ctrl->evq.count + ctrl->evq.reserved
+		&& pri_event_queue_grow(ctrl)) {
+		++ctrl->evq.dropped;
+		pri_error(ctrl, "Event queue cannot grow.  Discarding %s event.\n",
+			pri_event2str(e->e));
+		return;
+	}
+	record = &ctrl->evq.records[(ctrl->evq.head + ctrl->evq.count) % ctrl->evq.size];
+	pri_event_copy(&record->ev, &record->subcmds, e);
+	++ctrl->evq.count;
+}
+
+/*!
+ * \brief Indicate that ctrl->ev holds an event for the upper layer.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \note The event is queued right away if the event queue is enabled.
+ * Otherwise, the scheduler or pri_receive_frame() returns the event when
+ * the current timer callback or received frame completes.
+ *
+ * \return Nothing
+ */
+void pri_event_ready(struct pri *ctrl)
+{
+	if (ctrl->evq.records) {
+		pri_event_post(ctrl, &ctrl->ev);
+	} else {
+		ctrl->schedev = 1;
+	}
+}
+
+pri_event *pri_event_next(struct pri *ctrl)
+{
+	if (!ctrl || !ctrl->evq.count) {
+		return NULL;
+	}
+	return &ctrl->evq.records[ctrl->evq.head].ev;
+}
+
+void pri_event_release(struct pri *ctrl)
+{
+	if (!ctrl || !ctrl->evq.count) {
+		return;
+	}
+	ctrl->evq.head = (ctrl->evq.head + 1) % ctrl->evq.size;
+	--ctrl->evq.count;
+	pri_event_retired_free(ctrl);
+}
+
+/*!
+ * \internal
+ * \brief Take all submitted commands off the command queue.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return List of commands in the order submitted.
+ */
+static struct pri_command *pri_command_take(struct pri *ctrl)
+{
+	struct pri_command *pushed;
+	struct pri_command *list;
+	struct pri_command *cmd;
+
+	pushed = __atomic_exchange_n(&ctrl->cmdq.pushed, NULL, __ATOMIC_ACQUIRE);
+
+	/* The submitters push on the front so reverse the list. */
+	list = NULL;
+	while (pushed) {
+		cmd = pushed;
+		pushed = cmd->next;
+		cmd->next = list;
+		list = cmd;
+	}
+	return list;
+}
+
+/*!
+ * \brief Discard any waiting commands and close the command queue wakeup pipe.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return Nothing
+ */
+void pri_command_queue_destroy(struct pri *ctrl)
+{
+	struct pri_command *cmd;
+	struct pri_command *next;
+
+	for (cmd = pri_command_take(ctrl); cmd; cmd = next) {
+		next = cmd->next;
+		free(cmd);
+	}
+	for (cmd = ctrl->cmdq.taken; cmd; cmd = next) {
+		next = cmd->next;
+		free(cmd);
+	}
+	ctrl->cmdq.taken = NULL;
+	if (0 <= ctrl->cmdq.wake[0]) {
+		close(ctrl->cmdq.wake[0]);
+		close(ctrl->cmdq.wake[1]);
+		ctrl->cmdq.wake[0] = -1;
+		ctrl->cmdq.wake[1] = -1;
+	}
+}
+
+int pri_command_queue_enable(struct pri *ctrl, int enable)
+{
+	int wake[2];
+	int idx;
+
+	if (!ctrl) {
+		return -1;
+	}
+	if (!enable) {
+		if (ctrl->cmdq.taken || __atomic_load_n(&ctrl->cmdq.pushed, __ATOMIC_ACQUIRE)) {
+			return -1;
+		}
+		pri_command_queue_destroy(ctrl);
+		return 0;
+	}
+	if (0 <= ctrl->cmdq.wake[0]) {
+		/* Already enabled. */
+		return 0;
+	}
+	if (!ctrl->evq.records) {
+		pri_error(ctrl, "The event queue must be enabled to use the command queue.\n");
+		return -1;
+	}
+	if (pipe(wake)) {
+		pri_error(ctrl, "Could not create command queue pipe: %s\n", strerror(errno));
+		return -1;
+	}
+	for (idx = 0; idx < 2; ++idx) {
+		fcntl(wake[idx], F_SETFL, fcntl(wake[idx], F_GETFL) | O_NONBLOCK);
+		fcntl(wake[idx], F_SETFD, FD_CLOEXEC);
+	}
+	ctrl->cmdq.wake[0] = wake[0];
+	ctrl->cmdq.wake[1] = wake[1];
+	return 0;
+}
+
+int pri_command_fd(struct pri *ctrl)
+{
+	return ctrl ? ctrl->cmdq.wake[0] : -1;
+}
+
+int pri_command_submit(struct pri *ctrl, pri_command_func func, void *data)
+{
+	struct pri_command *cmd;
+	struct pri_command *old;
+	int res;
+
+	if (!ctrl || !func || ctrl->cmdq.wake[1] < 0) {
+		return -1;
+	}
+	cmd = malloc(sizeof(*cmd));
+	if (!cmd) {
+		return -1;
+	}
+	cmd->func = func;
+	cmd->data = data;
+	old = __atomic_load_n(&ctrl->cmdq.pushed, __ATOMIC_RELAXED);
+	do {
+		cmd->next = old;
+	} while (!__atomic_compare_exchange_n(&ctrl->cmdq.pushed, &old, cmd, 0,
+		__ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+	if (!old) {
+		/*
+		 * The queue was empty so the D channel thread may be waiting.
+		 * A full pipe already has a wakeup pending.
+		 */
+		res = write(ctrl->cmdq.wake[1], "", 1);
+		(void) res;
+	}
+	return 0;
+}
+
+pri_event *pri_command_run(struct pri *ctrl)
+{
+	struct pri_command *cmd;
+	struct pri_command *next;
+	struct pri_command **tail;
+	pri_event ev;
+	char drain[64];
+	int res;
+
+	if (!ctrl || ctrl->cmdq.wake[0] < 0) {
+		return pri_event_next(ctrl);
+	}
+
+	/*
+	 * Clear the wakeup before taking the commands.  A command submitted
+	 * after the take finds the queue empty and writes a new wakeup.
+	 */
+	while (0 < read(ctrl->cmdq.wake[0], drain, sizeof(drain))) {
+	}
+
+	/* Commands left waiting for event queue room run first. */
+	for (tail = &ctrl->cmdq.taken; *tail; tail = &(*tail)->next) {
+	}
+	*tail = pri_command_take(ctrl);
+	cmd = ctrl->cmdq.taken;
+	ctrl->cmdq.taken = NULL;
+	if (cmd) {
+		pri_tx_batch_begin(ctrl);
+		for (; cmd; cmd = next) {
+			if (ctrl->evq.size <= ctrl->evq.count) {
+				/*
+				 * No room for the completion event.  Keep the rest of the
+				 * commands until the upper layer releases queued events.
+				 */
+				ctrl->cmdq.taken = cmd;
+				res = write(ctrl->cmdq.wake[1], "", 1);
+				(void) res;
+				break;
+			}
+			next = cmd->next;
+			memset(&ev, 0, sizeof(ev));
+			ev.command_done.e = PRI_EVENT_COMMAND_DONE;
+
+			/* Events posted by the command cannot take the completion record. */
+			ctrl->evq.reserved = 1;
+			ev.command_done.result = cmd->func(ctrl, cmd->data);
+			ctrl->evq.reserved = 0;
+
+			ev.command_done.data = cmd->data;
+			free(cmd);
+			pri_event_post(ctrl, &ev);
+		}
+		pri_tx_batch_end(ctrl);
+	}
+	return pri_event_next(ctrl);
+}
+
 pri_event *pri_dchannel_run(struct pri *pri, int block)
 {
 	pri_event *e;
@@ -837,6 +1455,8 @@ pri_event *pri_dchannel_run(struct pri *pri, int block)
 				return NULL;
 			if (!res)
 				e = pri_schedule_run(pri);
+			else if (res == 2)
+				e = pri_command_run(pri);
 			else
 				e = pri_check_event(pri);
 		} while(!e);
@@ -1462,6 +2082,13 @@ void pri_hangup_fix_enable(struct pri *ctrl, int enable)
 	}
 }
 
+void pri_lazy_ie_decode_enable(struct pri *ctrl, int enable)
+{
+	if (ctrl) {
+		ctrl->lazy_ie_decode = enable ? 1 : 0;
+	}
+}
+
 int pri_hangup(struct pri *pri, q931_call *call, int cause)
 {
 	if (!pri || !pri_is_call_valid(pri, call)) {
@@ -1627,15 +2254,53 @@ void pri_set_error(void (*func)(struct pri *pri, char *stuff))
 	__pri_error = func;
 }
 
+int pri_set_log_sink(struct pri *ctrl, pri_log_cb func, void *userdata, int levels)
+{
+	if (!ctrl) {
+		return -1;
+	}
+	ctrl->log_func = func;
+	ctrl->log_data = userdata;
+	ctrl->log_levels = levels;
+	return 0;
+}
+
+/*!
+ * \internal
+ * \brief Pass formatted output to the controller log sink or the global callbacks.
+ *
+ * \param ctrl D channel controller.  (NULL if not known)
+ * \param level PRI_LOG_ERROR or PRI_LOG_MESSAGE.
+ * \param str Output text.
+ *
+ * \return Nothing
+ */
+static void pri_log_output(struct pri *ctrl, int level, char *str)
+{
+	struct pri *sink;
+
+	sink = pri_log_sink(ctrl);
+	if (sink && sink->log_func) {
+		sink->log_func(ctrl, sink->log_data, level, str);
+	} else if (level == PRI_LOG_ERROR) {
+		if (__pri_error)
+			__pri_error(ctrl, str);
+		else
+			fputs(str, stderr);
+	} else {
+		if (__pri_message)
+			__pri_message(ctrl, str);
+		else
+			fputs(str, stdout);
+	}
+}
+
 static void pri_old_message(struct pri *ctrl, const char *fmt, va_list *ap)
 {
 	char tmp[1024];
 
 	vsnprintf(tmp, sizeof(tmp), fmt, *ap);
-	if (__pri_message)
-		__pri_message(ctrl, tmp);
-	else
-		fputs(tmp, stdout);
+	pri_log_output(ctrl, PRI_LOG_MESSAGE, tmp);
 }
 
 void pri_message(struct pri *ctrl, const char *fmt, ...)
@@ -1643,6 +2308,10 @@ void pri_message(struct pri *ctrl, const char *fmt, ...)
 	int added_length;
 	va_list ap;
 
+	if (!pri_log_wanted(ctrl, PRI_LOG_MESSAGE)) {
+		/* Don't bother formatting output nobody wants. */
+		return;
+	}
 	if (!ctrl || !ctrl->msg_line) {
 		/* Just have to do it the old way. */
 		va_start(ap, fmt);
@@ -1666,11 +2335,7 @@ void pri_message(struct pri *ctrl, const char *fmt, ...)
 		 */
 
 		/* vsnprintf() error or output string was truncated. */
-		if (__pri_message) {
-			__pri_message(ctrl, truncated_output);
-		} else {
-			fputs(truncated_output, stdout);
-		}
+		pri_log_output(ctrl, PRI_LOG_MESSAGE, truncated_output);
 
 		/* Add a terminating '\n' to force a flush of the line. */
 		ctrl->msg_line->length = strlen(ctrl->msg_line->str);
@@ -1688,11 +2353,7 @@ void pri_message(struct pri *ctrl, const char *fmt, ...)
 		&& ctrl->msg_line->str[ctrl->msg_line->length - 1] == '\n') {
 		/* The accumulated output line was terminated so send it out. */
 		ctrl->msg_line->length = 0;
-		if (__pri_message) {
-			__pri_message(ctrl, ctrl->msg_line->str);
-		} else {
-			fputs(ctrl->msg_line->str, stdout);
-		}
+		pri_log_output(ctrl, PRI_LOG_MESSAGE, ctrl->msg_line->str);
 	}
 }
 
@@ -1700,13 +2361,15 @@ void pri_error(struct pri *pri, const char *fmt, ...)
 {
 	char tmp[1024];
 	va_list ap;
+
+	if (!pri_log_wanted(pri, PRI_LOG_ERROR)) {
+		/* Don't bother formatting output nobody wants. */
+		return;
+	}
 	va_start(ap, fmt);
 	vsnprintf(tmp, sizeof(tmp), fmt, ap);
 	va_end(ap);
-	if (__pri_error)
-		__pri_error(pri, tmp);
-	else
-		fputs(tmp, stderr);
+	pri_log_output(pri, PRI_LOG_ERROR, tmp);
 }
 
 /* Set overlap mode */
@@ -1768,13 +2431,11 @@ char *pri_dump_info_str(struct pri *ctrl)
 	char *buf;
 	size_t buf_size;
 	size_t used;
-	struct q921_frame *f;
 	struct q921_link *link;
 	struct pri_cc_record *cc_record;
 	struct q931_call *call;
 	unsigned num_calls;
 	unsigned num_globals;
-	unsigned q921outstanding;
 	unsigned idx;
 	unsigned long switch_bit;
 
@@ -1822,12 +2483,19 @@ char *pri_dump_info_str(struct pri *ctrl)
 	used = pri_snprintf(buf, used, buf_size, "Q921 RX: %d\n", ctrl->q921_rxcount);
 	used = pri_snprintf(buf, used, buf_size, "Q921 TX: %d\n", ctrl->q921_txcount);
 	for (link = &ctrl->link; link; link = link->next) {
-		q921outstanding = 0;
-		for (f = link->tx_queue; f; f = f->next) {
-			++q921outstanding;
-		}
 		used = pri_snprintf(buf, used, buf_size, "Q921 Outstanding: %u (TEI=%d)\n",
-			q921outstanding, link->tei);
+			link->tx_queue_len, link->tei);
+		if (link->frame_pool.slots) {
+			used = pri_snprintf(buf, used, buf_size,
+				"Q921 Frame pool in-use:%u/%u high-water:%u overflow:%u (TEI=%d)\n",
+				link->frame_pool.in_use, link->frame_pool.num_slots,
+				link->frame_pool.high_water, link->frame_pool.overflow, link->tei);
+		}
+	}
+
+	if (ctrl->evq.records) {
+		used = pri_snprintf(buf, used, buf_size, "Event queue: %u/%u dropped:%u\n",
+			ctrl->evq.count, ctrl->evq.size, ctrl->evq.dropped);
 	}
 
 	/* Count the call records in existance.  Useful to check for unreleased calls. */
@@ -1846,6 +2514,10 @@ char *pri_dump_info_str(struct pri *ctrl)
 	}
 	used = pri_snprintf(buf, used, buf_size, "Total active-calls:%u global:%u\n",
 		num_calls, num_globals);
+	used = pri_snprintf(buf, used, buf_size,
+		"Call records in-use:%u free:%u high-water:%u alloc-failures:%u\n",
+		ctrl->callslab->num_used, ctrl->callslab->num_free,
+		ctrl->callslab->high_water, ctrl->callslab->alloc_failures);
 
 	/*
 	 * List simplified call completion records.
@@ -1869,6 +2541,51 @@ char *pri_dump_info_str(struct pri *ctrl)
 	return buf;
 }
 
+int pri_call_pool_prealloc(struct pri *pri, unsigned count)
+{
+	if (!pri) {
+		return -1;
+	}
+	if (count <= pri->callslab->num_free) {
+		/* Already have enough. */
+		return 0;
+	}
+	return q931_call_slab_grow(pri->callslab, count - pri->callslab->num_free);
+}
+
+int pri_call_pool_stats(struct pri *pri, struct pri_call_pool_stats *stats)
+{
+	if (!pri || !stats) {
+		return -1;
+	}
+	stats->in_use = pri->callslab->num_used;
+	stats->available = pri->callslab->num_free;
+	stats->high_water = pri->callslab->high_water;
+	stats->alloc_failures = pri->callslab->alloc_failures;
+	return 0;
+}
+
+int pri_set_iframe_backlog(struct pri *ctrl, int backlog)
+{
+	struct q921_link *link;
+
+	if (!ctrl || backlog < 0) {
+		return -1;
+	}
+	ctrl->iframe_backlog = backlog;
+
+	/* Resize any idle link frame pools when they are next needed. */
+	for (link = &ctrl->link; link; link = link->next) {
+		if (!link->frame_pool.in_use) {
+			free(link->frame_pool.slots);
+			link->frame_pool.slots = NULL;
+			link->frame_pool.free_list = NULL;
+			link->frame_pool.num_slots = 0;
+		}
+	}
+	return 0;
+}
+
 int pri_get_crv(struct pri *pri, q931_call *call, int *callmode)
 {
 	if (!pri || !pri_is_call_valid(pri, call)) {
@@ -1917,6 +2634,8 @@ void pri_enslave(struct pri *master, struct pri *slave)
 	master->nfas = 1;
 	slave->nfas = 1;
 	slave->callpool = &master->localpool;
+	slave->callindex = &master->localindex;
+	slave->callslab = &master->localslab;
 
 	/* Link the slave to the master on the end of the master's list. */
 	slave->master = master;
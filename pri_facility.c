@@ -31,6 +31,7 @@
 #include "libpri.h"
 #include "pri_internal.h"
 #include "pri_facility.h"
+#include "asn1.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -498,6 +499,46 @@ static int presentation_to_subscription(struct pri *ctrl, int presentation)
 	}
 }
 
+/*!
+ * \internal
+ * \brief Copy a decoded ROSE string to a null terminated destination buffer.
+ *
+ * \param ctrl D channel controller that decoded the string.
+ * \param dst Destination buffer.
+ * \param dst_size Size of the destination buffer. (Must be nonzero)
+ * \param str ROSE structure buffer the string was decoded into.
+ * \param length Length of the decoded string.
+ *
+ * \note The string may have been left in the received message.
+ * See asn1_string_view().
+ * \note Like libpri_copy_string(), the copy stops at any embedded null.
+ *
+ * \return Length of the string copied to dst.
+ */
+static size_t rose_copy_string_view(struct pri *ctrl, char *dst, size_t dst_size,
+	const unsigned char *str, size_t length)
+{
+	const unsigned char *view;
+	size_t idx;
+
+	view = asn1_string_view(ctrl, str);
+	if (!view) {
+		libpri_copy_string(dst, (const char *) str, dst_size);
+		return strlen(dst);
+	}
+
+	/* The view is not null terminated. */
+	if (dst_size - 1 < length) {
+		length = dst_size - 1;
+	}
+	for (idx = 0; idx < length && view[idx]; ++idx) {
+		dst[idx] = view[idx];
+	}
+	dst[idx] = '\0';
+
+	return idx;
+}
+
 /*!
  * \brief Copy the given rose party number to the q931_party_number
  *
@@ -513,8 +554,8 @@ void rose_copy_number_to_q931(struct pri *ctrl, struct q931_party_number *q931_n
 	const struct rosePartyNumber *rose_number)
 {
 	//q931_party_number_init(q931_number);
-	libpri_copy_string(q931_number->str, (char *) rose_number->str,
-		sizeof(q931_number->str));
+	rose_copy_string_view(ctrl, q931_number->str, sizeof(q931_number->str),
+		rose_number->str, rose_number->length);
 	q931_number->plan = numbering_plan_for_q931(ctrl, rose_number->plan)
 		| typeofnumber_for_q931(ctrl, rose_number->ton);
 	q931_number->valid = 1;
@@ -535,6 +576,8 @@ void rose_copy_subaddress_to_q931(struct pri *ctrl,
 	struct q931_party_subaddress *q931_subaddress,
 	const struct rosePartySubaddress *rose_subaddress)
 {
+	const unsigned char *view;
+
 	//q931_party_subaddress_init(q931_subaddress);
 	if (!rose_subaddress->length) {
 		/* Subaddress is not present. */
@@ -549,7 +592,9 @@ void rose_copy_subaddress_to_q931(struct pri *ctrl,
 		if (sizeof(q931_subaddress->data) <= q931_subaddress->length) {
 			q931_subaddress->length = sizeof(q931_subaddress->data) - 1;
 		}
-		memcpy(q931_subaddress->data, rose_subaddress->u.user_specified.information,
+		view = asn1_string_view(ctrl, rose_subaddress->u.user_specified.information);
+		memcpy(q931_subaddress->data,
+			view ? view : rose_subaddress->u.user_specified.information,
 			q931_subaddress->length);
 		q931_subaddress->data[q931_subaddress->length] = '\0';
 		if (rose_subaddress->u.user_specified.odd_count_present) {
@@ -560,9 +605,9 @@ void rose_copy_subaddress_to_q931(struct pri *ctrl,
 	case 1:/* NSAP */
 		q931_subaddress->type = 0;/* nsap */
 		q931_subaddress->valid = 1;
-		libpri_copy_string((char *) q931_subaddress->data,
-			(char *) rose_subaddress->u.nsap, sizeof(q931_subaddress->data));
-		q931_subaddress->length = strlen((char *) q931_subaddress->data);
+		q931_subaddress->length = rose_copy_string_view(ctrl,
+			(char *) q931_subaddress->data, sizeof(q931_subaddress->data),
+			rose_subaddress->u.nsap, rose_subaddress->length);
 		break;
 	default:
 		/* Don't know how to encode so assume it is not present. */
@@ -725,7 +770,8 @@ void rose_copy_name_to_q931(struct pri *ctrl, struct q931_party_name *qsig_name,
 	qsig_name->presentation = qsig_name_presentation_for_q931(ctrl,
 		rose_name->presentation);
 	qsig_name->char_set = rose_name->char_set;
-	libpri_copy_string(qsig_name->str, (char *) rose_name->data, sizeof(qsig_name->str));
+	rose_copy_string_view(ctrl, qsig_name->str, sizeof(qsig_name->str), rose_name->data,
+		rose_name->length);
 }
 
 /*!
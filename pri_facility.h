@@ -174,7 +174,7 @@ struct apdu_event {
 	/*! Q.931 call leg.  (Needed for the APDU timeout.) */
 	struct q931_call *call;
 	/*! Response timeout timer. */
-	int timer;
+	pri_sched_id timer;
 	/*! Length of ADPU */
 	int apdu_len;
 	/*! ADPU to send */
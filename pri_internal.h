@@ -32,6 +32,7 @@
 
 #include <stddef.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include "pri_q921.h"
 #include "pri_q931.h"
 
@@ -42,12 +43,20 @@
 
 /* Forward declare some structs */
 struct apdu_event;
+struct asn1_string_views;
 struct pri_cc_record;
+struct rose_dialect;
 
 struct pri_sched {
 	struct timeval when;
 	void (*callback)(void *data);
 	void *data;
+	/*! Position of this timer in the expiration heap. (Valid while active) */
+	unsigned heap_pos;
+	/*! Next free timer slot index. (Valid while on the free list) */
+	unsigned next_free;
+	/*! Generation of the timer id currently using this slot. */
+	unsigned gen;
 };
 
 /*
@@ -63,6 +72,40 @@ struct pri_sched {
 /*! Maximum length of sent display text string.  (No null terminator.) */
 #define MAX_DISPLAY_TEXT	80
 
+/*! Number of call reference hash buckets.  (Must be a power of 2) */
+#define Q931_CALL_HASH_BUCKETS		1024
+/*! Number of call reference values covered by the allocation bitmap. */
+#define Q931_MAX_CALL_REFERENCES	32768
+
+/*! Call pool index to find call records without walking the call pool list. */
+struct q931_call_index {
+	/*! Last call record in the call pool list. */
+	struct q931_call *tail;
+	/*! Call records hashed by call reference value. */
+	struct q931_call *bucket[Q931_CALL_HASH_BUCKETS];
+	/*! Bitmap of our allocated call reference values currently in use. */
+	unsigned long cref_used[Q931_MAX_CALL_REFERENCES / (8 * sizeof(unsigned long))];
+};
+
+/*! Call record slab block of preallocated call records. */
+struct q931_call_slab_block;
+
+/*! Call record slab so call records are reused instead of freed. */
+struct q931_call_slab {
+	/*! Allocated call record slab blocks. */
+	struct q931_call_slab_block *blocks;
+	/*! Free call records ready for reuse. (Linked by the next pointer) */
+	struct q931_call *free_list;
+	/*! Number of call records on the free list. */
+	unsigned num_free;
+	/*! Number of call records in use. */
+	unsigned num_used;
+	/*! Maximum number of call records in use at once. */
+	unsigned high_water;
+	/*! Number of times a call record could not be allocated. */
+	unsigned alloc_failures;
+};
+
 /*! Accumulated pri_message() line until a '\n' is seen on the end. */
 struct pri_msg_line {
 	/*! Accumulated buffer used. */
@@ -71,12 +114,119 @@ struct pri_msg_line {
 	char str[2048];
 };
 
+/*! Maximum number of frames held for one batch write. */
+#define PRI_TX_BATCH_FRAMES	16
+/*! Octets of frame storage held for one batch write. */
+#define PRI_TX_BATCH_SIZE	4096
+
+/*! Frames waiting to be written by the batch write callback. */
+struct pri_tx_batch {
+	/*! Frame copies referenced by iov[]. */
+	unsigned char buf[PRI_TX_BATCH_SIZE];
+	/*! One entry per frame waiting to be written. */
+	struct iovec iov[PRI_TX_BATCH_FRAMES];
+	/*! Number of frames waiting to be written. */
+	int count;
+	/*! Octets of buf[] in use. */
+	size_t used;
+};
+
+/*! Queued upper layer event with its own copy of the event subcommands. */
+struct pri_event_record {
+	pri_event ev;
+	struct pri_subcommands subcmds;
+};
+
+/*! Outgrown event ring kept until the upper layer releases the event it holds. */
+struct pri_event_retired {
+	struct pri_event_retired *next;
+	struct pri_event_record *records;
+};
+
+/*! Ring of events waiting for the upper layer.  (Grows when full) */
+struct pri_event_queue {
+	/*! Ring of event records.  (NULL if the event queue is not enabled) */
+	struct pri_event_record *records;
+	/*! Number of records in the ring. */
+	unsigned size;
+	/*! Index of the oldest queued event. */
+	unsigned head;
+	/*! Number of queued events. */
+	unsigned count;
+	/*! Number of events discarded because the queue could not grow. */
+	unsigned dropped;
+	/*! Number of records held back for a command completion event. */
+	unsigned reserved;
+	/*! Outgrown rings still holding the event last returned by pri_event_next(). */
+	struct pri_event_retired *retired;
+};
+
+/*! Trace ring slot. */
+struct pri_trace_slot {
+	/*! Odd while the record is being written.  (2 * seq + 2 once written) */
+	unsigned long lock;
+	/*! Trace record. */
+	struct pri_trace_record rec;
+};
+
+/*! Binary trace ring of the frames sent and received. */
+struct pri_trace_ring {
+	/*! Ring of trace slots.  (NULL if tracing is not enabled) */
+	struct pri_trace_slot *slots;
+	/*! Number of slots in the ring. */
+	unsigned size;
+	/*! Sequence number of the next record to write. */
+	unsigned long head;
+	/*! Span number put in the trace records. */
+	int span;
+};
+
+/*! Arena the received ROSE components are decoded into. */
+struct rose_arena {
+	/*! Arena memory.  (Allocated on first use) */
+	unsigned char *buf;
+	/*! Number of octets of buf in use. */
+	size_t used;
+};
+
+/*! Command submitted to the D channel thread by another thread. */
+struct pri_command {
+	/*! Next command in the list. */
+	struct pri_command *next;
+	/*! Function to run on the D channel thread. */
+	pri_command_func func;
+	/*! Data pointer passed to func. */
+	void *data;
+};
+
+/*! Lock-free multiple submitter, single runner command queue. */
+struct pri_command_queue {
+	/*! Commands submitted but not yet run, newest first. */
+	struct pri_command *pushed;
+	/*! Commands taken but waiting for event queue room, oldest first. (D channel thread only) */
+	struct pri_command *taken;
+	/*! Wakeup pipe. (read end [0], write end [1], -1 if not enabled) */
+	int wake[2];
+};
+
 /*! \brief D channel controller structure */
 struct pri {
 	int fd;				/* File descriptor for D-Channel */
 	pri_io_cb read_func;		/* Read data callback */
 	pri_io_cb write_func;		/* Write data callback */
+	/*! Batch write callback. (Frames are written by write_func if not set) */
+	pri_io_batch_cb write_batch_func;
+	/*! Frames waiting for the batch write callback. (Allocated when the callback is set) */
+	struct pri_tx_batch *tx_batch;
+	/*! Nesting level of frame batching passes. (Valid in master record only) */
+	int tx_batch_depth;
 	void *userdata;
+	/*! Controller log sink. (NULL if output goes to the pri_set_message()/pri_set_error() callbacks) */
+	pri_log_cb log_func;
+	/*! Data pointer passed to the log sink. */
+	void *log_data;
+	/*! Bitmask of PRI_LOG_xxx levels the log sink wants. */
+	int log_levels;
 	/*! Accumulated pri_message() line. (Valid in master record only) */
 	struct pri_msg_line *msg_line;
 	/*! NFAS master/primary channel if appropriate */
@@ -84,18 +234,40 @@ struct pri {
 	/*! Next NFAS slaved D channel if appropriate */
 	struct pri *slave;
 	struct {
-		/*! Dynamically allocated array of timers that can grow as needed. */
-		struct pri_sched *timer;
-		/*! Numer of timer slots in the allocated array of timers. */
+		/*! Dynamically allocated directory of fixed size timer slot chunks. */
+		struct pri_sched **chunk;
+		/*! Numer of timer slots in the allocated timer chunks. */
 		unsigned num_slots;
-		/*! Maximum timer slots currently needed. */
-		unsigned max_used;
-		/*! First timer id in this timer pool. */
-		unsigned first_id;
+		/*! Binary min-heap of active timer slot indexes ordered by expiration time. */
+		unsigned *heap;
+		/*! Number of active timers in the heap. */
+		unsigned num_active;
+		/*! First timer slot index in the free list. (Oldest freed) */
+		unsigned free_head;
+		/*! Last timer slot index in the free list. (Newest freed) */
+		unsigned free_tail;
+		/*! Timer pool tag identifying this D channel in its timer ids. */
+		unsigned tag;
+		/*! Last current time supplied by pri_schedule_run_tv(). */
+		struct timeval now;
+		/*! TRUE while expired timers run on the supplied now time. */
+		unsigned char now_supplied;
+		/*! Wall clock time of the next timer expiration for pri_schedule_next(). */
+		struct timeval next_wall;
+		/*! Reactor the D channel is registered with. (NULL if none) */
+		struct pri_reactor *reactor;
+		/*! Position of the D channel in the reactor deadline heap. (If it has timers) */
+		unsigned reactor_pos;
 	} sched;
 	int debug;			/* Debug stuff */
 	int state;			/* State of D-channel */
 	int switchtype;		/* Switch type */
+	/*! ROSE conversion tables cached for rose_dialect_switchtype. */
+	const struct rose_dialect *rose_dialect;
+	/*! Switch type the cached ROSE dialect was resolved for. */
+	int rose_dialect_switchtype;
+	/*! Decoded ROSE party strings left in the received message. (NULL if copied) */
+	struct asn1_string_views *rose_string_views;
 	int nsf;		/* Network-Specific Facility (if any) */
 	int localtype;		/* Local network type (unknown, network, cpe) */
 	int remotetype;		/* Remote network type (unknown, network, cpe) */
@@ -117,13 +289,16 @@ struct pri {
 	unsigned int aoc_support:1;/* TRUE if can send AOC events to the upper layer. */
 	unsigned int manual_connect_ack:1;/* TRUE if the CONNECT_ACKNOWLEDGE is sent with API call */
 	unsigned int mcid_support:1;/* TRUE if the upper layer supports MCID */
+	unsigned int lazy_ie_decode:1;/* TRUE if optional ies are only decoded when the message needs them */
 
 	/*! Layer 2 link control for D channel. */
 	struct q921_link link;
 	/*! Layer 2 persistence option. */
 	enum pri_layer2_persistence l2_persistence;
+	/*! Number of I-frame pool buffers each link has beyond the window size K. */
+	int iframe_backlog;
 	/*! T201 TEI Identity Check timer. */
-	int t201_timer;
+	pri_sched_id t201_timer;
 	/*! Number of times T201 has expired. */
 	int t201_expirycnt;
 	
@@ -137,10 +312,24 @@ struct pri {
 	pri_event ev;		/* Static event thingy */
 	/*! Subcommands for static event thingy. */
 	struct pri_subcommands subcmds;
+	/*! Events waiting for the upper layer if the event queue is enabled. */
+	struct pri_event_queue evq;
+	/*! Commands submitted by other threads if the command queue is enabled. */
+	struct pri_command_queue cmdq;
+	/*! Binary trace of the frames sent and received if enabled. */
+	struct pri_trace_ring trace;
+	/*! Decode arena for received ROSE components. */
+	struct rose_arena rose_arena;
 	
 	/* Q.931 calls */
 	struct q931_call **callpool;
 	struct q931_call *localpool;
+	/*! Call pool index. (Points to the NFAS master index) */
+	struct q931_call_index *callindex;
+	struct q931_call_index localindex;
+	/*! Call record slab. (Points to the NFAS master slab) */
+	struct q931_call_slab *callslab;
+	struct q931_call_slab localslab;
 
 	/* q921/q931 packet counters */
 	unsigned int q921_txcount;
@@ -432,6 +621,10 @@ struct q931_call {
 	struct pri *pri;	/* D channel controller (master) */
 	struct q921_link *link;	/* Q.921 link associated with this call. */
 	struct q931_call *next;
+	/*! Previous call in the call pool list. */
+	struct q931_call *prev;
+	/*! Next call in the same call reference hash bucket. */
+	struct q931_call *hash_next;
 	int cr;				/* Call Reference */
 	/* Slotmap specified (bitmap of channels 31/24-1) (Channel Identifier IE) (-1 means not specified) */
 	int slotmap;
@@ -539,7 +732,7 @@ struct q931_call {
 	int complete;			/* no more digits coming */
 	int newcall;			/* if the received message has a new call reference value */
 
-	int retranstimer;		/* Timer for retransmitting DISC */
+	pri_sched_id retranstimer;		/* Timer for retransmitting DISC */
 	int t308_timedout;		/* Whether t308 timed out once */
 
 	struct q931_party_redirecting redirecting;
@@ -549,7 +742,7 @@ struct q931_call {
 	/*! Call hold supplementary state.  Valid on master call record only. */
 	enum Q931_HOLD_STATE hold_state;
 	/*! Call hold event timer.  Valid on master call record only. */
-	int hold_timer;
+	pri_sched_id hold_timer;
 
 	int deflection_in_progress;	/*!< CallDeflection for NT PTMP in progress. */
 	/*! TRUE if the connected number ie was in the current received message. */
@@ -580,10 +773,10 @@ struct q931_call {
 							   -1 - No reverse charging
 							    1 - Reverse charging
 							0,2-7 - Reserved for future use */
-	int t303_timer;
+	pri_sched_id t303_timer;
 	int t303_expirycnt;
-	int t312_timer;
-	int fake_clearing_timer;
+	pri_sched_id t312_timer;
+	pri_sched_id fake_clearing_timer;
 
 	int hangupinitiated;
 	/*! \brief TRUE if we broadcast this call's SETUP message. */
@@ -658,7 +851,7 @@ struct q931_call {
 	/*! Control the RESTART reception to the upper layer. */
 	struct {
 		/*! Timer ID of RESTART notification events to upper layer. */
-		int timer;
+		pri_sched_id timer;
 		/*! Current RESTART notification index. */
 		int idx;
 		/*! Number of channels in the channel ID list. */
@@ -669,7 +862,7 @@ struct q931_call {
 	/*! Control the RESTART retransmissions. */
 	struct {
 		/*! T316 RESTART retransmit timer. */
-		int t316_timer;
+		pri_sched_id t316_timer;
 		/*! Number of times remaining that RESTART can be transmitted. */
 		int remain;
 		/*! Encoded RESTART channel id. */
@@ -817,7 +1010,7 @@ struct pri_cc_record {
 		/*! PTMP FSM parameters. */
 		struct {
 			/*! Extended T_CCBS1 timer id for CCBSStatusRequest handling. */
-			int extended_t_ccbs1;
+			pri_sched_id extended_t_ccbs1;
 			/*! Invoke id for the CCBSStatusRequest message to find if T_CCBS1 still running. */
 			int t_ccbs1_invoke_id;
 			/*! Number of times party A status request got no responses. */
@@ -846,14 +1039,14 @@ struct pri_cc_record {
 	/*! Party A availability status */
 	enum CC_PARTY_A_AVAILABILITY party_a_status;
 	/*! Indirect timer id to abort indirect action events. */
-	int t_indirect;
+	pri_sched_id t_indirect;
 	/*!
 	 * \brief PTMP T_RETENTION timer id.
 	 * \note
 	 * This timer is used by all CC agents to implement
 	 * the Asterisk CC core offer timer.
 	 */
-	int t_retention;
+	pri_sched_id t_retention;
 	/*!
 	 * \brief CC service supervision timer.
 	 *
@@ -864,7 +1057,7 @@ struct pri_cc_record {
 	 * PTP - T_CCBS5/T_CCNR5/T_CCBS6/T_CCNR6,
 	 * Q.SIG - QSIG_CCBS_T2/QSIG_CCNR_T2
 	 */
-	int t_supervision;
+	pri_sched_id t_supervision;
 	/*!
 	 * \brief Party A response to B availability for recall timer.
 	 * \details
@@ -872,7 +1065,7 @@ struct pri_cc_record {
 	 * PTMP - T_CCBS3
 	 * Q.SIG - QSIG_CC_T3
 	 */
-	int t_recall;
+	pri_sched_id t_recall;
 	/*! Invoke id for the cc-request message to find if T_ACTIVATE/QSIG_CC_T1 still running. */
 	int t_activate_invoke_id;
 	/*! Pending response information. */
@@ -943,14 +1136,58 @@ struct link_dummy {
 int q931_is_call_valid(struct pri *ctrl, struct q931_call *call);
 int q931_is_call_valid_gripe(struct pri *ctrl, struct q931_call *call, const char *func_name, unsigned long func_line);
 
-unsigned pri_schedule_event(struct pri *ctrl, int ms, void (*function)(void *data), void *data);
+pri_sched_id pri_schedule_event(struct pri *ctrl, int ms, void (*function)(void *data), void *data);
 
 extern pri_event *pri_schedule_run(struct pri *pri);
 
-void pri_schedule_del(struct pri *ctrl, unsigned id);
-int pri_schedule_check(struct pri *ctrl, unsigned id, void (*function)(void *data), void *data);
+void pri_schedule_del(struct pri *ctrl, pri_sched_id id);
+void pri_schedule_destroy(struct pri *ctrl);
+int pri_schedule_earliest(struct pri *ctrl, struct timeval *when);
+void pri_reactor_deadline_changed(struct pri *ctrl);
+
+int pri_write_frame(struct pri *ctrl, void *buf, int len);
+void pri_tx_batch_begin(struct pri *ctrl);
+void pri_tx_batch_end(struct pri *ctrl);
+int pri_schedule_check(struct pri *ctrl, pri_sched_id id, void (*function)(void *data), void *data);
 
 extern pri_event *pri_mkerror(struct pri *pri, char *errstr);
+struct pri_subcommands **pri_event_subcmds(pri_event *e);
+void pri_event_copy(pri_event *dst, struct pri_subcommands *dst_subcmds, const pri_event *src);
+void pri_event_post(struct pri *ctrl, const pri_event *e);
+void pri_event_ready(struct pri *ctrl);
+void pri_command_queue_destroy(struct pri *ctrl);
+void pri_trace_frame(struct pri *ctrl, const q921_h *h, int len, int direction);
+
+/*!
+ * \brief Get the controller whose log sink gets the output of the controller.
+ *
+ * \param ctrl D channel controller.  (NULL if not known)
+ *
+ * \note An NFAS slave without a log sink of its own uses the master's.
+ *
+ * \return Controller with the log sink or ctrl if none has one.
+ */
+static inline struct pri *pri_log_sink(struct pri *ctrl)
+{
+	if (ctrl && !ctrl->log_func && ctrl->master && ctrl->master->log_func) {
+		return ctrl->master;
+	}
+	return ctrl;
+}
+
+/*!
+ * \brief Determine if output at the given log level is wanted.
+ *
+ * \param ctrl D channel controller.
+ * \param level PRI_LOG_ERROR or PRI_LOG_MESSAGE.
+ *
+ * \retval TRUE if the output is wanted.
+ */
+static inline int pri_log_wanted(struct pri *ctrl, int level)
+{
+	ctrl = pri_log_sink(ctrl);
+	return !ctrl || !ctrl->log_func || (ctrl->log_levels & level);
+}
 
 void pri_message(struct pri *ctrl, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
 void pri_error(struct pri *ctrl, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
@@ -961,6 +1198,8 @@ void pri_link_destroy(struct q921_link *link);
 struct q921_link *pri_link_new(struct pri *ctrl, int sapi, int tei);
 
 void q931_init_call_record(struct q921_link *link, struct q931_call *call, int cr);
+int q931_call_slab_grow(struct q931_call_slab *slab, unsigned count);
+void q931_call_slab_destroy(struct q931_call_slab *slab);
 
 void pri_sr_init(struct pri_sr *req);
 
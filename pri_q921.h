@@ -31,6 +31,7 @@
 #define _PRI_Q921_H
 
 #include <sys/types.h>
+#include <stdint.h>
 #if defined(__linux__)
 #include <endian.h>
 #elif defined(__FreeBSD__)
@@ -40,6 +41,9 @@
 #define __LITTLE_ENDIAN _LITTLE_ENDIAN
 #endif
 
+/*! Scheduled timer event id.  (Zero is never a valid timer id.) */
+typedef uint64_t pri_sched_id;
+
 /* Timer values */
 
 #define T_WAIT_MIN	2000
@@ -173,9 +177,34 @@ typedef struct q921_frame {
 	struct q921_frame *next;			/*!< Next in list */
 	int len;							/*!< Length of header + body */
 	enum q921_tx_frame_status status;	/*!< Tx frame status */
+	unsigned int pooled:1;				/*!< TRUE if the frame came from the link frame pool */
 	q921_i h;							/*!< Actual frame contents. */
 } q921_frame;
 
+/*!
+ * Largest I-frame information field a frame pool slot holds.
+ * (Room for typical Q.931 messages.  Longer ones are heap allocated.)
+ */
+#define Q921_FRAME_POOL_DATA_SIZE	512
+/*! Default number of I-frames the frame pool holds beyond the window size K. */
+#define Q921_FRAME_POOL_BACKLOG	16
+
+/*! Preallocated I-frame buffers for a Q.921 link retransmission queue. */
+struct q921_frame_pool {
+	/*! Single allocation holding all pool slots. (NULL until first needed) */
+	void *slots;
+	/*! List of unused pool slots. */
+	struct q921_frame *free_list;
+	/*! Number of slots in the pool. */
+	unsigned num_slots;
+	/*! Number of pool slots currently queued. */
+	unsigned in_use;
+	/*! Most pool slots ever queued at the same time. */
+	unsigned high_water;
+	/*! Number of I-frames that had to be heap allocated instead. */
+	unsigned overflow;
+};
+
 #define Q921_INC(j) (j) = (((j) + 1) % 128)
 #define Q921_DEC(j) (j) = (((j) - 1) % 128)
 
@@ -221,6 +250,14 @@ struct q921_link {
 
 	/*! Q.921 Re-transmission queue */
 	struct q921_frame *tx_queue;
+	/*! Last frame in the re-transmission queue. */
+	struct q921_frame *tx_queue_tail;
+	/*! First frame in the re-transmission queue not yet sent. (Frames before it are sent) */
+	struct q921_frame *tx_pending;
+	/*! Number of frames in the re-transmission queue. */
+	unsigned tx_queue_len;
+	/*! Buffers for the re-transmission queue frames. */
+	struct q921_frame_pool frame_pool;
 
 	/*! Q.921 State */
 	enum q921_state state;
@@ -245,18 +282,18 @@ struct q921_link {
 	/* Various timers */
 
 	/*! T-200 retransmission timer */
-	int t200_timer;
+	pri_sched_id t200_timer;
 	/*! Retry Count (T200) */
 	int RC;
-	int t202_timer;
+	pri_sched_id t202_timer;
 	int n202_counter;
 	/*! Max idle time */
-	int t203_timer;
+	pri_sched_id t203_timer;
 	/*! Layer 2 persistence restart delay timer */
-	int restart_timer;
+	pri_sched_id restart_timer;
 
 	/* MDL variables */
-	int mdl_timer;
+	pri_sched_id mdl_timer;
 	int mdl_error;
 	unsigned int mdl_free_me:1;
 
@@ -272,6 +309,9 @@ static inline int Q921_ADD(int a, int b)
 	return (a + b) % 128;
 }
 
+/*! q921_dump() debugflags bit: The frame is not live so skip the link state. */
+#define Q921_DUMP_NO_LINK_STATE	(1 << 30)
+
 /* Dumps a *known good* Q.921 packet */
 extern void q921_dump(struct pri *pri, q921_h *h, int len, int debugflags, int txrx);
 
@@ -285,6 +325,12 @@ extern pri_event *q921_receive(struct pri *pri, q921_h *h, int len);
 
 int q921_transmit_iframe(struct q921_link *link, void *buf, int len, int cr);
 
+struct q921_frame *q921_iframe_lease(struct q921_link *link);
+void q921_iframe_lease_release(struct q921_link *link, struct q921_frame *f);
+int q921_transmit_leased_iframe(struct q921_link *link, struct q921_frame *f, int len, int cr);
+
+void q921_frame_pool_destroy(struct q921_link *link);
+
 int q921_transmit_uiframe(struct q921_link *link, void *buf, int len);
 
 extern pri_event *q921_dchannel_up(struct pri *pri);
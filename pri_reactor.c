@@ -0,0 +1,554 @@
+/*
+ * libpri: An implementation of Primary Rate ISDN
+ *
+ * See http://www.asterisk.org for more information about
+ * the Asterisk project. Please do not directly contact
+ * any of the maintainers of this project for assistance;
+ * the project provides a web site, mailing lists and IRC
+ * channels for your use.
+ *
+ * This program is free software, distributed under the terms of
+ * the GNU General Public License Version 2 as published by the
+ * Free Software Foundation. See the LICENSE file included with
+ * this program for more details.
+ *
+ * In addition, when this program is distributed with Asterisk in
+ * any form that would qualify as a 'combined work' or as a
+ * 'derivative work' (but not mere aggregation), you can redistribute
+ * and/or modify the combination under the terms of the license
+ * provided with that copy of Asterisk, instead of the license
+ * terms granted here.
+ */
+
+
+/*!
+ * \file
+ * \brief Event loop serving several D channel controllers from one thread.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libpri.h"
+#include "pri_internal.h"
+
+#if defined(__linux__)
+
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+/*! Maximum number of ready file descriptors collected by one epoll_wait(). */
+#define PRI_REACTOR_READY_MAX	64
+
+/*!
+ * The command queue wakeup of a controller is identified by the
+ * controller pointer with the low bit set.
+ */
+#define PRI_REACTOR_CMD_TAG		((uintptr_t) 1)
+
+/*! Deadline heap position of a controller without active timers. */
+#define PRI_REACTOR_NO_DEADLINE	((unsigned) -1)
+
+/*! Earliest timer deadline of a registered controller. */
+struct pri_reactor_deadline {
+	/*! Scheduler clock expiration time of the earliest timer. */
+	struct timeval when;
+	/*! Controller the deadline belongs to. */
+	struct pri *ctrl;
+};
+
+struct pri_reactor {
+	/*! epoll file descriptor covering every D channel and the timer. */
+	int epfd;
+	/*! timerfd armed for the earliest timer deadline of all controllers. */
+	int tfd;
+	/*! Registered D channel controllers. */
+	struct pri **ctrls;
+	/*! Number of registered controllers. */
+	unsigned num_ctrls;
+	/*! Number of entries allocated in ctrls[]. */
+	unsigned max_ctrls;
+	/*! Binary min-heap of the controllers with active timers ordered by deadline. */
+	struct pri_reactor_deadline *deadlines;
+	/*! Number of controllers in the deadline heap. */
+	unsigned num_deadlines;
+	/*! TRUE if the earliest deadline changed since the timerfd was armed. */
+	int rearm;
+	/*! TRUE if expired timers still need to be run. */
+	int timers_pending;
+	/*! Scheduler clock time the timerfd expired. */
+	struct timeval expired;
+	/*! Controller to return queued events of before doing anything else. */
+	struct pri *drain;
+	/*! Ready file descriptors from the last epoll_wait(). */
+	struct epoll_event ready[PRI_REACTOR_READY_MAX];
+	/*! Number of entries in ready[]. */
+	int num_ready;
+	/*! Next entry of ready[] to process. */
+	int next_ready;
+};
+
+struct pri_reactor *pri_reactor_new(void)
+{
+	struct pri_reactor *reactor;
+	struct epoll_event ev;
+
+	reactor = calloc(1, sizeof(*reactor));
+	if (!reactor) {
+		return NULL;
+	}
+	reactor->epfd = epoll_create1(EPOLL_CLOEXEC);
+	reactor->tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (reactor->epfd < 0 || reactor->tfd < 0) {
+		goto fail;
+	}
+
+	/* The timerfd is identified by a NULL data pointer. */
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.ptr = NULL;
+	if (epoll_ctl(reactor->epfd, EPOLL_CTL_ADD, reactor->tfd, &ev)) {
+		goto fail;
+	}
+	return reactor;
+
+fail:
+	if (0 <= reactor->epfd) {
+		close(reactor->epfd);
+	}
+	if (0 <= reactor->tfd) {
+		close(reactor->tfd);
+	}
+	free(reactor);
+	return NULL;
+}
+
+void pri_reactor_destroy(struct pri_reactor *reactor)
+{
+	unsigned idx;
+
+	if (!reactor) {
+		return;
+	}
+	for (idx = 0; idx < reactor->num_ctrls; ++idx) {
+		reactor->ctrls[idx]->sched.reactor = NULL;
+	}
+	close(reactor->epfd);
+	close(reactor->tfd);
+	free(reactor->deadlines);
+	free(reactor->ctrls);
+	free(reactor);
+}
+
+/*!
+ * \internal
+ * \brief Determine if the left deadline is before the right deadline.
+ *
+ * \param left Left deadline time.
+ * \param right Right deadline time.
+ *
+ * \return TRUE if left is before right.
+ */
+static inline int pri_reactor_before(const struct timeval *left, const struct timeval *right)
+{
+	return left->tv_sec < right->tv_sec
+		|| (left->tv_sec == right->tv_sec && left->tv_usec < right->tv_usec);
+}
+
+/*!
+ * \internal
+ * \brief Put the given deadline at the given heap position.
+ *
+ * \param reactor Reactor to update.
+ * \param pos Heap position to fill.
+ * \param deadline Controller deadline to put there.
+ *
+ * \return Nothing
+ */
+static inline void pri_reactor_heap_set(struct pri_reactor *reactor, unsigned pos,
+	const struct pri_reactor_deadline *deadline)
+{
+	reactor->deadlines[pos] = *deadline;
+	deadline->ctrl->sched.reactor_pos = pos;
+}
+
+/*!
+ * \internal
+ * \brief Move the deadline at the given heap position to where it belongs.
+ *
+ * \param reactor Reactor to update.
+ * \param pos Heap position of the deadline to sift.
+ *
+ * \return Nothing
+ */
+static void pri_reactor_heap_sift(struct pri_reactor *reactor, unsigned pos)
+{
+	struct pri_reactor_deadline deadline;
+	unsigned parent;
+	unsigned child;
+
+	deadline = reactor->deadlines[pos];
+
+	/* Toward the root */
+	while (pos) {
+		parent = (pos - 1) / 2;
+		if (!pri_reactor_before(&deadline.when, &reactor->deadlines[parent].when)) {
+			break;
+		}
+		pri_reactor_heap_set(reactor, pos, &reactor->deadlines[parent]);
+		pos = parent;
+	}
+
+	/* Toward the leaves */
+	for (;;) {
+		child = 2 * pos + 1;
+		if (reactor->num_deadlines <= child) {
+			break;
+		}
+		if (child + 1 < reactor->num_deadlines
+			&& pri_reactor_before(&reactor->deadlines[child + 1].when,
+				&reactor->deadlines[child].when)) {
+			++child;
+		}
+		if (!pri_reactor_before(&reactor->deadlines[child].when, &deadline.when)) {
+			break;
+		}
+		pri_reactor_heap_set(reactor, pos, &reactor->deadlines[child]);
+		pos = child;
+	}
+	pri_reactor_heap_set(reactor, pos, &deadline);
+}
+
+/*!
+ * \internal
+ * \brief Remove the controller from the deadline heap.
+ *
+ * \param reactor Reactor to update.
+ * \param ctrl D channel controller.
+ *
+ * \return Nothing
+ */
+static void pri_reactor_heap_remove(struct pri_reactor *reactor, struct pri *ctrl)
+{
+	unsigned pos;
+	unsigned last;
+
+	pos = ctrl->sched.reactor_pos;
+	if (pos == PRI_REACTOR_NO_DEADLINE) {
+		return;
+	}
+	ctrl->sched.reactor_pos = PRI_REACTOR_NO_DEADLINE;
+	if (!pos) {
+		reactor->rearm = 1;
+	}
+	last = --reactor->num_deadlines;
+	if (pos != last) {
+		/* Fill the hole with the last heap entry and restore the heap order. */
+		pri_reactor_heap_set(reactor, pos, &reactor->deadlines[last]);
+		pri_reactor_heap_sift(reactor, pos);
+	}
+}
+
+/*!
+ * \brief Update the reactor deadline of the controller.
+ *
+ * \param ctrl D channel controller whose earliest timer changed.
+ *
+ * \note Called by the scheduler only when the earliest timer of a
+ * controller registered with a reactor changes.
+ *
+ * \return Nothing
+ */
+void pri_reactor_deadline_changed(struct pri *ctrl)
+{
+	struct pri_reactor *reactor;
+	struct pri_reactor_deadline deadline;
+	unsigned pos;
+
+	reactor = ctrl->sched.reactor;
+	if (pri_schedule_earliest(ctrl, &deadline.when)) {
+		/* The controller has no active timers. */
+		pri_reactor_heap_remove(reactor, ctrl);
+		return;
+	}
+	deadline.ctrl = ctrl;
+	pos = ctrl->sched.reactor_pos;
+	if (pos == PRI_REACTOR_NO_DEADLINE) {
+		pos = reactor->num_deadlines++;
+	}
+	if (!pos) {
+		/* The earliest deadline itself changed. */
+		reactor->rearm = 1;
+	}
+	pri_reactor_heap_set(reactor, pos, &deadline);
+	pri_reactor_heap_sift(reactor, pos);
+	if (!ctrl->sched.reactor_pos) {
+		/* The controller now has the earliest deadline. */
+		reactor->rearm = 1;
+	}
+}
+
+int pri_reactor_add(struct pri_reactor *reactor, struct pri *ctrl)
+{
+	struct epoll_event ev;
+	struct pri **ctrls;
+	struct pri_reactor_deadline *deadlines;
+	unsigned max_ctrls;
+
+	if (!reactor || !ctrl || ctrl->fd < 0 || ctrl->sched.reactor) {
+		return -1;
+	}
+	if (reactor->num_ctrls == reactor->max_ctrls) {
+		max_ctrls = reactor->max_ctrls ? reactor->max_ctrls * 2 : 8;
+		ctrls = realloc(reactor->ctrls, max_ctrls * sizeof(*ctrls));
+		if (!ctrls) {
+			return -1;
+		}
+		reactor->ctrls = ctrls;
+		deadlines = realloc(reactor->deadlines, max_ctrls * sizeof(*deadlines));
+		if (!deadlines) {
+			return -1;
+		}
+		reactor->deadlines = deadlines;
+		reactor->max_ctrls = max_ctrls;
+	}
+
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.ptr = ctrl;
+	if (epoll_ctl(reactor->epfd, EPOLL_CTL_ADD, ctrl->fd, &ev)) {
+		pri_error(ctrl, "Could not add D channel fd %d to the reactor: %s\n",
+			ctrl->fd, strerror(errno));
+		return -1;
+	}
+	if (0 <= ctrl->cmdq.wake[0]) {
+		/* Also run the commands submitted by other threads. */
+		ev.data.ptr = (void *) ((uintptr_t) ctrl | PRI_REACTOR_CMD_TAG);
+		if (epoll_ctl(reactor->epfd, EPOLL_CTL_ADD, ctrl->cmdq.wake[0], &ev)) {
+			pri_error(ctrl, "Could not add command queue fd %d to the reactor: %s\n",
+				ctrl->cmdq.wake[0], strerror(errno));
+			epoll_ctl(reactor->epfd, EPOLL_CTL_DEL, ctrl->fd, NULL);
+			return -1;
+		}
+	}
+	reactor->ctrls[reactor->num_ctrls++] = ctrl;
+
+	/* Track the earliest timer of the controller from now on. */
+	ctrl->sched.reactor = reactor;
+	ctrl->sched.reactor_pos = PRI_REACTOR_NO_DEADLINE;
+	pri_reactor_deadline_changed(ctrl);
+	return 0;
+}
+
+int pri_reactor_remove(struct pri_reactor *reactor, struct pri *ctrl)
+{
+	unsigned idx;
+	int x;
+
+	if (!reactor || !ctrl || ctrl->sched.reactor != reactor) {
+		return -1;
+	}
+	for (idx = 0; idx < reactor->num_ctrls; ++idx) {
+		if (reactor->ctrls[idx] == ctrl) {
+			break;
+		}
+	}
+	if (idx == reactor->num_ctrls) {
+		/* Not registered. */
+		return -1;
+	}
+	epoll_ctl(reactor->epfd, EPOLL_CTL_DEL, ctrl->fd, NULL);
+	if (0 <= ctrl->cmdq.wake[0]) {
+		epoll_ctl(reactor->epfd, EPOLL_CTL_DEL, ctrl->cmdq.wake[0], NULL);
+	}
+
+	pri_reactor_heap_remove(reactor, ctrl);
+	ctrl->sched.reactor = NULL;
+	reactor->ctrls[idx] = reactor->ctrls[--reactor->num_ctrls];
+	if (reactor->drain == ctrl) {
+		reactor->drain = NULL;
+	}
+
+	/* Forget any readiness already collected for the controller. */
+	for (x = reactor->next_ready; x < reactor->num_ready; ++x) {
+		if (((uintptr_t) reactor->ready[x].data.ptr & ~PRI_REACTOR_CMD_TAG)
+			== (uintptr_t) ctrl) {
+			reactor->ready[x].data.ptr = reactor;
+		}
+	}
+	return 0;
+}
+
+int pri_reactor_fd(struct pri_reactor *reactor)
+{
+	return reactor ? reactor->epfd : -1;
+}
+
+/*!
+ * \internal
+ * \brief Arm the timerfd for the earliest timer deadline of all controllers.
+ *
+ * \param reactor Reactor to update.
+ *
+ * \note The timerfd is only rearmed if the earliest deadline changed.
+ *
+ * \return Nothing
+ */
+static void pri_reactor_arm_timer(struct pri_reactor *reactor)
+{
+	struct itimerspec spec;
+
+	if (!reactor->rearm) {
+		return;
+	}
+	reactor->rearm = 0;
+
+	/* The scheduler clock is CLOCK_MONOTONIC like the timerfd. */
+	memset(&spec, 0, sizeof(spec));
+	if (reactor->num_deadlines) {
+		spec.it_value.tv_sec = reactor->deadlines[0].when.tv_sec;
+		spec.it_value.tv_nsec = reactor->deadlines[0].when.tv_usec * 1000;
+		if (!spec.it_value.tv_sec && !spec.it_value.tv_nsec) {
+			spec.it_value.tv_nsec = 1;
+		}
+	}
+	/* An all zero spec disarms the timer when no timers are active. */
+	timerfd_settime(reactor->tfd, TFD_TIMER_ABSTIME, &spec, NULL);
+}
+
+pri_event *pri_reactor_run(struct pri_reactor *reactor, int timeout_ms, struct pri **pri)
+{
+	struct pri *ctrl;
+	pri_event *e;
+	void *ptr;
+	uint64_t expirations;
+	int waited;
+	int res;
+
+	if (!reactor) {
+		return NULL;
+	}
+	if (reactor->drain) {
+		/* Return the events still queued by the last controller first. */
+		e = pri_event_next(reactor->drain);
+		if (e) {
+			if (pri) {
+				*pri = reactor->drain;
+			}
+			return e;
+		}
+		reactor->drain = NULL;
+	}
+	waited = 0;
+	for (;;) {
+		/* Finish running expired timers first. */
+		if (reactor->timers_pending) {
+			while (reactor->num_deadlines
+				&& !pri_reactor_before(&reactor->expired, &reactor->deadlines[0].when)) {
+				/* Running the timers moves the controller deadline. */
+				ctrl = reactor->deadlines[0].ctrl;
+				e = pri_schedule_run(ctrl);
+				if (e) {
+					/* The controller may have more expired timers. */
+					reactor->drain = ctrl;
+					if (pri) {
+						*pri = ctrl;
+					}
+					return e;
+				}
+			}
+			reactor->timers_pending = 0;
+		}
+
+		/* Process the file descriptors found ready by the last wait. */
+		while (reactor->next_ready < reactor->num_ready) {
+			ptr = reactor->ready[reactor->next_ready++].data.ptr;
+			ctrl = (struct pri *) ((uintptr_t) ptr & ~PRI_REACTOR_CMD_TAG);
+			if (!ctrl) {
+				/* The timerfd expired. */
+				res = read(reactor->tfd, &expirations, sizeof(expirations));
+				pri_schedule_now(&reactor->expired);
+				reactor->timers_pending = 1;
+				reactor->rearm = 1;
+				break;
+			}
+			if (ctrl == (struct pri *) reactor) {
+				/* Controller removed since the wait. */
+				continue;
+			}
+			if ((uintptr_t) ptr & PRI_REACTOR_CMD_TAG) {
+				e = pri_command_run(ctrl);
+			} else {
+				e = pri_check_event(ctrl);
+			}
+			if (e) {
+				/* The frame may have queued more events. */
+				reactor->drain = ctrl;
+				if (pri) {
+					*pri = ctrl;
+				}
+				return e;
+			}
+		}
+		if (reactor->timers_pending) {
+			continue;
+		}
+
+		if (waited && 0 <= timeout_ms) {
+			/* Only wait once when a timeout is given. */
+			return NULL;
+		}
+		pri_reactor_arm_timer(reactor);
+		res = epoll_wait(reactor->epfd, reactor->ready, PRI_REACTOR_READY_MAX, timeout_ms);
+		if (res < 0) {
+			/* Error or interruption */
+			return NULL;
+		}
+		reactor->num_ready = res;
+		reactor->next_ready = 0;
+		waited = 1;
+	}
+}
+
+#else	/* !defined(__linux__) */
+
+/* The reactor needs epoll and timerfd. */
+
+struct pri_reactor *pri_reactor_new(void)
+{
+	errno = ENOSYS;
+	return NULL;
+}
+
+void pri_reactor_destroy(struct pri_reactor *reactor)
+{
+}
+
+int pri_reactor_add(struct pri_reactor *reactor, struct pri *ctrl)
+{
+	return -1;
+}
+
+int pri_reactor_remove(struct pri_reactor *reactor, struct pri *ctrl)
+{
+	return -1;
+}
+
+int pri_reactor_fd(struct pri_reactor *reactor)
+{
+	return -1;
+}
+
+void pri_reactor_deadline_changed(struct pri *ctrl)
+{
+}
+
+pri_event *pri_reactor_run(struct pri_reactor *reactor, int timeout_ms, struct pri **pri)
+{
+	return NULL;
+}
+
+#endif	/* !defined(__linux__) */
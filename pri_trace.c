@@ -0,0 +1,215 @@
+/*
+ * libpri: An implementation of Primary Rate ISDN
+ *
+ * See http://www.asterisk.org for more information about
+ * the Asterisk project. Please do not directly contact
+ * any of the maintainers of this project for assistance;
+ * the project provides a web site, mailing lists and IRC
+ * channels for your use.
+ *
+ * This program is free software, distributed under the terms of
+ * the GNU General Public License Version 2 as published by the
+ * Free Software Foundation. See the LICENSE file included with
+ * this program for more details.
+ *
+ * In addition, when this program is distributed with Asterisk in
+ * any form that would qualify as a 'combined work' or as a
+ * 'derivative work' (but not mere aggregation), you can redistribute
+ * and/or modify the combination under the terms of the license
+ * provided with that copy of Asterisk, instead of the license
+ * terms granted here.
+ */
+
+
+/*!
+ * \file
+ * \brief Binary trace ring of the frames sent and received on a D channel.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "compat.h"
+#include "libpri.h"
+#include "pri_internal.h"
+#include "pri_q921.h"
+#include "pri_q931.h"
+
+int pri_trace_enable(struct pri *ctrl, unsigned size, int span)
+{
+	struct pri_trace_slot *slots;
+
+	if (!ctrl) {
+		return -1;
+	}
+	if (!size) {
+		free(ctrl->trace.slots);
+		ctrl->trace.slots = NULL;
+		ctrl->trace.size = 0;
+		ctrl->trace.head = 0;
+		return 0;
+	}
+	slots = calloc(size, sizeof(*slots));
+	if (!slots) {
+		return -1;
+	}
+	free(ctrl->trace.slots);
+	ctrl->trace.slots = slots;
+	ctrl->trace.size = size;
+	ctrl->trace.head = 0;
+	ctrl->trace.span = span;
+	return 0;
+}
+
+/*!
+ * \internal
+ * \brief Fill in the Q.931 call reference and message type of a trace record.
+ *
+ * \param rec Trace record to fill in.
+ * \param msg Start of the layer 3 message.
+ * \param len Length of the layer 3 message.
+ *
+ * \return Nothing
+ */
+static void pri_trace_q931(struct pri_trace_record *rec, const unsigned char *msg, int len)
+{
+	int crlen;
+	int idx;
+
+	if (len < 3) {
+		return;
+	}
+	crlen = msg[1] & 0x0f;
+	if (2 < crlen || len < 3 + crlen) {
+		return;
+	}
+	rec->cref = 0;
+	for (idx = 0; idx < crlen; ++idx) {
+		rec->cref = (rec->cref << 8) | msg[2 + idx];
+	}
+	rec->msgtype = msg[2 + crlen];
+}
+
+/*!
+ * \brief Record a frame in the controller trace ring.
+ *
+ * \param ctrl D channel controller.  (Its trace ring must be enabled)
+ * \param h Q.921 frame.
+ * \param len Length of the frame without the FCS.
+ * \param direction PRI_TRACE_TX or PRI_TRACE_RX.
+ *
+ * \note The oldest record is overwritten when the ring is full.
+ *
+ * \return Nothing
+ */
+void pri_trace_frame(struct pri *ctrl, const q921_h *h, int len, int direction)
+{
+	struct pri_trace_ring *ring;
+	struct pri_trace_slot *slot;
+	struct pri_trace_record *rec;
+	struct timeval now;
+	unsigned long seq;
+
+	ring = &ctrl->trace;
+	seq = ring->head;
+	slot = &ring->slots[seq % ring->size];
+
+	/* Mark the slot as being written for any concurrent reader. */
+	__atomic_store_n(&slot->lock, seq * 2 + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	rec = &slot->rec;
+	gettimeofday(&now, NULL);
+	rec->seq = seq;
+	rec->tv_sec = now.tv_sec;
+	rec->tv_usec = now.tv_usec;
+	rec->span = ring->span;
+	rec->direction = direction;
+	rec->len = len;
+	rec->caplen = (len < PRI_TRACE_FRAME_MAX) ? len : PRI_TRACE_FRAME_MAX;
+	memcpy(rec->frame, h, rec->caplen);
+	rec->cref = -1;
+	rec->msgtype = -1;
+	if (2 <= len) {
+		rec->sapi = h->h.sapi;
+		rec->tei = h->h.tei;
+		if (h->h.sapi == Q921_SAPI_CALL_CTRL) {
+			if ((h->h.data[0] & 0x01) == Q921_FRAMETYPE_I && 4 <= rec->caplen) {
+				pri_trace_q931(rec, rec->frame + 4, rec->caplen - 4);
+			} else if ((h->h.data[0] & Q921_FRAMETYPE_MASK) == Q921_FRAMETYPE_U
+				&& 3 <= rec->caplen && h->u.m3 == 0 && h->u.m2 == 0) {
+				/* UI frame */
+				pri_trace_q931(rec, rec->frame + 3, rec->caplen - 3);
+			}
+		}
+	} else {
+		rec->sapi = -1;
+		rec->tei = -1;
+	}
+
+	__atomic_store_n(&slot->lock, seq * 2 + 2, __ATOMIC_RELEASE);
+	__atomic_store_n(&ring->head, seq + 1, __ATOMIC_RELEASE);
+}
+
+int pri_trace_read(struct pri *ctrl, unsigned long *cursor, struct pri_trace_record *record)
+{
+	struct pri_trace_ring *ring;
+	struct pri_trace_slot *slot;
+	unsigned long head;
+	unsigned long lock;
+
+	if (!ctrl || !cursor || !record || !ctrl->trace.slots) {
+		return -1;
+	}
+	ring = &ctrl->trace;
+	for (;;) {
+		head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+		if (head <= *cursor) {
+			return 0;
+		}
+		if (ring->size < head - *cursor) {
+			/* The wanted records were already overwritten. */
+			*cursor = head - ring->size;
+		}
+		slot = &ring->slots[*cursor % ring->size];
+		lock = __atomic_load_n(&slot->lock, __ATOMIC_ACQUIRE);
+		if (lock == *cursor * 2 + 2) {
+			memcpy(record, &slot->rec, sizeof(*record));
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			if (__atomic_load_n(&slot->lock, __ATOMIC_RELAXED) == lock) {
+				++*cursor;
+				return 1;
+			}
+		}
+		/* The record is being overwritten.  Skip it. */
+		++*cursor;
+	}
+}
+
+void pri_trace_dump(struct pri *ctrl, const struct pri_trace_record *record)
+{
+	q921_h *h;
+	int txrx;
+
+	if (!ctrl || !record || record->caplen < 2) {
+		return;
+	}
+	txrx = (record->direction == PRI_TRACE_TX);
+	pri_message(ctrl, "\n-- Trace #%lu %ld.%06ld span %d%s\n", record->seq,
+		record->tv_sec, record->tv_usec, record->span,
+		(record->caplen < record->len) ? " (truncated)" : "");
+
+	h = (q921_h *) record->frame;
+	q921_dump(ctrl, h, record->caplen,
+		PRI_DEBUG_Q921_DUMP | PRI_DEBUG_Q921_RAW | Q921_DUMP_NO_LINK_STATE, txrx);
+	if (0 <= record->msgtype) {
+		if ((h->h.data[0] & 0x01) == Q921_FRAMETYPE_I) {
+			q931_dump(ctrl, record->tei, (q931_h *) h->i.data, record->caplen - 4, txrx);
+		} else {
+			q931_dump(ctrl, record->tei, (q931_h *) h->u.data, record->caplen - 3, txrx);
+		}
+	}
+}
@@ -30,90 +30,372 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "libpri.h"
 #include "pri_internal.h"
 
 
-/*! Initial number of scheduled timer slots. */
-#define SCHED_EVENTS_INITIAL	128
-/*!
- * \brief Maximum number of scheduled timer slots.
- * \note Should be a power of 2 and at least SCHED_EVENTS_INITIAL.
+/*! Number of timer slots in each allocated chunk.  (Must be a power of 2) */
+#define SCHED_CHUNK_SLOTS		128
+
+/*
+ * Timer id layout: | pool tag | slot generation | slot index |
+ *
+ * The pool tag identifies which D channel started the timer so an NFAS
+ * group can find it.  The generation detects stale ids of timers that
+ * already expired or were deleted before the slot got reused.
  */
-#define SCHED_EVENTS_MAX		8192
+/*! Number of timer id bits holding the timer slot index. */
+#define SCHED_ID_SLOT_BITS		24
+/*! Number of timer id bits holding the timer slot generation. */
+#define SCHED_ID_GEN_BITS		20
+/*! Number of timer id bits holding the timer pool tag. */
+#define SCHED_ID_TAG_BITS		(64 - SCHED_ID_SLOT_BITS - SCHED_ID_GEN_BITS)
+
+#define SCHED_ID_SLOT_MASK		((1U << SCHED_ID_SLOT_BITS) - 1)
+#define SCHED_ID_GEN_MASK		((1U << SCHED_ID_GEN_BITS) - 1)
+#define SCHED_ID_TAG_MASK		((1U << SCHED_ID_TAG_BITS) - 1)
+
+/*! Maximum number of scheduled timer slots a D channel can have. */
+#define SCHED_EVENTS_MAX		(SCHED_ID_SLOT_MASK + 1)
+
+/*! Free list terminator.  (Never a valid timer slot index.) */
+#define SCHED_NO_SLOT			((unsigned) -1)
 
 /*! \brief The maximum number of timers that were active at once. */
 static unsigned maxsched = 0;
-/*! Last pool id */
-static unsigned pool_id = 0;
+/*! Last timer pool tag allocated.  (Shared by all threads) */
+static unsigned sched_last_tag = 0;
 
 /* Scheduler routines */
 
+/*!
+ * \internal
+ * \brief Determine if the left timer expires before the right timer.
+ *
+ * \param left Expiration time of the left timer.
+ * \param right Expiration time of the right timer.
+ *
+ * \return TRUE if left expires before right.
+ */
+static inline int pri_sched_before(const struct timeval *left, const struct timeval *right)
+{
+	return left->tv_sec < right->tv_sec
+		|| (left->tv_sec == right->tv_sec && left->tv_usec < right->tv_usec);
+}
+
+/*!
+ * \brief Get the current time of the clock the scheduler runs on.
+ *
+ * \param now Filled with the current time.
+ *
+ * \return Nothing
+ */
+void pri_schedule_now(struct timeval *now)
+{
+#if defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	if (!clock_gettime(CLOCK_MONOTONIC, &ts)) {
+		now->tv_sec = ts.tv_sec;
+		now->tv_usec = ts.tv_nsec / 1000;
+		return;
+	}
+#endif	/* defined(CLOCK_MONOTONIC) */
+	gettimeofday(now, NULL);
+}
+
+/*!
+ * \internal
+ * \brief Get the time new timers are started relative to.
+ *
+ * \param ctrl D channel controller.
+ * \param now Filled with the current time.
+ *
+ * \return Nothing
+ */
+static void pri_sched_start_time(struct pri *ctrl, struct timeval *now)
+{
+	if (ctrl->sched.now_supplied) {
+		/* The application gave us the time for this event loop pass. */
+		*now = ctrl->sched.now;
+	} else {
+		pri_schedule_now(now);
+	}
+}
+
+/*!
+ * \internal
+ * \brief Tell the reactor the earliest timer of the D channel changed.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return Nothing
+ */
+static inline void pri_sched_earliest_changed(struct pri *ctrl)
+{
+	if (ctrl->sched.reactor) {
+		pri_reactor_deadline_changed(ctrl);
+	}
+}
+
+/*!
+ * \internal
+ * \brief Get the timer slot of the given slot index.
+ *
+ * \param ctrl D channel controller.
+ * \param slot Timer slot index.
+ *
+ * \return Timer slot
+ */
+static inline struct pri_sched *pri_sched_slot(struct pri *ctrl, unsigned slot)
+{
+	return &ctrl->sched.chunk[slot / SCHED_CHUNK_SLOTS][slot % SCHED_CHUNK_SLOTS];
+}
+
+/*!
+ * \internal
+ * \brief Put the given timer slot at the given heap position.
+ *
+ * \param ctrl D channel controller.
+ * \param pos Heap position to fill.
+ * \param slot Timer slot index to put there.
+ *
+ * \return Nothing
+ */
+static inline void pri_sched_heap_set(struct pri *ctrl, unsigned pos, unsigned slot)
+{
+	ctrl->sched.heap[pos] = slot;
+	pri_sched_slot(ctrl, slot)->heap_pos = pos;
+}
+
+/*!
+ * \internal
+ * \brief Move the timer at the given heap position toward the root.
+ *
+ * \param ctrl D channel controller.
+ * \param pos Heap position of the timer to sift up.
+ *
+ * \return Nothing
+ */
+static void pri_sched_heap_up(struct pri *ctrl, unsigned pos)
+{
+	unsigned slot;
+	unsigned parent;
+
+	slot = ctrl->sched.heap[pos];
+	while (pos) {
+		parent = (pos - 1) / 2;
+		if (!pri_sched_before(&pri_sched_slot(ctrl, slot)->when,
+			&pri_sched_slot(ctrl, ctrl->sched.heap[parent])->when)) {
+			break;
+		}
+		pri_sched_heap_set(ctrl, pos, ctrl->sched.heap[parent]);
+		pos = parent;
+	}
+	pri_sched_heap_set(ctrl, pos, slot);
+}
+
+/*!
+ * \internal
+ * \brief Move the timer at the given heap position toward the leaves.
+ *
+ * \param ctrl D channel controller.
+ * \param pos Heap position of the timer to sift down.
+ *
+ * \return Nothing
+ */
+static void pri_sched_heap_down(struct pri *ctrl, unsigned pos)
+{
+	unsigned slot;
+	unsigned child;
+	unsigned num_active;
+
+	num_active = ctrl->sched.num_active;
+	slot = ctrl->sched.heap[pos];
+	for (;;) {
+		child = 2 * pos + 1;
+		if (num_active <= child) {
+			break;
+		}
+		if (child + 1 < num_active
+			&& pri_sched_before(&pri_sched_slot(ctrl, ctrl->sched.heap[child + 1])->when,
+				&pri_sched_slot(ctrl, ctrl->sched.heap[child])->when)) {
+			++child;
+		}
+		if (!pri_sched_before(&pri_sched_slot(ctrl, ctrl->sched.heap[child])->when,
+			&pri_sched_slot(ctrl, slot)->when)) {
+			break;
+		}
+		pri_sched_heap_set(ctrl, pos, ctrl->sched.heap[child]);
+		pos = child;
+	}
+	pri_sched_heap_set(ctrl, pos, slot);
+}
+
+/*!
+ * \internal
+ * \brief Stop the active timer in the given slot and put the slot on the free list.
+ *
+ * \param ctrl D channel controller.
+ * \param slot Timer slot index to release.
+ *
+ * \return Nothing
+ */
+static void pri_sched_release(struct pri *ctrl, unsigned slot)
+{
+	struct pri_sched *timer;
+	unsigned pos;
+	unsigned last;
+
+	timer = pri_sched_slot(ctrl, slot);
+	pos = timer->heap_pos;
+	last = --ctrl->sched.num_active;
+	if (pos != last) {
+		/* Fill the hole with the last heap entry and restore the heap order. */
+		pri_sched_heap_set(ctrl, pos, ctrl->sched.heap[last]);
+		if (pos && pri_sched_before(&pri_sched_slot(ctrl, ctrl->sched.heap[pos])->when,
+			&pri_sched_slot(ctrl, ctrl->sched.heap[(pos - 1) / 2])->when)) {
+			pri_sched_heap_up(ctrl, pos);
+		} else {
+			pri_sched_heap_down(ctrl, pos);
+		}
+	}
+
+	/* Any outstanding id for this slot is now stale. */
+	timer->callback = NULL;
+	timer->gen = (timer->gen + 1) & SCHED_ID_GEN_MASK;
+	if (!timer->gen) {
+		/* Generation zero is skipped so a timer id can never be zero. */
+		timer->gen = 1;
+	}
+
+	/*
+	 * Put the slot at the end of the free list so a slot is reused
+	 * as late as possible.
+	 */
+	timer->next_free = SCHED_NO_SLOT;
+	if (ctrl->sched.num_slots <= ctrl->sched.free_head) {
+		ctrl->sched.free_head = slot;
+	} else {
+		pri_sched_slot(ctrl, ctrl->sched.free_tail)->next_free = slot;
+	}
+	ctrl->sched.free_tail = slot;
+
+	if (!pos) {
+		/* The earliest timer was stopped. */
+		pri_sched_earliest_changed(ctrl);
+	}
+}
+
+/*!
+ * \internal
+ * \brief Give the D channel the next timer pool tag.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \note Tags only repeat after SCHED_ID_TAG_MASK + 1 timer pools have
+ * been created so D channels in an NFAS group never share a tag in
+ * practice.
+ *
+ * \return Nothing
+ */
+static void pri_sched_tag_alloc(struct pri *ctrl)
+{
+	ctrl->sched.tag = __atomic_add_fetch(&sched_last_tag, 1, __ATOMIC_RELAXED)
+		& SCHED_ID_TAG_MASK;
+}
+
 /*!
  * \internal
  * \brief Increase the number of scheduler timer slots available.
  *
  * \param ctrl D channel controller.
  *
+ * \note Timer slots are allocated in chunks so existing timers never move.
+ *
  * \retval 0 on success.
  * \retval -1 on error.
  */
 static int pri_schedule_grow(struct pri *ctrl)
 {
-	unsigned num_slots;
+	unsigned num_chunks;
+	unsigned x;
 	struct pri_sched *timers;
+	struct pri_sched **chunk;
+	unsigned *heap;
 
-	/* Determine how many slots in the new timer table. */
-	if (ctrl->sched.num_slots) {
-		if (SCHED_EVENTS_MAX <= ctrl->sched.num_slots) {
-			/* Cannot grow the timer table any more. */
-			return -1;
-		}
-		num_slots = ctrl->sched.num_slots * 2;
-		if (SCHED_EVENTS_MAX < num_slots) {
-			num_slots = SCHED_EVENTS_MAX;
-		}
-	} else {
-		num_slots = SCHED_EVENTS_INITIAL;
+	if (SCHED_EVENTS_MAX <= ctrl->sched.num_slots) {
+		/* Cannot grow the timer pool any more. */
+		return -1;
 	}
 
-	/* Get and initialize the new timer table. */
-	timers = calloc(num_slots, sizeof(struct pri_sched));
+	/* Get and initialize the new timer chunk. */
+	timers = calloc(SCHED_CHUNK_SLOTS, sizeof(struct pri_sched));
 	if (!timers) {
-		/* Could not get a new timer table. */
+		/* Could not get a new timer chunk. */
 		return -1;
 	}
-	if (ctrl->sched.timer) {
-		/* Copy over the old timer table. */
-		memcpy(timers, ctrl->sched.timer,
-			ctrl->sched.num_slots * sizeof(struct pri_sched));
-		free(ctrl->sched.timer);
-	} else {
+	num_chunks = ctrl->sched.num_slots / SCHED_CHUNK_SLOTS;
+	chunk = realloc(ctrl->sched.chunk, (num_chunks + 1) * sizeof(*chunk));
+	if (!chunk) {
+		/* Could not extend the chunk directory. */
+		free(timers);
+		return -1;
+	}
+	ctrl->sched.chunk = chunk;
+	heap = realloc(ctrl->sched.heap,
+		(ctrl->sched.num_slots + SCHED_CHUNK_SLOTS) * sizeof(*heap));
+	if (!heap) {
+		/* Could not extend the expiration heap. */
+		free(timers);
+		return -1;
+	}
+	ctrl->sched.heap = heap;
+	if (!ctrl->sched.num_slots) {
 		/* Creating the timer pool. */
-		pool_id += SCHED_EVENTS_MAX;
-		if (pool_id < SCHED_EVENTS_MAX
-			|| pool_id + (SCHED_EVENTS_MAX - 1) < SCHED_EVENTS_MAX) {
-			/*
-			 * Not likely to happen.
-			 *
-			 * Timer id's may be aliased if this D channel is used in an
-			 * NFAS group with redundant D channels.  Another D channel in
-			 * the group may have the same pool_id.
-			 */
-			pri_error(ctrl,
-				"Pool_id wrapped.  Please ignore if you are not using NFAS with backup D channels.\n");
-			pool_id = SCHED_EVENTS_MAX;
-		}
-		ctrl->sched.first_id = pool_id;
+		pri_sched_tag_alloc(ctrl);
+	}
+
+	/* The free list is empty when we grow so the new slots become the free list. */
+	for (x = 0; x < SCHED_CHUNK_SLOTS; ++x) {
+		timers[x].gen = 1;
+		timers[x].next_free = ctrl->sched.num_slots + x + 1;
 	}
+	timers[SCHED_CHUNK_SLOTS - 1].next_free = SCHED_NO_SLOT;
+	ctrl->sched.free_head = ctrl->sched.num_slots;
+	ctrl->sched.free_tail = ctrl->sched.num_slots + SCHED_CHUNK_SLOTS - 1;
 
-	/* Put the new timer table in place. */
-	ctrl->sched.timer = timers;
-	ctrl->sched.num_slots = num_slots;
+	/* Put the new timer chunk in place. */
+	chunk[num_chunks] = timers;
+	ctrl->sched.num_slots += SCHED_CHUNK_SLOTS;
 	return 0;
 }
 
+/*!
+ * \brief Release all scheduler resources of the D channel.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return Nothing
+ */
+void pri_schedule_destroy(struct pri *ctrl)
+{
+	unsigned idx;
+
+	for (idx = 0; idx < ctrl->sched.num_slots / SCHED_CHUNK_SLOTS; ++idx) {
+		free(ctrl->sched.chunk[idx]);
+	}
+	free(ctrl->sched.chunk);
+	free(ctrl->sched.heap);
+	ctrl->sched.chunk = NULL;
+	ctrl->sched.heap = NULL;
+	ctrl->sched.num_slots = 0;
+	ctrl->sched.num_active = 0;
+	pri_sched_earliest_changed(ctrl);
+}
+
 /*!
  * \brief Start a timer to schedule an event.
  *
@@ -125,39 +407,40 @@ static int pri_schedule_grow(struct pri *ctrl)
  * \retval 0 if scheduler table is full and could not schedule the event.
  * \retval id Scheduled event id.
  */
-unsigned pri_schedule_event(struct pri *ctrl, int ms, void (*function)(void *data), void *data)
+pri_sched_id pri_schedule_event(struct pri *ctrl, int ms, void (*function)(void *data), void *data)
 {
-	unsigned max_used;
 	unsigned x;
+	struct pri_sched *timer;
 	struct timeval tv;
 
-	max_used = ctrl->sched.max_used;
-	for (x = 0; x < max_used; ++x) {
-		if (!ctrl->sched.timer[x].callback) {
-			break;
-		}
-	}
-	if (x == ctrl->sched.num_slots && pri_schedule_grow(ctrl)) {
+	if (ctrl->sched.num_slots <= ctrl->sched.free_head && pri_schedule_grow(ctrl)) {
 		pri_error(ctrl, "No more room in scheduler\n");
 		return 0;
 	}
-	if (ctrl->sched.max_used <= x) {
-		ctrl->sched.max_used = x + 1;
-	}
-	if (x >= maxsched) {
-		maxsched = x + 1;
+	x = ctrl->sched.free_head;
+	timer = pri_sched_slot(ctrl, x);
+	ctrl->sched.free_head = timer->next_free;
+	if (ctrl->sched.num_active >= maxsched) {
+		maxsched = ctrl->sched.num_active + 1;
 	}
-	gettimeofday(&tv, NULL);
+	pri_sched_start_time(ctrl, &tv);
 	tv.tv_sec += ms / 1000;
 	tv.tv_usec += (ms % 1000) * 1000;
-	if (tv.tv_usec > 1000000) {
+	if (tv.tv_usec >= 1000000) {
 		tv.tv_usec -= 1000000;
 		tv.tv_sec += 1;
 	}
-	ctrl->sched.timer[x].when = tv;
-	ctrl->sched.timer[x].callback = function;
-	ctrl->sched.timer[x].data = data;
-	return ctrl->sched.first_id + x;
+	timer->when = tv;
+	timer->callback = function;
+	timer->data = data;
+	ctrl->sched.heap[ctrl->sched.num_active] = x;
+	pri_sched_heap_up(ctrl, ctrl->sched.num_active++);
+	if (ctrl->sched.heap[0] == x) {
+		/* The new timer is the earliest timer. */
+		pri_sched_earliest_changed(ctrl);
+	}
+	return ((pri_sched_id) ctrl->sched.tag << (SCHED_ID_GEN_BITS + SCHED_ID_SLOT_BITS))
+		| ((pri_sched_id) timer->gen << SCHED_ID_SLOT_BITS) | x;
 }
 
 /*!
@@ -169,28 +452,77 @@ unsigned pri_schedule_event(struct pri *ctrl, int ms, void (*function)(void *dat
  */
 struct timeval *pri_schedule_next(struct pri *ctrl)
 {
-	struct timeval *closest = NULL;
-	unsigned x;
+	struct timeval now;
+	struct timeval *next;
 
-	/* Scan the scheduled timer slots backwards so we can update the max_used value. */
-	for (x = ctrl->sched.max_used; x--;) {
-		if (ctrl->sched.timer[x].callback) {
-			if (!closest) {
-				/* This is the highest sheduled timer slot in use. */
-				closest = &ctrl->sched.timer[x].when;
-				ctrl->sched.max_used = x + 1;
-			} else if ((closest->tv_sec > ctrl->sched.timer[x].when.tv_sec)
-				|| ((closest->tv_sec == ctrl->sched.timer[x].when.tv_sec)
-					&& (closest->tv_usec > ctrl->sched.timer[x].when.tv_usec))) {
-				closest = &ctrl->sched.timer[x].when;
-			}
-		}
+	if (!ctrl->sched.num_active) {
+		/* No scheduled timer slots are active. */
+		return NULL;
+	}
+
+	/*
+	 * Timers run on the scheduler clock but callers of this function
+	 * compare the result against gettimeofday().
+	 */
+	next = &pri_sched_slot(ctrl, ctrl->sched.heap[0])->when;
+	pri_schedule_now(&now);
+	gettimeofday(&ctrl->sched.next_wall, NULL);
+	ctrl->sched.next_wall.tv_sec += next->tv_sec - now.tv_sec;
+	ctrl->sched.next_wall.tv_usec += next->tv_usec - now.tv_usec;
+	if (ctrl->sched.next_wall.tv_usec < 0) {
+		ctrl->sched.next_wall.tv_usec += 1000000;
+		ctrl->sched.next_wall.tv_sec -= 1;
+	} else if (ctrl->sched.next_wall.tv_usec >= 1000000) {
+		ctrl->sched.next_wall.tv_usec -= 1000000;
+		ctrl->sched.next_wall.tv_sec += 1;
 	}
-	if (!closest) {
+	return &ctrl->sched.next_wall;
+}
+
+/*!
+ * \brief Get the expiration time of the earliest timer of the D channel.
+ *
+ * \param ctrl D channel controller.
+ * \param when Filled with the scheduler clock expiration time.
+ *
+ * \retval 0 on success.
+ * \retval -1 if no timers are active.
+ */
+int pri_schedule_earliest(struct pri *ctrl, struct timeval *when)
+{
+	if (!ctrl->sched.num_active) {
 		/* No scheduled timer slots are active. */
-		ctrl->sched.max_used = 0;
+		return -1;
+	}
+	*when = pri_sched_slot(ctrl, ctrl->sched.heap[0])->when;
+	return 0;
+}
+
+/*!
+ * \brief Determine how long until the next scheduled event expires.
+ *
+ * \param ctrl D channel controller.
+ * \param now Current scheduler clock time.
+ *
+ * \retval -1 if no timers are active.
+ * \retval ms Milliseconds until the next timer expires. (0 if already expired)
+ */
+int pri_schedule_next_ms(struct pri *ctrl, const struct timeval *now)
+{
+	const struct timeval *next;
+	long us;
+
+	if (!ctrl->sched.num_active) {
+		/* No scheduled timer slots are active. */
+		return -1;
 	}
-	return closest;
+	next = &pri_sched_slot(ctrl, ctrl->sched.heap[0])->when;
+	if (pri_sched_before(next, now)) {
+		return 0;
+	}
+	/* Round up so we do not wake up just before the timer expires. */
+	us = (next->tv_sec - now->tv_sec) * 1000000L + (next->tv_usec - now->tv_usec);
+	return (us + 999) / 1000;
 }
 
 /*!
@@ -202,31 +534,42 @@ struct timeval *pri_schedule_next(struct pri *ctrl)
  *
  * \return Event for upper layer to process or NULL if all expired timers run.
  */
-static pri_event *__pri_schedule_run(struct pri *ctrl, struct timeval *tv)
+static pri_event *__pri_schedule_run(struct pri *ctrl, const struct timeval *tv)
 {
 	unsigned x;
-	unsigned max_used;
+	struct pri_sched *timer;
 	void (*callback)(void *);
 	void *data;
+	pri_event *e;
 
-	max_used = ctrl->sched.max_used;
-	for (x = 0; x < max_used; ++x) {
-		if (ctrl->sched.timer[x].callback
-			&& ((ctrl->sched.timer[x].when.tv_sec < tv->tv_sec)
-			|| ((ctrl->sched.timer[x].when.tv_sec == tv->tv_sec)
-			&& (ctrl->sched.timer[x].when.tv_usec <= tv->tv_usec)))) {
-			/* This timer has expired. */
-			ctrl->schedev = 0;
-			callback = ctrl->sched.timer[x].callback;
-			data = ctrl->sched.timer[x].data;
-			ctrl->sched.timer[x].callback = NULL;
-			callback(data);
-			if (ctrl->schedev) {
-				return &ctrl->ev;
-			}
+	/* Frames sent by the expired timers go out together. */
+	e = NULL;
+	pri_tx_batch_begin(ctrl);
+	while (ctrl->sched.num_active) {
+		x = ctrl->sched.heap[0];
+		timer = pri_sched_slot(ctrl, x);
+		if (pri_sched_before(tv, &timer->when)) {
+			/* The earliest timer has not expired yet. */
+			break;
+		}
+
+		/* This timer has expired. */
+		ctrl->schedev = 0;
+		callback = timer->callback;
+		data = timer->data;
+		pri_sched_release(ctrl, x);
+		callback(data);
+		if (ctrl->schedev) {
+			/*
+			 * Only flagged without the event queue.  With the queue,
+			 * pri_event_ready() already queued the event.
+			 */
+			e = &ctrl->ev;
+			break;
 		}
 	}
-	return NULL;
+	pri_tx_batch_end(ctrl);
+	return e;
 }
 
 /*!
@@ -239,46 +582,164 @@ static pri_event *__pri_schedule_run(struct pri *ctrl, struct timeval *tv)
 pri_event *pri_schedule_run(struct pri *ctrl)
 {
 	struct timeval tv;
+	pri_event *e;
 
-	gettimeofday(&tv, NULL);
-	return __pri_schedule_run(ctrl, &tv);
+	pri_schedule_now(&tv);
+	e = __pri_schedule_run(ctrl, &tv);
+	return e ? e : pri_event_next(ctrl);
 }
 
 /*!
- * \brief Delete a scheduled event.
+ * \brief Run all expired timers or return an event generated by an expired timer.
  *
  * \param ctrl D channel controller.
- * \param id Scheduled event id to delete.
- * 0 is a disabled/unscheduled event id that is ignored.
+ * \param now Current scheduler clock time.
  *
- * \return Nothing
+ * \note Timers started by the expired timers are relative to the supplied time.
+ *
+ * \return Event for upper layer to process or NULL if all expired timers run.
  */
-void pri_schedule_del(struct pri *ctrl, unsigned id)
+pri_event *pri_schedule_run_tv(struct pri *ctrl, const struct timeval *now)
 {
-	struct pri *nfas;
+	pri_event *e;
 
-	if (!id) {
-		/* Disabled/unscheduled event id. */
-		return;
+	ctrl->sched.now = *now;
+	ctrl->sched.now_supplied = 1;
+	e = __pri_schedule_run(ctrl, now);
+	ctrl->sched.now_supplied = 0;
+	return e ? e : pri_event_next(ctrl);
+}
+
+/*!
+ * \brief Run all expired timers and collect every event they generate.
+ *
+ * \param ctrl D channel controller.
+ * \param now Current scheduler clock time.
+ * \param events Array to fill with the generated events.
+ * \param subcmds Array parallel to events to hold the subcommands of each event.
+ * \param max_events Number of entries available in the events and subcmds arrays.
+ *
+ * \note Queued events are moved to the events array if the event queue is enabled.
+ *
+ * \return Number of events put in the events array.
+ */
+int pri_schedule_run_batch(struct pri *ctrl, const struct timeval *now, pri_event *events, struct pri_subcommands *subcmds, int max_events)
+{
+	pri_event *e;
+	int count;
+
+	ctrl->sched.now = *now;
+	ctrl->sched.now_supplied = 1;
+	pri_tx_batch_begin(ctrl);
+	for (count = 0; count < max_events; ++count) {
+		e = __pri_schedule_run(ctrl, now);
+		if (!e) {
+			/* All expired timers have run. */
+			break;
+		}
+		pri_event_copy(&events[count], subcmds ? &subcmds[count] : NULL, e);
 	}
-	if (ctrl->sched.first_id <= id
-		&& id <= ctrl->sched.first_id + (SCHED_EVENTS_MAX - 1)) {
-		ctrl->sched.timer[id - ctrl->sched.first_id].callback = NULL;
-		return;
+	pri_tx_batch_end(ctrl);
+	ctrl->sched.now_supplied = 0;
+
+	/* The expired timers queued their events if the event queue is enabled. */
+	for (; count < max_events && (e = pri_event_next(ctrl)); ++count) {
+		pri_event_copy(&events[count], subcmds ? &subcmds[count] : NULL, e);
+		pri_event_release(ctrl);
+	}
+	return count;
+}
+
+/*!
+ * \internal
+ * \brief Find the active timer slot of the given timer id on the D channel.
+ *
+ * \param ctrl D channel controller.
+ * \param id Scheduled event id to find.
+ * \param slot Filled with the timer slot index if the timer is active.
+ *
+ * \retval 1 if the id belongs to this D channel and the timer is active.
+ * \retval 0 if the id belongs to this D channel but is stale.
+ * \retval -1 if the id does not belong to this D channel.
+ */
+static int pri_sched_find(struct pri *ctrl, pri_sched_id id, unsigned *slot)
+{
+	unsigned x;
+	struct pri_sched *timer;
+
+	x = id & SCHED_ID_SLOT_MASK;
+	if (!ctrl->sched.num_slots
+		|| (id >> (SCHED_ID_GEN_BITS + SCHED_ID_SLOT_BITS)) != ctrl->sched.tag
+		|| ctrl->sched.num_slots <= x) {
+		return -1;
+	}
+	timer = pri_sched_slot(ctrl, x);
+	if (!timer->callback || timer->gen != ((id >> SCHED_ID_SLOT_BITS) & SCHED_ID_GEN_MASK)) {
+		/* The timer already expired or was deleted. */
+		return 0;
+	}
+	*slot = x;
+	return 1;
+}
+
+/*!
+ * \internal
+ * \brief Find the D channel and active timer slot of the given timer id.
+ *
+ * \param ctrl D channel controller.
+ * \param id Scheduled event id to find.
+ * \param slot Filled with the timer slot index if the timer is active.
+ * \param action What was asked of the timer for the error message.
+ *
+ * \return D channel owning the active timer.
+ * \retval NULL if the timer is not active.
+ */
+static struct pri *pri_sched_find_owner(struct pri *ctrl, pri_sched_id id, unsigned *slot, const char *action)
+{
+	struct pri *nfas;
+	int res;
+
+	res = pri_sched_find(ctrl, id, slot);
+	if (0 <= res) {
+		return res ? ctrl : NULL;
 	}
 	if (ctrl->nfas) {
 		/* Try to find the timer on another D channel. */
 		for (nfas = PRI_NFAS_MASTER(ctrl); nfas; nfas = nfas->slave) {
-			if (nfas->sched.first_id <= id
-				&& id <= nfas->sched.first_id + (SCHED_EVENTS_MAX - 1)) {
-				nfas->sched.timer[id - nfas->sched.first_id].callback = NULL;
-				return;
+			res = pri_sched_find(nfas, id, slot);
+			if (0 <= res) {
+				return res ? nfas : NULL;
 			}
 		}
 	}
 	pri_error(ctrl,
-		"Asked to delete sched id 0x%08x??? first_id=0x%08x, num_slots=0x%08x\n", id,
-		ctrl->sched.first_id, ctrl->sched.num_slots);
+		"Asked to %s sched id 0x%016llx??? tag=0x%05x, num_slots=0x%08x\n", action,
+		(unsigned long long) id, ctrl->sched.tag, ctrl->sched.num_slots);
+	return NULL;
+}
+
+/*!
+ * \brief Delete a scheduled event.
+ *
+ * \param ctrl D channel controller.
+ * \param id Scheduled event id to delete.
+ * 0 is a disabled/unscheduled event id that is ignored.
+ *
+ * \return Nothing
+ */
+void pri_schedule_del(struct pri *ctrl, pri_sched_id id)
+{
+	struct pri *owner;
+	unsigned slot;
+
+	if (!id) {
+		/* Disabled/unscheduled event id. */
+		return;
+	}
+	owner = pri_sched_find_owner(ctrl, id, &slot, "delete");
+	if (owner) {
+		pri_sched_release(owner, slot);
+	}
 }
 
 /*!
@@ -292,31 +753,20 @@ void pri_schedule_del(struct pri *ctrl, unsigned id)
  *
  * \return TRUE if scheduled event has the callback.
  */
-int pri_schedule_check(struct pri *ctrl, unsigned id, void (*function)(void *data), void *data)
+int pri_schedule_check(struct pri *ctrl, pri_sched_id id, void (*function)(void *data), void *data)
 {
-	struct pri *nfas;
+	struct pri *owner;
+	struct pri_sched *timer;
+	unsigned slot;
 
 	if (!id) {
 		/* Disabled/unscheduled event id. */
 		return 0;
 	}
-	if (ctrl->sched.first_id <= id
-		&& id <= ctrl->sched.first_id + (SCHED_EVENTS_MAX - 1)) {
-		return ctrl->sched.timer[id - ctrl->sched.first_id].callback == function
-			&& ctrl->sched.timer[id - ctrl->sched.first_id].data == data;
-	}
-	if (ctrl->nfas) {
-		/* Try to find the timer on another D channel. */
-		for (nfas = PRI_NFAS_MASTER(ctrl); nfas; nfas = nfas->slave) {
-			if (nfas->sched.first_id <= id
-				&& id <= nfas->sched.first_id + (SCHED_EVENTS_MAX - 1)) {
-				return nfas->sched.timer[id - nfas->sched.first_id].callback == function
-					&& nfas->sched.timer[id - nfas->sched.first_id].data == data;
-			}
-		}
+	owner = pri_sched_find_owner(ctrl, id, &slot, "check");
+	if (!owner) {
+		return 0;
 	}
-	pri_error(ctrl,
-		"Asked to check sched id 0x%08x??? first_id=0x%08x, num_slots=0x%08x\n", id,
-		ctrl->sched.first_id, ctrl->sched.num_slots);
-	return 0;
+	timer = pri_sched_slot(owner, slot);
+	return timer->callback == function && timer->data == data;
 }
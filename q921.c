@@ -165,6 +165,122 @@ static void q921_setstate(struct q921_link *link, int newstate)
 	link->state = newstate;
 }
 
+/*! Bytes needed by a frame pool slot. (Rounded up to keep the slots aligned) */
+#define Q921_FRAME_POOL_SLOT_SIZE	\
+	((sizeof(struct q921_frame) + Q921_FRAME_POOL_DATA_SIZE + 2 + sizeof(void *) - 1) \
+		& ~(sizeof(void *) - 1))
+
+/*!
+ * \internal
+ * \brief Allocate the I-frame buffers for the link frame pool.
+ *
+ * \param link Q.921 link to get a frame pool.
+ *
+ * \note The pool holds a full window K of frames plus the configured backlog.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+static int q921_frame_pool_create(struct q921_link *link)
+{
+	struct q921_frame_pool *pool;
+	struct q921_frame *f;
+	unsigned char *slot;
+	unsigned num_slots;
+	unsigned idx;
+
+	pool = &link->frame_pool;
+	num_slots = link->ctrl->timers[PRI_TIMER_K] + link->ctrl->iframe_backlog;
+	if (!num_slots) {
+		return -1;
+	}
+	pool->slots = malloc(num_slots * Q921_FRAME_POOL_SLOT_SIZE);
+	if (!pool->slots) {
+		return -1;
+	}
+	pool->num_slots = num_slots;
+
+	/* Put the slots on the free list in address order. */
+	pool->free_list = NULL;
+	slot = (unsigned char *) pool->slots + num_slots * Q921_FRAME_POOL_SLOT_SIZE;
+	for (idx = num_slots; idx--;) {
+		slot -= Q921_FRAME_POOL_SLOT_SIZE;
+		f = (struct q921_frame *) slot;
+		f->next = pool->free_list;
+		pool->free_list = f;
+	}
+	return 0;
+}
+
+/*!
+ * \internal
+ * \brief Get an I-frame buffer for the link retransmission queue.
+ *
+ * \param link Q.921 link the frame is for.
+ * \param len Length of the I-frame information field.
+ *
+ * \note Only the frame header is zeroed.  The caller fills in the
+ * information field.
+ *
+ * \note Falls back to the heap if the frame pool is exhausted or
+ * the frame is too big for a pool slot.
+ *
+ * \retval frame on success.
+ * \retval NULL on error.
+ */
+static struct q921_frame *q921_frame_alloc(struct q921_link *link, int len)
+{
+	struct q921_frame_pool *pool;
+	struct q921_frame *f;
+
+	pool = &link->frame_pool;
+	if (len <= Q921_FRAME_POOL_DATA_SIZE) {
+		if (!pool->slots) {
+			q921_frame_pool_create(link);
+		}
+		f = pool->free_list;
+		if (f) {
+			pool->free_list = f->next;
+			memset(f, 0, sizeof(*f));
+			f->pooled = 1;
+			if (pool->high_water < ++pool->in_use) {
+				pool->high_water = pool->in_use;
+			}
+			return f;
+		}
+	}
+
+	++pool->overflow;
+	f = malloc(sizeof(*f) + len + 2);
+	if (f) {
+		memset(f, 0, sizeof(*f));
+	}
+	return f;
+}
+
+/*!
+ * \internal
+ * \brief Release an I-frame buffer obtained by q921_frame_alloc().
+ *
+ * \param link Q.921 link the frame is for.
+ * \param f Frame to release.
+ *
+ * \return Nothing
+ */
+static void q921_frame_free(struct q921_link *link, struct q921_frame *f)
+{
+	struct q921_frame_pool *pool;
+
+	if (f->pooled) {
+		pool = &link->frame_pool;
+		f->next = pool->free_list;
+		pool->free_list = f;
+		--pool->in_use;
+	} else {
+		free(f);
+	}
+}
+
 static void q921_discard_iqueue(struct q921_link *link)
 {
 	struct q921_frame *f, *p;
@@ -174,9 +290,28 @@ static void q921_discard_iqueue(struct q921_link *link)
 		p = f;
 		f = f->next;
 		/* Free frame */
-		free(p);
+		q921_frame_free(link, p);
 	}
 	link->tx_queue = NULL;
+	link->tx_queue_tail = NULL;
+	link->tx_pending = NULL;
+	link->tx_queue_len = 0;
+}
+
+/*!
+ * \brief Discard the retransmission queue and release the link frame pool.
+ *
+ * \param link Q.921 link being destroyed.
+ *
+ * \return Nothing
+ */
+void q921_frame_pool_destroy(struct q921_link *link)
+{
+	q921_discard_iqueue(link);
+	free(link->frame_pool.slots);
+	link->frame_pool.slots = NULL;
+	link->frame_pool.free_list = NULL;
+	link->frame_pool.num_slots = 0;
 }
 
 static int q921_transmit(struct pri *ctrl, q921_h *h, int len) 
@@ -190,11 +325,14 @@ static int q921_transmit(struct pri *ctrl, q921_h *h, int len)
 	}
 #endif
 	ctrl->q921_txcount++;
+	if (ctrl->trace.slots) {
+		pri_trace_frame(ctrl, h, len, PRI_TRACE_TX);
+	}
 	/* Just send it raw */
 	if (ctrl->debug & (PRI_DEBUG_Q921_DUMP | PRI_DEBUG_Q921_RAW))
 		q921_dump(ctrl, h, len, ctrl->debug, 1);
 	/* Write an extra two bytes for the FCS */
-	res = ctrl->write_func ? ctrl->write_func(ctrl, h, len + 2) : 0;
+	res = pri_write_frame(ctrl, h, len + 2);
 	if (res != (len + 2)) {
 		pri_error(ctrl, "Short write: %d/%d (%s)\n", res, len + 2, strerror(errno));
 		return -1;
@@ -204,10 +342,14 @@ static int q921_transmit(struct pri *ctrl, q921_h *h, int len)
 
 static void q921_mdl_send(struct pri *ctrl, enum q921_tei_identity message, int ri, int ai, int iscommand)
 {
+	union {
+		q921_u u;
+		unsigned char raw[sizeof(q921_u) + 5 + 2];
+	} frame;
 	q921_u *f;
 
-	if (!(f = calloc(1, sizeof(*f) + 5)))
-		return;
+	memset(&frame, 0, sizeof(frame));
+	f = &frame.u;
 
 	Q921_INIT(f, Q921_SAPI_LAYER2_MANAGEMENT, Q921_TEI_GROUP);
 	f->h.c_r = (ctrl->localtype == PRI_NETWORK) ? iscommand : !iscommand;
@@ -223,7 +365,6 @@ static void q921_mdl_send(struct pri *ctrl, enum q921_tei_identity message, int
 			message, q921_tei_mgmt2str(message), ai);
 	}
 	q921_transmit(ctrl, (q921_h *)f, 8);
-	free(f);
 }
 
 static void t202_expire(void *vlink)
@@ -411,10 +552,8 @@ static int q921_ack_packet(struct q921_link *link, int num)
 
 	ctrl = link->ctrl;
 
-	for (prev = NULL, f = link->tx_queue; f; prev = f, f = f->next) {
-		if (f->status != Q921_TX_FRAME_SENT) {
-			break;
-		}
+	/* Only the sent frames ahead of the pending cursor can be acked. */
+	for (prev = NULL, f = link->tx_queue; f != link->tx_pending; prev = f, f = f->next) {
 		if (f->h.n_s == num) {
 			/* Cancel each packet as necessary */
 			/* That's our packet */
@@ -422,6 +561,10 @@ static int q921_ack_packet(struct q921_link *link, int num)
 				prev->next = f->next;
 			else
 				link->tx_queue = f->next;
+			if (link->tx_queue_tail == f) {
+				link->tx_queue_tail = prev;
+			}
+			--link->tx_queue_len;
 			if (ctrl->debug & PRI_DEBUG_Q921_DUMP) {
 				pri_message(ctrl,
 					"-- ACKing N(S)=%d, tx_queue head is N(S)=%d (-1 is empty, -2 is not transmitted)\n",
@@ -433,7 +576,7 @@ static int q921_ack_packet(struct q921_link *link, int num)
 						: -1);
 			}
 			/* Update v_a */
-			free(f);
+			q921_frame_free(link, f);
 			return 1;
 		}
 	}
@@ -629,9 +772,8 @@ static void restart_timer_start(struct q921_link *link)
 }
 
 /*! \note Only call on the transition to state Q921_TEI_ASSIGNED or already there. */
-static pri_event *q921_check_delay_restart(struct q921_link *link)
+static void q921_check_delay_restart(struct q921_link *link)
 {
-	pri_event *ev;
 	struct pri *ctrl;
 
 	ctrl = link->ctrl;
@@ -653,18 +795,13 @@ static pri_event *q921_check_delay_restart(struct q921_link *link)
 		case Q921_MULTI_FRAME_ESTABLISHED:
 		case Q921_TIMER_RECOVERY:
 			/* Notify the upper layer that layer 2 went down. */
-			ctrl->schedev = 1;
 			ctrl->ev.gen.e = PRI_EVENT_DCHAN_DOWN;
-			ev = &ctrl->ev;
+			pri_event_ready(ctrl);
 			break;
 		default:
-			ev = NULL;
 			break;
 		}
-	} else {
-		ev = NULL;
 	}
-	return ev;
 }
 
 /*!
@@ -701,12 +838,7 @@ static int q921_send_queued_iframes(struct q921_link *link)
 
 	ctrl = link->ctrl;
 
-	for (f = link->tx_queue; f; f = f->next) {
-		if (f->status != Q921_TX_FRAME_SENT) {
-			/* This frame needs to be sent. */
-			break;
-		}
-	}
+	f = link->tx_pending;
 	if (!f) {
 		/* The Tx queue has no pending frames. */
 		return 0;
@@ -793,6 +925,7 @@ static int q921_send_queued_iframes(struct q921_link *link)
 		}
 		f->status = Q921_TX_FRAME_SENT;
 	}
+	link->tx_pending = f;
 
 	if (frames_txd) {
 		link->acknowledge_pending = 0;
@@ -924,8 +1057,8 @@ static void t200_expire(void *vlink)
 			link->l3_initiated = 0;
 			q921_setstate(link, Q921_AWAITING_ESTABLISHMENT);
 			if (PTP_MODE(ctrl)) {
-				ctrl->schedev = 1;
 				ctrl->ev.gen.e = PRI_EVENT_DCHAN_DOWN;
+				pri_event_ready(ctrl);
 			}
 		}
 		break;
@@ -1019,10 +1152,63 @@ static struct q921_link *pri_find_tei(struct pri *ctrl, int sapi, int tei)
 	return NULL;
 }
 
-/* This is the equivalent of a DL-DATA request, as well as the I-frame queued up outcome */
-int q921_transmit_iframe(struct q921_link *link, void *buf, int len, int cr)
+/*!
+ * \brief Get an I-frame pool slot to build a layer 3 message in place.
+ *
+ * \param link Q.921 link the message is to be sent on.
+ *
+ * \note The message is built in f->h.data which has room for
+ * Q921_FRAME_POOL_DATA_SIZE octets.  The Q.921 header in front of
+ * it is filled in when the frame is queued.
+ *
+ * \retval frame on success.  Pass it to q921_transmit_leased_iframe()
+ * or q921_iframe_lease_release().
+ * \retval NULL if the frame pool has no free slot.  Build the message
+ * elsewhere and send it with q921_transmit_iframe().
+ */
+struct q921_frame *q921_iframe_lease(struct q921_link *link)
+{
+	struct q921_frame_pool *pool;
+
+	pool = &link->frame_pool;
+	if (!pool->slots) {
+		q921_frame_pool_create(link);
+	}
+	if (!pool->free_list) {
+		return NULL;
+	}
+	return q921_frame_alloc(link, Q921_FRAME_POOL_DATA_SIZE);
+}
+
+/*!
+ * \brief Give back a leased I-frame buffer that is not going to be sent.
+ *
+ * \param link Q.921 link the frame was leased from.
+ * \param f Frame obtained by q921_iframe_lease().
+ *
+ * \return Nothing
+ */
+void q921_iframe_lease_release(struct q921_link *link, struct q921_frame *f)
+{
+	q921_frame_free(link, f);
+}
+
+/*!
+ * \brief Queue a leased I-frame holding a layer 3 message for transmission.
+ *
+ * \param link Q.921 link to send the message on.
+ * \param f Frame obtained by q921_iframe_lease() holding the message.
+ * \param len Length of the message in f->h.data.
+ * \param cr TRUE if the message is a command.
+ *
+ * \note This is the equivalent of a DL-DATA request, as well as the
+ * I-frame queued up outcome.  The link owns the frame afterwards
+ * whether or not it could be queued.
+ *
+ * \return 0
+ */
+int q921_transmit_leased_iframe(struct q921_link *link, struct q921_frame *f, int len, int cr)
 {
-	struct q921_frame *f, *prev=NULL;
 	struct pri *ctrl;
 
 	ctrl = link->ctrl;
@@ -1030,6 +1216,7 @@ int q921_transmit_iframe(struct q921_link *link, void *buf, int len, int cr)
 	if (PTMP_MODE(ctrl)) {
 		if (link->tei == Q921_TEI_GROUP) {
 			pri_error(ctrl, "Huh?! For PTMP, we shouldn't be sending I-frames out the group TEI\n");
+			q921_frame_free(link, f);
 			return 0;
 		}
 		if (BRI_TE_PTMP(ctrl)) {
@@ -1062,75 +1249,71 @@ int q921_transmit_iframe(struct q921_link *link, void *buf, int len, int cr)
 	case Q921_TIMER_RECOVERY:
 	case Q921_AWAITING_ESTABLISHMENT:
 	case Q921_MULTI_FRAME_ESTABLISHED:
-		/* Find queue tail. */
-		for (f = link->tx_queue; f; f = f->next) {
-			prev = f;
+		Q921_INIT(&f->h, link->sapi, link->tei);
+		switch (ctrl->localtype) {
+		case PRI_NETWORK:
+			if (cr)
+				f->h.h.c_r = 1;
+			else
+				f->h.h.c_r = 0;
+			break;
+		case PRI_CPE:
+			if (cr)
+				f->h.h.c_r = 0;
+			else
+				f->h.h.c_r = 1;
+			break;
 		}
 
-		f = calloc(1, sizeof(struct q921_frame) + len + 2);
-		if (f) {
-			Q921_INIT(&f->h, link->sapi, link->tei);
-			switch (ctrl->localtype) {
-			case PRI_NETWORK:
-				if (cr)
-					f->h.h.c_r = 1;
-				else
-					f->h.h.c_r = 0;
-				break;
-			case PRI_CPE:
-				if (cr)
-					f->h.h.c_r = 0;
-				else
-					f->h.h.c_r = 1;
-				break;
-			}
+		/* Put new frame on queue tail. */
+		f->next = NULL;
+		f->status = Q921_TX_FRAME_NEVER_SENT;
+		f->len = len + 4;
+		/* Clear the FCS room written after the frame. */
+		f->h.data[len] = 0;
+		f->h.data[len + 1] = 0;
+		if (link->tx_queue_tail)
+			link->tx_queue_tail->next = f;
+		else
+			link->tx_queue = f;
+		link->tx_queue_tail = f;
+		++link->tx_queue_len;
+		if (!link->tx_pending) {
+			link->tx_pending = f;
+		}
 
-			/* Put new frame on queue tail. */
-			f->next = NULL;
-			f->status = Q921_TX_FRAME_NEVER_SENT;
-			f->len = len + 4;
-			memcpy(f->h.data, buf, len);
-			if (prev)
-				prev->next = f;
-			else
-				link->tx_queue = f;
-
-			if (link->state != Q921_MULTI_FRAME_ESTABLISHED) {
-				if (ctrl->debug & PRI_DEBUG_Q921_STATE) {
-					pri_message(ctrl,
-						"TEI=%d Just queued I-frame since in state %d(%s)\n",
-						link->tei,
-						link->state, q921_state2str(link->state));
-				}
-				break;
+		if (link->state != Q921_MULTI_FRAME_ESTABLISHED) {
+			if (ctrl->debug & PRI_DEBUG_Q921_STATE) {
+				pri_message(ctrl,
+					"TEI=%d Just queued I-frame since in state %d(%s)\n",
+					link->tei,
+					link->state, q921_state2str(link->state));
 			}
-			if (link->peer_rx_busy) {
-				if (ctrl->debug & PRI_DEBUG_Q921_STATE) {
-					pri_message(ctrl,
-						"TEI=%d Just queued I-frame due to peer busy condition\n",
-						link->tei);
-				}
-				break;
+			break;
+		}
+		if (link->peer_rx_busy) {
+			if (ctrl->debug & PRI_DEBUG_Q921_STATE) {
+				pri_message(ctrl,
+					"TEI=%d Just queued I-frame due to peer busy condition\n",
+					link->tei);
 			}
+			break;
+		}
 
-			if (!q921_send_queued_iframes(link)) {
-				/*
-				 * No frames sent even though we just put a frame on the queue.
-				 *
-				 * Special debug message/test here because we want to say what
-				 * happened to the Q.931 message just queued but we don't want
-				 * to flood the debug trace if we are not really looking at the
-				 * Q.921 layer.
-				 */
-				if ((ctrl->debug & (PRI_DEBUG_Q921_STATE | PRI_DEBUG_Q921_DUMP))
-					== PRI_DEBUG_Q921_STATE) {
-					pri_message(ctrl, "TEI=%d Just queued I-frame due to window shut\n",
-						link->tei);
-				}
+		if (!q921_send_queued_iframes(link)) {
+			/*
+			 * No frames sent even though we just put a frame on the queue.
+			 *
+			 * Special debug message/test here because we want to say what
+			 * happened to the Q.931 message just queued but we don't want
+			 * to flood the debug trace if we are not really looking at the
+			 * Q.921 layer.
+			 */
+			if ((ctrl->debug & (PRI_DEBUG_Q921_STATE | PRI_DEBUG_Q921_DUMP))
+				== PRI_DEBUG_Q921_STATE) {
+				pri_message(ctrl, "TEI=%d Just queued I-frame due to window shut\n",
+					link->tei);
 			}
-		} else {
-			pri_error(ctrl, "!! Out of memory for Q.921 transmit\n");
-			return -1;
 		}
 		break;
 	case Q921_TEI_UNASSIGNED:
@@ -1139,11 +1322,26 @@ int q921_transmit_iframe(struct q921_link *link, void *buf, int len, int cr)
 	default:
 		pri_error(ctrl, "Cannot transmit frames in state %d(%s)\n",
 			link->state, q921_state2str(link->state));
+		q921_frame_free(link, f);
 		break;
 	}
 	return 0;
 }
 
+/* This is the equivalent of a DL-DATA request with a copy of the message */
+int q921_transmit_iframe(struct q921_link *link, void *buf, int len, int cr)
+{
+	struct q921_frame *f;
+
+	f = q921_frame_alloc(link, len);
+	if (!f) {
+		pri_error(link->ctrl, "!! Out of memory for Q.921 transmit\n");
+		return -1;
+	}
+	memcpy(f->h.data, buf, len);
+	return q921_transmit_leased_iframe(link, f, len, cr);
+}
+
 static void t203_expire(void *vlink)
 {
 	struct q921_link *link = vlink;
@@ -1174,18 +1372,15 @@ static void q921_dump_iqueue_info(struct q921_link *link)
 {
 	struct pri *ctrl;
 	struct q921_frame *f;
-	int pending = 0;
+	int pending;
 	int unacked = 0;
 
 	ctrl = link->ctrl;
 
-	for (f = link->tx_queue; f; f = f->next) {
-		if (f->status == Q921_TX_FRAME_SENT) {
-			unacked++;
-		} else {
-			pending++;
-		}
+	for (f = link->tx_queue; f != link->tx_pending; f = f->next) {
+		unacked++;
 	}
+	pending = link->tx_queue_len - unacked;
 
 	pri_error(ctrl, "Number of pending packets %d, sent but unacked %d\n", pending, unacked);
 }
@@ -1198,10 +1393,14 @@ void q921_dump(struct pri *ctrl, q921_h *h, int len, int debugflags, int txrx)
 	const char *type;
 	char direction_tag;
 	
+	if (!pri_log_wanted(ctrl, PRI_LOG_MESSAGE)) {
+		return;
+	}
+
 	direction_tag = txrx ? '>' : '<';
 
 	pri_message(ctrl, "\n");
-	if (debugflags & PRI_DEBUG_Q921_DUMP) {
+	if ((debugflags & PRI_DEBUG_Q921_DUMP) && !(debugflags & Q921_DUMP_NO_LINK_STATE)) {
 		q921_dump_pri_by_h(ctrl, direction_tag, h);
 	}
 
@@ -1361,8 +1560,9 @@ static void q921_dump_pri(struct q921_link *link, char direction_tag)
 	pri_message(ctrl, "%c K=%d, RC=%d, l3_initiated=%d, reject_except=%d, ack_pend=%d\n",
 		direction_tag, ctrl->timers[PRI_TIMER_K], link->RC, link->l3_initiated,
 		link->reject_exception, link->acknowledge_pending);
-	pri_message(ctrl, "%c T200_id=%d, N200=%d, T203_id=%d\n",
-		direction_tag, link->t200_timer, ctrl->timers[PRI_TIMER_N200], link->t203_timer);
+	pri_message(ctrl, "%c T200_id=%llu, N200=%d, T203_id=%llu\n",
+		direction_tag, (unsigned long long) link->t200_timer, ctrl->timers[PRI_TIMER_N200],
+		(unsigned long long) link->t203_timer);
 }
 
 static void q921_dump_pri_by_h(struct pri *ctrl, char direction_tag, q921_h *h)
@@ -1724,7 +1924,7 @@ static pri_event *q921_mdl_receive(struct pri *ctrl, q921_u *h, int len)
 			q921_setstate(link, Q921_TEI_ASSIGNED);
 			if (ctrl->l2_persistence != PRI_L2_PERSISTENCE_KEEP_UP) {
 				ctrl->ev.gen.e = PRI_EVENT_DCHAN_UP;
-				res = &ctrl->ev;
+				pri_event_ready(ctrl);
 				break;
 			}
 			/* Fall through: Layer 2 is persistent so bring it up. */
@@ -1733,7 +1933,7 @@ static pri_event *q921_mdl_receive(struct pri *ctrl, q921_u *h, int len)
 			link->l3_initiated = 1;
 			q921_setstate(link, Q921_AWAITING_ESTABLISHMENT);
 			ctrl->ev.gen.e = PRI_EVENT_DCHAN_UP;
-			res = &ctrl->ev;
+			pri_event_ready(ctrl);
 			break;
 		default:
 			break;
@@ -1864,7 +2064,7 @@ static pri_event *q921_sabme_rx(struct q921_link *link, q921_h *h)
 		delay_q931_dl_event = Q931_DL_EVENT_DL_ESTABLISH_IND;
 		if (PTP_MODE(ctrl)) {
 			ctrl->ev.gen.e = PRI_EVENT_DCHAN_UP;
-			res = &ctrl->ev;
+			pri_event_ready(ctrl);
 		}
 		start_t203(link);
 		q921_setstate(link, Q921_MULTI_FRAME_ESTABLISHED);
@@ -1909,7 +2109,7 @@ static pri_event *q921_disc_rx(struct q921_link *link, q921_h *h)
 		break;
 	case Q921_MULTI_FRAME_ESTABLISHED:
 	case Q921_TIMER_RECOVERY:
-		res = q921_check_delay_restart(link);
+		q921_check_delay_restart(link);
 		q921_discard_iqueue(link);
 		q921_send_ua(link, h->u.p_f);
 		/* DL-RELEASE indication */
@@ -2105,8 +2305,8 @@ static void q921_mdl_handle_ptp_error(struct q921_link *link, char error)
 		 * 'J' is posted because of the potential event conflict with
 		 * incoming I-frame information passed to Q.931.
 		 */
-		ctrl->schedev = 1;
 		ctrl->ev.gen.e = PRI_EVENT_DCHAN_DOWN;
+		pri_event_ready(ctrl);
 		break;
 	case 'A':
 	case 'B':
@@ -2305,7 +2505,7 @@ static pri_event *q921_ua_rx(struct q921_link *link, q921_h *h)
 
 		if (PTP_MODE(ctrl)) {
 			ctrl->ev.gen.e = PRI_EVENT_DCHAN_UP;
-			res = &ctrl->ev;
+			pri_event_ready(ctrl);
 		}
 
 		stop_t200(link);
@@ -2323,7 +2523,7 @@ static pri_event *q921_ua_rx(struct q921_link *link, q921_h *h)
 		if (!h->u.p_f) {
 			q921_mdl_error(link, 'D');
 		} else {
-			res = q921_check_delay_restart(link);
+			q921_check_delay_restart(link);
 			/* DL-RELEASE confirm */
 			q931_dl_event(link, Q931_DL_EVENT_DL_RELEASE_CONFIRM);
 			stop_t200(link);
@@ -2525,7 +2725,7 @@ static int q921_invoke_retransmission(struct q921_link *link, int n_r)
 	 * All acked frames should already have been removed from the queue.
 	 * Push back all sent frames.
 	 */
-	for (f = link->tx_queue; f && f->status == Q921_TX_FRAME_SENT; f = f->next) {
+	for (f = link->tx_queue; f != link->tx_pending; f = f->next) {
 		f->status = Q921_TX_FRAME_PUSHED_BACK;
 
 		/* Sanity check: Is V(A) <= N(S) <= V(S)? */
@@ -2535,6 +2735,7 @@ static int q921_invoke_retransmission(struct q921_link *link, int n_r)
 				f->h.n_s, link->v_a, link->v_s);
 		}
 	}
+	link->tx_pending = link->tx_queue;
 	link->v_s = n_r;
 	return q921_send_queued_iframes(link);
 }
@@ -2616,7 +2817,7 @@ static pri_event *q921_frmr_rx(struct q921_link *link, q921_h *h)
 		q921_setstate(link, Q921_AWAITING_ESTABLISHMENT);
 		if (PTP_MODE(ctrl)) {
 			ctrl->ev.gen.e = PRI_EVENT_DCHAN_DOWN;
-			res = &ctrl->ev;
+			pri_event_ready(ctrl);
 		}
 		break;
 	case Q921_TEI_ASSIGNED:
@@ -2715,7 +2916,7 @@ static pri_event *q921_iframe_rx(struct q921_link *link, q921_h *h, int len)
 			/* Q.921 has finished processing the frame so we can give it to Q.931 now. */
 			res = q931_receive(link, (q931_h *) h->i.data, len - 4);
 			if (res != -1 && (res & Q931_RES_HAVEEVENT)) {
-				eres = &ctrl->ev;
+				pri_event_ready(ctrl);
 			}
 		}
 		break;
@@ -2761,7 +2962,7 @@ static pri_event *q921_dm_rx(struct q921_link *link, q921_h *h)
 		if (!h->u.p_f)
 			break;
 
-		res = q921_check_delay_restart(link);
+		q921_check_delay_restart(link);
 		q921_discard_iqueue(link);
 		/* DL-RELEASE indication */
 		q931_dl_event(link, Q931_DL_EVENT_DL_RELEASE_IND);
@@ -2771,7 +2972,7 @@ static pri_event *q921_dm_rx(struct q921_link *link, q921_h *h)
 	case Q921_AWAITING_RELEASE:
 		if (!h->u.p_f)
 			break;
-		res = q921_check_delay_restart(link);
+		q921_check_delay_restart(link);
 		/* DL-RELEASE confirm */
 		q931_dl_event(link, Q931_DL_EVENT_DL_RELEASE_CONFIRM);
 		stop_t200(link);
@@ -2789,7 +2990,7 @@ static pri_event *q921_dm_rx(struct q921_link *link, q921_h *h)
 		q921_setstate(link, Q921_AWAITING_ESTABLISHMENT);
 		if (PTP_MODE(ctrl)) {
 			ctrl->ev.gen.e = PRI_EVENT_DCHAN_DOWN;
-			res = &ctrl->ev;
+			pri_event_ready(ctrl);
 		}
 		break;
 	case Q921_TIMER_RECOVERY:
@@ -2803,7 +3004,7 @@ static pri_event *q921_dm_rx(struct q921_link *link, q921_h *h)
 		q921_setstate(link, Q921_AWAITING_ESTABLISHMENT);
 		if (PTP_MODE(ctrl)) {
 			ctrl->ev.gen.e = PRI_EVENT_DCHAN_DOWN;
-			res = &ctrl->ev;
+			pri_event_ready(ctrl);
 		}
 		break;
 	default:
@@ -2975,7 +3176,7 @@ static pri_event *__q921_receive_qualified(struct q921_link *link, q921_h *h, in
 			}
 			res = q931_receive(link, (q931_h *) h->u.data, len - 3);
 			if (res != -1 && (res & Q931_RES_HAVEEVENT)) {
-				ev = &ctrl->ev;
+				pri_event_ready(ctrl);
 			}
 			break;
 		case 0x08:
@@ -3067,6 +3268,9 @@ static pri_event *__q921_receive(struct pri *ctrl, q921_h *h, int len)
 	/* Discard FCS */
 	len -= 2;
 	
+	if (ctrl->trace.slots) {
+		pri_trace_frame(ctrl, h, len, PRI_TRACE_RX);
+	}
 	if (ctrl->debug & (PRI_DEBUG_Q921_DUMP | PRI_DEBUG_Q921_RAW)) {
 		q921_dump(ctrl, h, len, ctrl->debug, 0);
 	}
@@ -3138,8 +3342,8 @@ static void nt_ptmp_dchannel_up(void *vpri)
 {
 	struct pri *ctrl = vpri;
 
-	ctrl->schedev = 1;
 	ctrl->ev.gen.e = PRI_EVENT_DCHAN_UP;
+	pri_event_ready(ctrl);
 }
 
 void q921_start(struct q921_link *link)
@@ -31,6 +31,7 @@
 #include "libpri.h"
 #include "pri_internal.h"
 #include "pri_facility.h"
+#include "asn1.h"
 
 #include <unistd.h>
 #include <stdlib.h>
@@ -39,6 +40,7 @@
 #include <ctype.h>
 #include <stdio.h>
 #include <limits.h>
+#include <pthread.h>
 
 enum mandatory_ie_status {
 	MAND_STATUS_OK,
@@ -113,6 +115,139 @@ static struct msgtype msgs[] = {
 	{ Q931_ANY_MESSAGE, "ANY MESSAGE" },
 };
 
+/*! Set of codeset 0 variable length ies.  (ie codes 0x00-0x7f) */
+struct q931_ie_set {
+	unsigned int bits[0x80 / (8 * sizeof(unsigned int))];
+};
+
+#define Q931_IE_SET_WORD_BITS	(8 * sizeof(unsigned int))
+
+/*! Mandatory ies of each message type built from msgs[]. */
+static struct q931_ie_set msgs_mandatory[256];
+/*! Builds msgs_mandatory[] from msgs[] once. */
+static pthread_once_t msgs_mandatory_once = PTHREAD_ONCE_INIT;
+
+/*!
+ * \internal
+ * \brief Determine if the ie is a codeset 0 variable length ie.
+ *
+ * \param full_ie Codeset and ie code to check.
+ *
+ * \retval TRUE if the ie can be in a struct q931_ie_set.
+ */
+static inline int q931_ie_set_member(int full_ie)
+{
+	return 0 <= full_ie && full_ie < 0x80;
+}
+
+/*! \brief Add the codeset 0 variable length ie to the set. */
+static inline void q931_ie_set_add(struct q931_ie_set *set, int full_ie)
+{
+	set->bits[full_ie / Q931_IE_SET_WORD_BITS] |= 1U << (full_ie % Q931_IE_SET_WORD_BITS);
+}
+
+/*! \brief Remove the codeset 0 variable length ie from the set. */
+static inline void q931_ie_set_remove(struct q931_ie_set *set, int full_ie)
+{
+	set->bits[full_ie / Q931_IE_SET_WORD_BITS] &= ~(1U << (full_ie % Q931_IE_SET_WORD_BITS));
+}
+
+/*! \brief Determine if the codeset 0 variable length ie is in the set. */
+static inline int q931_ie_set_test(const struct q931_ie_set *set, int full_ie)
+{
+	return (set->bits[full_ie / Q931_IE_SET_WORD_BITS] >> (full_ie % Q931_IE_SET_WORD_BITS)) & 1;
+}
+
+/*!
+ * \internal
+ * \brief Build the mandatory ie sets of each message type from msgs[].
+ *
+ * \return Nothing
+ */
+static void q931_msgs_mandatory_build(void)
+{
+	unsigned int x;
+	unsigned int y;
+
+	for (x = ARRAY_LEN(msgs); x--;) {
+		/* Go backwards so the first msgs[] entry of a message wins like a linear search. */
+		if (msgs[x].msgnum < 0 || ARRAY_LEN(msgs_mandatory) <= msgs[x].msgnum) {
+			continue;
+		}
+		memset(&msgs_mandatory[msgs[x].msgnum], 0, sizeof(msgs_mandatory[0]));
+		for (y = 0; y < ARRAY_LEN(msgs[x].mandies); ++y) {
+			if (msgs[x].mandies[y] && q931_ie_set_member(msgs[x].mandies[y])) {
+				q931_ie_set_add(&msgs_mandatory[msgs[x].msgnum], msgs[x].mandies[y]);
+			}
+		}
+	}
+}
+
+/*! Maximum number of optional ies a received message can defer decoding. */
+#define Q931_DEFERRED_IES_MAX	16
+
+/*! Offset index entry of an ie whose decoding was deferred. */
+struct q931_deferred_ie {
+	/*! Offset of the ie in the message ie data. */
+	unsigned short offset;
+	/*! Codeset the ie is in. */
+	unsigned short codeset;
+};
+
+/*!
+ * \internal
+ * \brief Determine if decoding the optional ie can be deferred.
+ *
+ * \param full_ie Codeset and ie code to check.
+ *
+ * \retval TRUE if the ie only feeds information reported by some messages.
+ */
+static int q931_ie_deferrable(int full_ie)
+{
+	switch (full_ie) {
+	case Q931_IE_USER_USER:
+	case Q931_IE_GENERIC_DIGITS:
+	case Q931_REDIRECTING_NUMBER:
+	case Q931_IE_ORIGINAL_CALLED_NUMBER:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/*!
+ * \internal
+ * \brief Determine if the message type reports the information of the deferrable ie.
+ *
+ * \param msgtype Q.931 message type received.
+ * \param full_ie Codeset and ie code of a deferrable ie.
+ *
+ * \retval TRUE if the ie must be decoded for this message.
+ */
+static int q931_ie_needed(int msgtype, int full_ie)
+{
+	switch (full_ie) {
+	case Q931_IE_USER_USER:
+		switch (msgtype) {
+		case Q931_SETUP:
+		case Q931_ALERTING:
+		case Q931_CONNECT:
+		case Q931_DISCONNECT:
+		case Q931_RELEASE:
+		case Q931_RELEASE_COMPLETE:
+			return 1;
+		default:
+			return 0;
+		}
+	case Q931_IE_GENERIC_DIGITS:
+	case Q931_REDIRECTING_NUMBER:
+	case Q931_IE_ORIGINAL_CALLED_NUMBER:
+		return msgtype == Q931_SETUP;
+	default:
+		return 1;
+	}
+}
+
 static int post_handle_q931_message(struct pri *ctrl, struct q931_mh *mh, struct q931_call *c, enum mandatory_ie_status mand_status);
 static void nt_ptmp_handle_q931_message(struct pri *ctrl, struct q931_mh *mh, struct q931_call *c, int *allow_event, int *allow_posthandle);
 
@@ -343,6 +478,204 @@ static int q931_encode_channel(const q931_call *call)
 		| held_call;
 }
 
+/*!
+ * \internal
+ * \brief Get the call pool hash bucket of the given call reference.
+ *
+ * \param index Call pool index.
+ * \param cr Call reference value.
+ *
+ * \return Head of the hash bucket list.
+ */
+static inline struct q931_call **q931_cr_bucket(struct q931_call_index *index, int cr)
+{
+	return &index->bucket[(unsigned) cr % Q931_CALL_HASH_BUCKETS];
+}
+
+/*!
+ * \internal
+ * \brief Mark our allocated call reference value as in use or not.
+ *
+ * \param index Call pool index.
+ * \param cr Call reference value.
+ * \param in_use TRUE if the value is now in use.
+ *
+ * \return Nothing
+ */
+static void q931_cref_mark(struct q931_call_index *index, int cr, int in_use)
+{
+	unsigned value;
+	unsigned long bit;
+
+	if (cr == Q931_DUMMY_CALL_REFERENCE || !(cr & Q931_CALL_REFERENCE_FLAG)) {
+		/* Not a call reference value we allocate. */
+		return;
+	}
+	value = cr & ~Q931_CALL_REFERENCE_FLAG & (Q931_MAX_CALL_REFERENCES - 1);
+	bit = 1UL << (value % (8 * sizeof(unsigned long)));
+	if (in_use) {
+		index->cref_used[value / (8 * sizeof(unsigned long))] |= bit;
+	} else {
+		index->cref_used[value / (8 * sizeof(unsigned long))] &= ~bit;
+	}
+}
+
+/*!
+ * \internal
+ * \brief Find an unused call reference value we can allocate.
+ *
+ * \param index Call pool index.
+ * \param start First call reference value to consider.
+ * \param max Maximum call reference value allowed.
+ *
+ * \return Unused call reference value in the range 1 to max.
+ * \retval 0 if all call reference values are in use.
+ */
+static int q931_cref_find_free(struct q931_call_index *index, int start, int max)
+{
+	unsigned bits_per_word = 8 * sizeof(unsigned long);
+	unsigned long word;
+	int value;
+	int count;
+
+	if (start < 1 || max < start) {
+		start = 1;
+	}
+	value = start;
+	for (count = max; 0 < count;) {
+		word = index->cref_used[value / bits_per_word];
+		if (word == ~0UL && !(value % bits_per_word)) {
+			/* Skip a whole word of in use values. */
+			value += bits_per_word;
+			count -= bits_per_word;
+		} else {
+			if (!(word & (1UL << (value % bits_per_word)))) {
+				return value;
+			}
+			++value;
+			--count;
+		}
+		if (max < value) {
+			/* Wrap around. */
+			value = 1;
+		}
+	}
+	return 0;
+}
+
+/*!
+ * \internal
+ * \brief Add the given call record to the call reference hash.
+ *
+ * \param index Call pool index.
+ * \param call Call record to add.
+ *
+ * \return Nothing
+ */
+static void q931_callpool_hash(struct q931_call_index *index, struct q931_call *call)
+{
+	struct q931_call **bucket;
+
+	/* Append to the hash bucket so lookups find calls in list order. */
+	call->hash_next = NULL;
+	for (bucket = q931_cr_bucket(index, call->cr); *bucket; bucket = &(*bucket)->hash_next) {
+	}
+	*bucket = call;
+	q931_cref_mark(index, call->cr, 1);
+}
+
+/*!
+ * \internal
+ * \brief Add the given call record to the call pool.
+ *
+ * \param ctrl D channel controller.
+ * \param call Call record to add.
+ *
+ * \return Nothing
+ */
+static void q931_callpool_add(struct pri *ctrl, struct q931_call *call)
+{
+	struct q931_call_index *index = ctrl->callindex;
+
+	/* Append to the list end */
+	call->next = NULL;
+	call->prev = index->tail;
+	if (index->tail) {
+		index->tail->next = call;
+	} else {
+		/* List was empty. */
+		*ctrl->callpool = call;
+	}
+	index->tail = call;
+
+	q931_callpool_hash(index, call);
+}
+
+/*!
+ * \internal
+ * \brief Remove the given call record from the call reference hash.
+ *
+ * \param index Call pool index.
+ * \param call Call record to remove.
+ *
+ * \retval TRUE if the call record was in the hash.
+ */
+static int q931_callpool_unhash(struct q931_call_index *index, struct q931_call *call)
+{
+	struct q931_call **bucket;
+	struct q931_call *cur;
+
+	for (bucket = q931_cr_bucket(index, call->cr); *bucket; bucket = &(*bucket)->hash_next) {
+		if (*bucket == call) {
+			*bucket = call->hash_next;
+			call->hash_next = NULL;
+
+			/* Release the call reference value if no other call is using it. */
+			for (cur = *q931_cr_bucket(index, call->cr); cur; cur = cur->hash_next) {
+				if (cur->cr == call->cr) {
+					break;
+				}
+			}
+			if (!cur) {
+				q931_cref_mark(index, call->cr, 0);
+			}
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*!
+ * \internal
+ * \brief Remove the given call record from the call pool.
+ *
+ * \param ctrl D channel controller.
+ * \param call Call record to remove.
+ *
+ * \retval TRUE if the call record was in the call pool.
+ */
+static int q931_callpool_remove(struct pri *ctrl, struct q931_call *call)
+{
+	struct q931_call_index *index = ctrl->callindex;
+
+	if (!q931_callpool_unhash(index, call)) {
+		return 0;
+	}
+	if (call->prev) {
+		call->prev->next = call->next;
+	} else {
+		*ctrl->callpool = call->next;
+	}
+	if (call->next) {
+		call->next->prev = call->prev;
+	} else {
+		index->tail = call->prev;
+	}
+	call->next = NULL;
+	call->prev = NULL;
+	return 1;
+}
+
 /*!
  * \brief Check if the given call ptr is valid.
  *
@@ -371,8 +704,13 @@ int q931_is_call_valid(struct pri *ctrl, struct q931_call *call)
 		ctrl = call->pri;
 	}
 
-	/* Check real call records. */
-	for (cur = *ctrl->callpool; cur; cur = cur->next) {
+	/*
+	 * Check real call records.
+	 *
+	 * A stale call ptr only gets us a wrong hash bucket since the
+	 * pointer itself is what must match.
+	 */
+	for (cur = *q931_cr_bucket(ctrl->callindex, call->cr); cur; cur = cur->hash_next) {
 		if (call == cur) {
 			/* Found it. */
 			return 1;
@@ -3138,9 +3476,13 @@ static int receive_facility(int full_ie, struct pri *ctrl, q931_call *call, int
 static int process_facility(struct pri *ctrl, q931_call *call, int msgtype, q931_ie *ie)
 {
 	struct fac_extension_header header;
-	struct rose_message rose;
+	struct rose_message *rose;
 	const unsigned char *pos;
 	const unsigned char *end;
+	struct asn1_string_views string_views;
+	struct asn1_string_views *saved_views;
+	size_t arena_mark;
+	int res;
 
 	pos = ie->data;
 	end = ie->data + ie->len;
@@ -3186,30 +3528,50 @@ static int process_facility(struct pri *ctrl, q931_call *call, int msgtype, q931
 		return -1;
 	}
 
-	/* Process all components in the facility. */
+	/*
+	 * Process all components in the facility.
+	 *
+	 * The ie stays valid while the components are handled so the
+	 * decoded party strings can be left in it instead of copied.
+	 */
+	saved_views = ctrl->rose_string_views;
+	ctrl->rose_string_views = &string_views;
+	arena_mark = ctrl->rose_arena.used;
+	res = 0;
 	while (pos < end) {
-		pos = rose_decode(ctrl, pos, end, &rose);
+		string_views.num_views = 0;
+		pos = rose_decode_arena(ctrl, pos, end, &rose);
 		if (!pos) {
-			return -1;
+			res = -1;
+			break;
 		}
-		switch (rose.type) {
+		switch (rose->type) {
 		case ROSE_COMP_TYPE_INVOKE:
-			rose_handle_invoke(ctrl, call, msgtype, ie, &header, &rose.component.invoke);
+			rose_handle_invoke(ctrl, call, msgtype, ie, &header, &rose->component.invoke);
 			break;
 		case ROSE_COMP_TYPE_RESULT:
-			rose_handle_result(ctrl, call, msgtype, ie, &header, &rose.component.result);
+			rose_handle_result(ctrl, call, msgtype, ie, &header, &rose->component.result);
 			break;
 		case ROSE_COMP_TYPE_ERROR:
-			rose_handle_error(ctrl, call, msgtype, ie, &header, &rose.component.error);
+			rose_handle_error(ctrl, call, msgtype, ie, &header, &rose->component.error);
 			break;
 		case ROSE_COMP_TYPE_REJECT:
-			rose_handle_reject(ctrl, call, msgtype, ie, &header, &rose.component.reject);
+			rose_handle_reject(ctrl, call, msgtype, ie, &header, &rose->component.reject);
 			break;
 		default:
-			return -1;
+			res = -1;
+			break;
 		}
+		if (res) {
+			break;
+		}
+
+		/* The component has been handled so its arena memory can be reused. */
+		ctrl->rose_arena.used = arena_mark;
 	}
-	return 0;
+	ctrl->rose_arena.used = arena_mark;
+	ctrl->rose_string_views = saved_views;
+	return res;
 }
 
 static void q931_handle_facilities(struct pri *ctrl, q931_call *call, int msgtype)
@@ -4214,10 +4576,49 @@ static struct ie ies[] = {
 	/* Codeset 7 */
 };
 
-static char *ie2str(int ie)
+/*! ies[] index + 1 of each full ie code.  (0 if the ie is not in ies[]) */
+static unsigned char ies_index[Q931_CODESET(8)];
+/*! Builds ies_index[] from ies[] once. */
+static pthread_once_t ies_index_once = PTHREAD_ONCE_INIT;
+
+/*!
+ * \internal
+ * \brief Build the direct lookup table of the ies[] table.
+ *
+ * \return Nothing
+ */
+static void q931_ies_index_build(void)
 {
 	unsigned int x;
 
+	for (x = ARRAY_LEN(ies); x--;) {
+		/* Go backwards so the first ies[] entry of an ie wins like a linear search. */
+		ies_index[ies[x].ie] = x + 1;
+	}
+}
+
+/*!
+ * \internal
+ * \brief Find the ies[] table index of the given ie.
+ *
+ * \param full_ie Codeset and ie code to find.
+ *
+ * \retval index of the ies[] entry on success.
+ * \retval -1 if the ie is not in the ies[] table.
+ */
+static int q931_ie_index(int full_ie)
+{
+	if (full_ie < 0 || ARRAY_LEN(ies_index) <= (unsigned int) full_ie) {
+		return -1;
+	}
+	pthread_once(&ies_index_once, q931_ies_index_build);
+	return (int) ies_index[full_ie] - 1;
+}
+
+static char *ie2str(int ie)
+{
+	int x;
+
 	/* Special handling for Locking/Non-Locking Shifts */
 	switch (ie & 0xf8) {
 	case Q931_LOCKING_SHIFT:
@@ -4267,10 +4668,9 @@ static char *ie2str(int ie)
 	default:
 		break;
 	}
-	for (x = 0; x < ARRAY_LEN(ies); ++x) {
-		if (ie == ies[x].ie) {
-			return ies[x].name;
-		}
+	x = q931_ie_index(ie);
+	if (0 <= x) {
+		return ies[x].name;
 	}
 	return "Unknown Information Element";
 }
@@ -4370,7 +4770,7 @@ static inline int q931_cr(q931_h *h)
 
 static inline void q931_dumpie(struct pri *ctrl, int codeset, q931_ie *ie, char prefix)
 {
-	unsigned int x;
+	int x;
 	int full_ie = Q931_FULL_IE(codeset, ie->ie);
 	int base_ie;
 	char *buf = malloc(ielen(ie) * 3 + 1);
@@ -4391,15 +4791,15 @@ static inline void q931_dumpie(struct pri *ctrl, int codeset, q931_ie *ie, char
 
 	base_ie = (((full_ie & ~0x7f) == Q931_FULL_IE(0, 0x80)) && ((full_ie & 0x70) != 0x20)) ? full_ie & ~0x0f : full_ie;
 
-	for (x = 0; x < ARRAY_LEN(ies); ++x)
-		if (ies[x].ie == base_ie) {
-			if (ies[x].dump)
-				ies[x].dump(full_ie, ctrl, ie, ielen(ie), prefix);
-			else
-				pri_message(ctrl, "%c IE: %s (len = %d)\n", prefix, ies[x].name, ielen(ie));
-			return;
-		}
-	
+	x = q931_ie_index(base_ie);
+	if (0 <= x) {
+		if (ies[x].dump)
+			ies[x].dump(full_ie, ctrl, ie, ielen(ie), prefix);
+		else
+			pri_message(ctrl, "%c IE: %s (len = %d)\n", prefix, ies[x].name, ielen(ie));
+		return;
+	}
+
 	pri_error(ctrl, "!! %c Unknown IE %d (cs%d, len = %d)\n", prefix, Q931_IE_IE(base_ie), Q931_IE_CODESET(base_ie), ielen(ie));
 }
 
@@ -4466,6 +4866,115 @@ void q931_init_call_record(struct q921_link *link, struct q931_call *call, int c
 	}
 }
 
+/*! Number of call records in each call record slab block. */
+#define Q931_CALL_SLAB_BLOCK_RECORDS	16
+
+struct q931_call_slab_block {
+	/*! Next allocated call record slab block. */
+	struct q931_call_slab_block *next;
+	/*! Call records in this block. */
+	struct q931_call call[Q931_CALL_SLAB_BLOCK_RECORDS];
+};
+
+/*!
+ * \brief Add free call records to the call record slab.
+ *
+ * \param slab Call record slab.
+ * \param count Minimum number of call records to add.
+ *
+ * \retval 0 on success.
+ * \retval -1 on error.
+ */
+int q931_call_slab_grow(struct q931_call_slab *slab, unsigned count)
+{
+	struct q931_call_slab_block *block;
+	unsigned idx;
+
+	while (count) {
+		block = calloc(1, sizeof(*block));
+		if (!block) {
+			return -1;
+		}
+		block->next = slab->blocks;
+		slab->blocks = block;
+		for (idx = 0; idx < ARRAY_LEN(block->call); ++idx) {
+			block->call[idx].next = slab->free_list;
+			slab->free_list = &block->call[idx];
+		}
+		slab->num_free += ARRAY_LEN(block->call);
+		count = (count < ARRAY_LEN(block->call)) ? 0 : count - ARRAY_LEN(block->call);
+	}
+	return 0;
+}
+
+/*!
+ * \brief Release all call record slab blocks.
+ *
+ * \param slab Call record slab.
+ *
+ * \return Nothing
+ */
+void q931_call_slab_destroy(struct q931_call_slab *slab)
+{
+	struct q931_call_slab_block *block;
+
+	while (slab->blocks) {
+		block = slab->blocks;
+		slab->blocks = block->next;
+		free(block);
+	}
+	slab->free_list = NULL;
+	slab->num_free = 0;
+}
+
+/*!
+ * \internal
+ * \brief Get a call record from the call record slab.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \note The call record contents are not initialized.
+ *
+ * \retval call on success.
+ * \retval NULL on error.
+ */
+static struct q931_call *q931_call_slab_alloc(struct pri *ctrl)
+{
+	struct q931_call_slab *slab = ctrl->callslab;
+	struct q931_call *call;
+
+	if (!slab->free_list && q931_call_slab_grow(slab, 1)) {
+		++slab->alloc_failures;
+		return NULL;
+	}
+	call = slab->free_list;
+	slab->free_list = call->next;
+	--slab->num_free;
+	if (slab->high_water < ++slab->num_used) {
+		slab->high_water = slab->num_used;
+	}
+	return call;
+}
+
+/*!
+ * \internal
+ * \brief Return a call record to the call record slab.
+ *
+ * \param ctrl D channel controller.
+ * \param call Call record to release.
+ *
+ * \return Nothing
+ */
+static void q931_call_slab_free(struct pri *ctrl, struct q931_call *call)
+{
+	struct q931_call_slab *slab = ctrl->callslab;
+
+	call->next = slab->free_list;
+	slab->free_list = call;
+	++slab->num_free;
+	--slab->num_used;
+}
+
 /*!
  * \internal
  * \brief Create a new call record.
@@ -4479,7 +4988,6 @@ void q931_init_call_record(struct q921_link *link, struct q931_call *call, int c
 static struct q931_call *q931_create_call_record(struct q921_link *link, int cr)
 {
 	struct q931_call *call;
-	struct q931_call *prev;
 	struct pri *ctrl;
 
 	ctrl = link->ctrl;
@@ -4488,24 +4996,16 @@ static struct q931_call *q931_create_call_record(struct q921_link *link, int cr)
 		pri_message(ctrl, "-- Making new call for cref %d\n", cr);
 	}
 
-	call = calloc(1, sizeof(*call));
+	call = q931_call_slab_alloc(ctrl);
 	if (!call) {
 		return NULL;
 	}
 
 	/* Initialize call structure. */
+	memset(call, 0, sizeof(*call));
 	q931_init_call_record(link, call, cr);
 
-	/* Append to the list end */
-	if (*ctrl->callpool) {
-		/* Find the list end. */
-		for (prev = *ctrl->callpool; prev->next; prev = prev->next) {
-		}
-		prev->next = call;
-	} else {
-		/* List was empty. */
-		*ctrl->callpool = call;
-	}
+	q931_callpool_add(ctrl, call);
 
 	return call;
 }
@@ -4539,14 +5039,14 @@ static struct q931_call *q931_find_call(struct q921_link *link, int cr)
 		}
 
 		/* We are looking for a call reference value that the other side allocated. */
-		for (cur = *ctrl->callpool; cur; cur = cur->next) {
+		for (cur = *q931_cr_bucket(ctrl->callindex, cr); cur; cur = cur->hash_next) {
 			if (cur->cr == cr && cur->link == link) {
 				/* Found existing call.  The call reference and link matched. */
 				break;
 			}
 		}
 	} else {
-		for (cur = *ctrl->callpool; cur; cur = cur->next) {
+		for (cur = *q931_cr_bucket(ctrl->callindex, cr); cur; cur = cur->hash_next) {
 			if (cur->cr == cr) {
 				/* Found existing call. */
 				switch (ctrl->switchtype) {
@@ -4604,43 +5104,26 @@ static struct q931_call *q931_getcall(struct q921_link *link, int cr)
  */
 struct q931_call *q931_new_call(struct pri *ctrl)
 {
-	struct q931_call *cur;
 	struct q921_link *link;
-	int first_cref;
+	int max_cref;
 	int cref;
 
 	/* Find a new call reference value. */
-	first_cref = ctrl->cref;
-	do {
-		cref = Q931_CALL_REFERENCE_FLAG | ctrl->cref;
-
-		/* Next call reference. */
-		++ctrl->cref;
-		if (!ctrl->bri) {
-			if (ctrl->cref > 32767) {
-				ctrl->cref = 1;
-			}
-		} else {
-			if (ctrl->cref > 127) {
-				ctrl->cref = 1;
-			}
-		}
+	max_cref = ctrl->bri ? 127 : 32767;
+	cref = q931_cref_find_free(ctrl->callindex, ctrl->cref, max_cref);
+	if (!cref) {
+		/* All call reference values are in use! */
+		return NULL;
+	}
 
-		/* Is the call reference value in use? */
-		for (cur = *ctrl->callpool; cur; cur = cur->next) {
-			if (cur->cr == cref) {
-				/* Yes it is in use. */
-				if (first_cref == ctrl->cref) {
-					/* All call reference values are in use! */
-					return NULL;
-				}
-				break;
-			}
-		}
-	} while (cur);
+	/* Next call reference. */
+	ctrl->cref = cref + 1;
+	if (ctrl->cref > max_cref) {
+		ctrl->cref = 1;
+	}
 
 	link = &ctrl->link;
-	return q931_create_call_record(link, cref);
+	return q931_create_call_record(link, Q931_CALL_REFERENCE_FLAG | cref);
 }
 
 static void stop_t303(struct q931_call *call);
@@ -4674,7 +5157,7 @@ static void cleanup_and_free_call(struct q931_call *cur)
 			cur->cc.record->signaling = NULL;
 		}
 	}
-	free(cur);
+	q931_call_slab_free(ctrl, cur);
 }
 
 int q931_get_subcall_count(struct q931_call *master)
@@ -4719,7 +5202,7 @@ static void pri_fake_clearing(struct q931_call *call)
 		call->cause = PRI_CAUSE_NO_USER_RESPONSE;
 	}
 	if (pri_internal_clear(call) == Q931_RES_HAVEEVENT) {
-		ctrl->schedev = 1;
+		pri_event_ready(ctrl);
 	}
 }
 
@@ -4807,7 +5290,6 @@ static void q931_destroy_subcall(struct q931_call *master, int idx)
 void q931_destroycall(struct pri *ctrl, q931_call *c)
 {
 	struct q931_call *cur;
-	struct q931_call *prev;
 	struct q931_call *slave;
 	int i;
 	int slavesleft;
@@ -4823,9 +5305,7 @@ void q931_destroycall(struct pri *ctrl, q931_call *c)
 		slave = NULL;
 	}
 
-	prev = NULL;
-	cur = *ctrl->callpool;
-	while (cur) {
+	for (cur = *q931_cr_bucket(ctrl->callindex, c->cr); cur; cur = cur->hash_next) {
 		if (cur == c) {
 			if (slave) {
 				/* Destroying a slave. */
@@ -4889,10 +5369,7 @@ void q931_destroycall(struct pri *ctrl, q931_call *c)
 			}
 
 			/* Master call or normal call destruction. */
-			if (prev)
-				prev->next = cur->next;
-			else
-				*ctrl->callpool = cur->next;
+			q931_callpool_remove(ctrl, cur);
 			if (ctrl->debug & PRI_DEBUG_Q931_STATE)
 				pri_message(ctrl,
 					"Destroying call %p, ourstate %s, peerstate %s, hold-state %s\n",
@@ -4903,20 +5380,19 @@ void q931_destroycall(struct pri *ctrl, q931_call *c)
 			cleanup_and_free_call(cur);
 			return;
 		}
-		prev = cur;
-		cur = cur->next;
 	}
 	pri_error(ctrl, "Can't destroy call %p cref:%d!\n", c, c->cr);
 }
 
 static int add_ie(struct pri *ctrl, q931_call *call, int msgtype, int ie, q931_ie *iet, int maxlen, int *codeset)
 {
-	unsigned int x;
+	int x;
 	int res, total_res;
 	int have_shift;
 	int ies_count, order;
 
-	for (x = 0; x < ARRAY_LEN(ies); ++x) {
+	x = q931_ie_index(ie);
+	if (0 <= x) {
 		if (ies[x].ie == ie) {
 			/* This is our baby */
 			if (ies[x].transmit) {
@@ -5078,6 +5554,10 @@ static void q931_to_q921_passing_dump(struct pri *ctrl, int tei, q931_h *h, int
 {
 	char c;
 
+	if (!pri_log_wanted(ctrl, PRI_LOG_MESSAGE)) {
+		return;
+	}
+
 	c = '>';
 
 	pri_message(ctrl, "\n");
@@ -5105,6 +5585,10 @@ void q931_dump(struct pri *ctrl, int tei, q931_h *h, int len, int txrx)
 	int cur_codeset;
 	int codeset;
 
+	if (!pri_log_wanted(ctrl, PRI_LOG_MESSAGE)) {
+		return;
+	}
+
 	c = txrx ? '>' : '<';
 
 	if (!(ctrl->debug & (PRI_DEBUG_Q921_DUMP | PRI_DEBUG_Q921_RAW))) {
@@ -5146,7 +5630,7 @@ void q931_dump(struct pri *ctrl, int tei, q931_h *h, int len, int txrx)
 
 static int q931_handle_ie(int codeset, struct pri *ctrl, q931_call *c, int msg, q931_ie *ie)
 {
-	unsigned int x;
+	int x;
 	int full_ie = Q931_FULL_IE(codeset, ie->ie);
 
 	if (ctrl->debug & PRI_DEBUG_Q931_STATE)
@@ -5178,15 +5662,14 @@ static int q931_handle_ie(int codeset, struct pri *ctrl, q931_call *c, int msg,
 			break;
 		}
 	}
-	for (x = 0; x < ARRAY_LEN(ies); ++x) {
-		if (full_ie == ies[x].ie) {
-			if (ies[x].receive)
-				return ies[x].receive(full_ie, ctrl, c, msg, ie, ielen(ie));
-			else {
-				if (ctrl->debug & PRI_DEBUG_Q931_ANOMALY)
-					pri_message(ctrl, "!! No handler for IE %d (cs%d, %s)\n", ie->ie, codeset, ie2str(full_ie));
-				return -1;
-			}
+	x = q931_ie_index(full_ie);
+	if (0 <= x) {
+		if (ies[x].receive)
+			return ies[x].receive(full_ie, ctrl, c, msg, ie, ielen(ie));
+		else {
+			if (ctrl->debug & PRI_DEBUG_Q931_ANOMALY)
+				pri_message(ctrl, "!! No handler for IE %d (cs%d, %s)\n", ie->ie, codeset, ie2str(full_ie));
+			return -1;
 		}
 	}
 	pri_message(ctrl, "!! Unknown IE %d (cs%d)\n", ie->ie, codeset);
@@ -5236,7 +5719,21 @@ static void init_header(struct pri *ctrl, q931_call *call, unsigned char *buf, q
 	*mhb = mh;
 }
 
-static void q931_xmit(struct q921_link *link, q931_h *h, int len, int cr, int uiframe)
+/*!
+ * \internal
+ * \brief Pass a Q.931 message to Q.921 for transmission.
+ *
+ * \param link Q.921 link to send the message on.
+ * \param f Leased I-frame the message was built in.  NULL if the message
+ * is elsewhere and must be copied.
+ * \param h Q.931 message to send.
+ * \param len Length of the message.
+ * \param cr TRUE if the message is a command.
+ * \param uiframe TRUE if the message is to be sent in a UI-frame.
+ *
+ * \return Nothing
+ */
+static void q931_xmit(struct q921_link *link, struct q921_frame *f, q931_h *h, int len, int cr, int uiframe)
 {
 	struct pri *ctrl;
 
@@ -5267,10 +5764,44 @@ static void q931_xmit(struct q921_link *link, q931_h *h, int len, int cr, int ui
 		if (ctrl->debug & PRI_DEBUG_Q931_DUMP) {
 			q931_to_q921_passing_dump(ctrl, link->tei, h, len);
 		}
-		q921_transmit_iframe(link, h, len, cr);
+		if (f) {
+			q921_transmit_leased_iframe(link, f, len, cr);
+		} else {
+			q921_transmit_iframe(link, h, len, cr);
+		}
 	}
 }
 
+/*!
+ * \internal
+ * \brief Get the most octets add_ie() can put in a message for the ie.
+ *
+ * \param call Q.931 call leg the message is for.
+ * \param msgtype Q.931 message type being built.
+ * \param ie Full ie code to add.
+ *
+ * \return Octets of room the ie could need.
+ */
+static int q931_ie_room(q931_call *call, int msgtype, int ie)
+{
+	struct apdu_event *cur;
+	int room;
+
+	if (ie != Q931_IE_FACILITY && ie != (Q931_IE_FACILITY | Q931_CODESET(6))) {
+		/* Shift, ie id, length, and the most contents the length octet allows. */
+		return 1 + 2 + 255;
+	}
+
+	/* Each waiting APDU for the message goes in its own facility ie. */
+	room = 1;
+	for (cur = call->apdus; cur; cur = cur->next) {
+		if (!cur->sent && (cur->message == msgtype || cur->message == Q931_ANY_MESSAGE)) {
+			room += 2 + cur->apdu_len;
+		}
+	}
+	return room;
+}
+
 /*!
  * \internal
  * \brief Build and send the requested message.
@@ -5289,8 +5820,11 @@ static void q931_xmit(struct q921_link *link, q931_h *h, int len, int cr, int ui
 static int send_message(struct pri *ctrl, q931_call *call, int msgtype, int ies[])
 {
 	unsigned char buf[1024];
+	struct q921_frame *f;
+	unsigned char *msg;
 	q931_h *h;
 	q931_mh *mh;
+	int size;
 	int len;
 	int res;
 	int offset=0;
@@ -5312,26 +5846,6 @@ static int send_message(struct pri *ctrl, q931_call *call, int msgtype, int ies[
 		return -1;
 	}
 
-	memset(buf, 0, sizeof(buf));
-	len = sizeof(buf);
-	init_header(ctrl, call, buf, &h, &mh, &len, (msgtype >> 8));
-	mh->msg = msgtype & 0x00ff;
-	x=0;
-	codeset = 0;
-	while(ies[x] > -1) {
-		res = add_ie(ctrl, call, mh->msg, ies[x], (q931_ie *)(mh->data + offset), len, &codeset);
-		if (res < 0) {
-			pri_error(ctrl, "!! Unable to add IE '%s'\n", ie2str(ies[x]));
-			return -1;
-		}
-
-		offset += res;
-		len -= res;
-		x++;
-	}
-	/* Invert the logic */
-	len = sizeof(buf) - len;
-
 	uiframe = 0;
 	if (BRI_NT_PTMP(ctrl)) {
 		/* NT PTMP is the only mode that can broadcast Q.931 messages. */
@@ -5367,14 +5881,71 @@ static int send_message(struct pri *ctrl, q931_call *call, int msgtype, int ies[
 		default:
 			break;
 		}
-		if (ctrl->debug & PRI_DEBUG_Q931_STATE) {
-			/* This message is only interesting for NT PTMP mode. */
-			pri_message(ctrl,
-				"Sending message for call %p on call->link: %p with TEI/SAPI %d/%d\n",
-				call, call->link, call->link->tei, call->link->sapi);
+	}
+
+	/*
+	 * Build an I-frame message in place in a free frame pool slot.
+	 * UI-frames are sent immediately so a copy of the message is fine.
+	 * Without a pool slot the message is built in buf and
+	 * q921_transmit_iframe() copies it into a frame of the right size.
+	 */
+	f = uiframe ? NULL : q921_iframe_lease(call->link);
+	if (f) {
+		msg = f->h.data;
+		size = Q921_FRAME_POOL_DATA_SIZE;
+	} else {
+		msg = buf;
+		size = sizeof(buf);
+	}
+
+	/*
+	 * The buffer is not zeroed.  init_header() fills in every header
+	 * octet and each ie transmit function writes every octet it claims
+	 * before the length is accounted for.
+	 */
+	len = size;
+	init_header(ctrl, call, msg, &h, &mh, &len, (msgtype >> 8));
+	mh->msg = msgtype & 0x00ff;
+	x=0;
+	codeset = 0;
+	while(ies[x] > -1) {
+		if (f && len < q931_ie_room(call, mh->msg, ies[x])) {
+			/*
+			 * The ie transmit functions do not all check the room left so
+			 * finish a message that may not fit the pool slot in buf.
+			 */
+			memcpy(buf, msg, size - len);
+			h = (q931_h *) buf;
+			mh = (q931_mh *) (buf + ((unsigned char *) mh - msg));
+			len += sizeof(buf) - size;
+			size = sizeof(buf);
+			msg = buf;
+			q921_iframe_lease_release(call->link, f);
+			f = NULL;
+		}
+		res = add_ie(ctrl, call, mh->msg, ies[x], (q931_ie *)(mh->data + offset), len, &codeset);
+		if (res < 0) {
+			pri_error(ctrl, "!! Unable to add IE '%s'\n", ie2str(ies[x]));
+			if (f) {
+				q921_iframe_lease_release(call->link, f);
+			}
+			return -1;
 		}
+
+		offset += res;
+		len -= res;
+		x++;
+	}
+	/* Invert the logic */
+	len = size - len;
+
+	if (BRI_NT_PTMP(ctrl) && (ctrl->debug & PRI_DEBUG_Q931_STATE)) {
+		/* This message is only interesting for NT PTMP mode. */
+		pri_message(ctrl,
+			"Sending message for call %p on call->link: %p with TEI/SAPI %d/%d\n",
+			call, call->link, call->link->tei, call->link->sapi);
 	}
-	q931_xmit(call->link, h, len, 1, uiframe);
+	q931_xmit(call->link, f, h, len, 1, uiframe);
 	call->acked = 1;
 	return 0;
 }
@@ -6043,7 +6614,6 @@ static void pri_release_finaltimeout(void *data)
 	c->ourcallstate = Q931_CALL_STATE_NULL;
 	c->peercallstate = Q931_CALL_STATE_NULL;
 	q931_clr_subcommands(ctrl);
-	ctrl->schedev = 1;
 	ctrl->ev.e = PRI_EVENT_HANGUP_ACK;
 	ctrl->ev.hangup.subcmds = &ctrl->subcmds;
 	ctrl->ev.hangup.channel = q931_encode_channel(c);
@@ -6054,6 +6624,7 @@ static void pri_release_finaltimeout(void *data)
 	ctrl->ev.hangup.call_held = NULL;
 	ctrl->ev.hangup.call_active = NULL;
 	libpri_copy_string(ctrl->ev.hangup.useruserinfo, c->useruserinfo, sizeof(ctrl->ev.hangup.useruserinfo));
+	pri_event_ready(ctrl);
 	pri_hangup(ctrl, c, c->cause);
 }
 
@@ -6696,12 +7267,12 @@ static void q931_hold_timeout(void *data)
 	}
 
 	q931_clr_subcommands(ctrl);
-	ctrl->schedev = 1;
 	ctrl->ev.e = PRI_EVENT_HOLD_REJ;
 	ctrl->ev.hold_rej.channel = q931_encode_channel(call);
 	ctrl->ev.hold_rej.call = master;
 	ctrl->ev.hold_rej.cause = PRI_CAUSE_MESSAGE_TYPE_NONEXIST;
 	ctrl->ev.hold_rej.subcmds = &ctrl->subcmds;
+	pri_event_ready(ctrl);
 }
 
 /*!
@@ -6903,12 +7474,12 @@ static void q931_retrieve_timeout(void *data)
 	}
 
 	q931_clr_subcommands(ctrl);
-	ctrl->schedev = 1;
 	ctrl->ev.e = PRI_EVENT_RETRIEVE_REJ;
 	ctrl->ev.retrieve_rej.channel = q931_encode_channel(call);
 	ctrl->ev.retrieve_rej.call = master;
 	ctrl->ev.retrieve_rej.cause = PRI_CAUSE_MESSAGE_TYPE_NONEXIST;
 	ctrl->ev.retrieve_rej.subcmds = &ctrl->subcmds;
+	pri_event_ready(ctrl);
 }
 
 /*!
@@ -7633,7 +8204,7 @@ static struct q931_call *q931_get_subcall(struct q921_link *link, struct q931_ca
 	}
 
 	/* Create new subcall. */
-	cur = malloc(sizeof(*cur));
+	cur = q931_call_slab_alloc(ctrl);
 	if (!cur) {
 		pri_error(ctrl, "Unable to allocate call\n");
 		return NULL;
@@ -7642,6 +8213,8 @@ static struct q931_call *q931_get_subcall(struct q921_link *link, struct q931_ca
 	//cur->pri = ctrl;/* We get this assignment for free. */
 	cur->link = link;
 	cur->next = NULL;
+	cur->prev = NULL;
+	cur->hash_next = NULL;
 	cur->apdus = NULL;
 	cur->bridged_call = NULL;
 	//cur->master_call = master_call; /* We get this assignment for free. */
@@ -7684,7 +8257,10 @@ int q931_receive(struct q921_link *link, q931_h *h, int len)
 	int y;
 	int res;
 	int r;
-	int mandies[MAX_MAND_IES];
+	struct q931_ie_set mandies;
+	struct q931_deferred_ie deferred[Q931_DEFERRED_IES_MAX];
+	unsigned int num_deferred;
+	unsigned int missing;
 	int is_mandatory;
 	int codeset, cur_codeset;
 	int last_ie[8];
@@ -7710,8 +8286,18 @@ int q931_receive(struct q921_link *link, q931_h *h, int len)
 			/* This is the weird maintenance stuff.  We majorly
 			   KLUDGE this by changing byte 4 from a 0xf (SERVICE)
 			   to a 0x7 (SERVICE ACKNOWLEDGE) */
-			h->raw[h->crlen + 2] -= 0x8;
-			q931_xmit(link, h, len, 1, 0);
+			if (len <= Q921_FRAME_POOL_DATA_SIZE) {
+				unsigned char buf[Q921_FRAME_POOL_DATA_SIZE];
+				struct q921_frame *f;
+				q931_h *ack;
+
+				/* Send back a modified copy.  The received frame is read only. */
+				f = q921_iframe_lease(link);
+				ack = (q931_h *) (f ? f->h.data : buf);
+				memcpy(ack, h, len);
+				ack->raw[ack->crlen + 2] -= 0x8;
+				q931_xmit(link, f, ack, len, 1, 0);
+			}
 			return 0;
 		}
 		break;
@@ -7772,28 +8358,18 @@ int q931_receive(struct q921_link *link, q931_h *h, int len)
 	q931_display_clear(c);
 
 	/* Determine which ies are mandatory for this message. */
-	memset(mandies, 0, sizeof(mandies));
-	for (x = 0; x < ARRAY_LEN(msgs); ++x)  {
-		if (msgs[x].msgnum == mh->msg) {
-			memcpy(mandies, msgs[x].mandies, sizeof(mandies));
-			break;
-		}
-	}
-	for (x = 0; x < ARRAY_LEN(mandies); ++x) {
-		if (mandies[x]) {
-			/* Check mandatory channel identification ie exceptions */
-			if (mandies[x] != Q931_CHANNEL_IDENT
-				/* Always mandatory for RESUME_ACKNOWLEDGE */
-				|| mh->msg == Q931_RESUME_ACKNOWLEDGE
-				/* Mandatory in Net -> CPE direction for SETUP */
-				|| (mh->msg == Q931_SETUP && ctrl->localtype == PRI_CPE)
-				/* Mandatory for first SETUP response message in Net -> CPE direction. */
-				|| c->channel_id_ie_mandatory) {
-				/* ie is mandatory for this message */
-				continue;
-			}
+	pthread_once(&msgs_mandatory_once, q931_msgs_mandatory_build);
+	mandies = msgs_mandatory[mh->msg];
+	if (q931_ie_set_test(&mandies, Q931_CHANNEL_IDENT)) {
+		/* Check mandatory channel identification ie exceptions */
+		if (!(/* Always mandatory for RESUME_ACKNOWLEDGE */
+			mh->msg == Q931_RESUME_ACKNOWLEDGE
+			/* Mandatory in Net -> CPE direction for SETUP */
+			|| (mh->msg == Q931_SETUP && ctrl->localtype == PRI_CPE)
+			/* Mandatory for first SETUP response message in Net -> CPE direction. */
+			|| c->channel_id_ie_mandatory)) {
 			/* ie is not mandatory for this message */
-			mandies[x] = 0;
+			q931_ie_set_remove(&mandies, Q931_CHANNEL_IDENT);
 		}
 	}
 	mand_status = MAND_STATUS_OK;
@@ -7801,6 +8377,7 @@ int q931_receive(struct q921_link *link, q931_h *h, int len)
 	/* Do real IE processing */
 	len -= (h->crlen + 3);
 	codeset = cur_codeset = 0;
+	num_deferred = 0;
 	for (x = 0; x < len; x += r) {
 		ie = (q931_ie *)(mh->data + x);
 		r = ielen_checked(ie, len - x);
@@ -7817,11 +8394,10 @@ int q931_receive(struct q921_link *link, q931_h *h, int len)
 
 		/* Check if processing a mandatory ie. */
 		is_mandatory = 0;
-		for (y = 0; y < ARRAY_LEN(mandies); ++y) {
-			if (mandies[y] == Q931_FULL_IE(cur_codeset, ie->ie)) {
-				mandies[y] = 0;
-				is_mandatory = 1;
-			}
+		y = Q931_FULL_IE(cur_codeset, ie->ie);
+		if (q931_ie_set_member(y) && q931_ie_set_test(&mandies, y)) {
+			q931_ie_set_remove(&mandies, y);
+			is_mandatory = 1;
 		}
 
 		/* Special processing for codeset shifts */
@@ -7865,6 +8441,15 @@ int q931_receive(struct q921_link *link, q931_h *h, int len)
 				}
 				/* Fall through */
 			default:
+				if (ctrl->lazy_ie_decode && !is_mandatory
+					&& q931_ie_deferrable(Q931_FULL_IE(cur_codeset, ie->ie))
+					&& num_deferred < ARRAY_LEN(deferred)) {
+					/* Decide whether to decode the ie after all ies are checked. */
+					deferred[num_deferred].offset = x;
+					deferred[num_deferred].codeset = cur_codeset;
+					++num_deferred;
+					break;
+				}
 				y = q931_handle_ie(cur_codeset, ctrl, c, mh->msg, ie);
 				if (y < 0 && is_mandatory) {
 					/* Error processing mandatory ie. */
@@ -7882,7 +8467,7 @@ int q931_receive(struct q921_link *link, q931_h *h, int len)
 					 * Unhandled ies in codeset 0 with the
 					 * upper nybble zero are mandatory.
 					 */
-					mandies[MAX_MAND_IES - 1] = Q931_FULL_IE(cur_codeset, ie->ie);
+					q931_ie_set_add(&mandies, Q931_FULL_IE(cur_codeset, ie->ie));
 				}
 				break;
 			}
@@ -7892,16 +8477,34 @@ int q931_receive(struct q921_link *link, q931_h *h, int len)
 		}
 	}
 
+	/* Decode the deferred optional ies this message reports. */
+	for (x = 0; x < num_deferred; ++x) {
+		ie = (q931_ie *) (mh->data + deferred[x].offset);
+		if (q931_ie_needed(mh->msg, Q931_FULL_IE(deferred[x].codeset, ie->ie))) {
+			q931_handle_ie(deferred[x].codeset, ctrl, c, mh->msg, ie);
+		} else if (ctrl->debug & PRI_DEBUG_Q931_STATE) {
+			pri_message(ctrl, "-- Not decoding IE %d (cs%d, %s) for %s\n", ie->ie,
+				deferred[x].codeset,
+				ie2str(Q931_FULL_IE(deferred[x].codeset, ie->ie)), msg2str(mh->msg));
+		}
+	}
+
 	/* Check for missing mandatory ies. */
-	for (x = 0; x < ARRAY_LEN(mandies); ++x) {
-		if (mandies[x]) {
-			/* This mandatory ie was not processed. */
-			mand_status = MAND_STATUS_MISSING;
-			pri_error(ctrl, "%s: Missing mandatory IE %d (cs%d, %s)\n",
-				msg2str(mh->msg),
-				Q931_IE_IE(mandies[x]),
-				Q931_IE_CODESET(mandies[x]),
-				ie2str(mandies[x]));
+	missing = 0;
+	for (x = 0; x < ARRAY_LEN(mandies.bits); ++x) {
+		missing |= mandies.bits[x];
+	}
+	if (missing) {
+		for (y = 0; y < 0x80; ++y) {
+			if (q931_ie_set_test(&mandies, y)) {
+				/* This mandatory ie was not processed. */
+				mand_status = MAND_STATUS_MISSING;
+				pri_error(ctrl, "%s: Missing mandatory IE %d (cs%d, %s)\n",
+					msg2str(mh->msg),
+					Q931_IE_IE(y),
+					Q931_IE_CODESET(y),
+					ie2str(y));
+			}
 		}
 	}
 
@@ -8500,7 +9103,7 @@ static void q931_apdu_timeout(void *data)
 	apdu->response.callback(APDU_CALLBACK_REASON_TIMEOUT, ctrl, call, apdu, NULL);
 	if (ctrl->subcmds.counter_subcmd) {
 		q931_fill_facility_event(ctrl, call);
-		ctrl->schedev = 1;
+		pri_event_ready(ctrl);
 	}
 
 	if (free_it) {
@@ -8533,7 +9136,7 @@ int q931_cc_timeout(struct pri *ctrl, struct pri_cc_record *cc_record, enum CC_E
 	fsm_complete = pri_cc_event(ctrl, call, cc_record, event);
 	if (ctrl->subcmds.counter_subcmd) {
 		q931_fill_facility_event(ctrl, dummy);
-		ctrl->schedev = 1;
+		pri_event_ready(ctrl);
 	}
 	return fsm_complete;
 }
@@ -8562,7 +9165,7 @@ void q931_cc_indirect(struct pri *ctrl, struct pri_cc_record *cc_record, void (*
 	func(ctrl, call, cc_record);
 	if (ctrl->subcmds.counter_subcmd) {
 		q931_fill_facility_event(ctrl, dummy);
-		ctrl->schedev = 1;
+		pri_event_ready(ctrl);
 	}
 }
 
@@ -8767,7 +9370,7 @@ static void q931_restart_notify_timeout(void *data)
 	call->channelno = call->restart.chan_no[call->restart.idx++];
 	ctrl->ev.e = PRI_EVENT_RESTART;
 	ctrl->ev.restart.channel = q931_encode_channel(call);
-	ctrl->schedev = 1;
+	pri_event_ready(ctrl);
 
 	/* Reschedule for next channel restart event needed. */
 	if (call->restart.idx < call->restart.count) {
@@ -9981,7 +10584,7 @@ static void pri_dl_down_timeout(void *data)
 	UPDATE_OURCALLSTATE(ctrl, c, Q931_CALL_STATE_NULL);
 	c->peercallstate = Q931_CALL_STATE_NULL;
 	if (pri_internal_clear(c) == Q931_RES_HAVEEVENT) {
-		ctrl->schedev = 1;
+		pri_event_ready(ctrl);
 	}
 }
 
@@ -10000,7 +10603,7 @@ static void pri_dl_down_cancelcall(void *data)
 	UPDATE_OURCALLSTATE(ctrl, c, Q931_CALL_STATE_NULL);
 	c->peercallstate = Q931_CALL_STATE_NULL;
 	if (pri_internal_clear(c) == Q931_RES_HAVEEVENT) {
-		ctrl->schedev = 1;
+		pri_event_ready(ctrl);
 	}
 }
 
@@ -10292,10 +10895,17 @@ int q931_call_getcrv(struct pri *ctrl, q931_call *call, int *callmode)
 
 int q931_call_setcrv(struct pri *ctrl, q931_call *call, int crv, int callmode)
 {
+	int indexed;
+
 	/* Do not allow changing the dummy call reference */
 	if (!q931_is_dummy_call(call)) {
+		/* The call must be rehashed under its new call reference. */
+		indexed = q931_callpool_unhash(ctrl->callindex, call);
 		call->cr = (crv << 3) & 0x7fff;
 		call->cr |= (callmode & 0x7);
+		if (indexed) {
+			q931_callpool_hash(ctrl->callindex, call);
+		}
 	}
 	return 0;
 }
@@ -32,7 +32,10 @@
  */
 
 
+#include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "compat.h"
 #include "libpri.h"
@@ -48,6 +51,15 @@
 #define ROSE_TAG_COMPONENT_ERROR	(ASN1_CLASS_CONTEXT_SPECIFIC | ASN1_PC_CONSTRUCTED | 3)
 #define ROSE_TAG_COMPONENT_REJECT	(ASN1_CLASS_CONTEXT_SPECIFIC | ASN1_PC_CONSTRUCTED | 4)
 
+/*! Alignment of the ROSE decode arena allocations. */
+#define ROSE_ARENA_ALIGN	16
+/*!
+ * Size of the controller ROSE decode arena.
+ * (process_facility() decodes one component at a time so one message fits all.)
+ */
+#define ROSE_ARENA_SIZE		\
+	((sizeof(struct rose_message) + ROSE_ARENA_ALIGN - 1) & ~(size_t) (ROSE_ARENA_ALIGN - 1))
+
 /*! \brief Structure to convert a code value to a string */
 struct rose_code_strings {
 	/*! \brief Code value to convert to a string */
@@ -133,6 +145,29 @@ struct rose_convert_msg {
 	const unsigned char *(*decode_result_args)(struct pri *ctrl, unsigned tag,
 		const unsigned char *pos, const unsigned char *end,
 		union rose_msg_result_args *args);
+
+	/*!
+	 * \brief Determine the encoded size of the ROSE invoke operation-value arguments.
+	 *
+	 * \param args Arguments to encode.
+	 *
+	 * \return Number of octets encode_invoke_args() will encode.
+	 *
+	 * \note The function pointer is NULL if the size is not known in advance.
+	 * The invoke component length then has to be fixed up after encoding.
+	 */
+	size_t (*size_invoke_args)(const union rose_msg_invoke_args *args);
+
+	/*!
+	 * \brief Description of the ROSE invoke operation-value arguments.
+	 * \note Used by the generic codec when the invoke argument functions are NULL.
+	 */
+	const struct rose_codec_field *invoke_args;
+	/*!
+	 * \brief Description of the ROSE result operation-value arguments.
+	 * \note Used by the generic codec when the result argument functions are NULL.
+	 */
+	const struct rose_codec_field *result_args;
 };
 
 /*! \brief ROSE error code conversion table entry. */
@@ -255,6 +290,8 @@ static const struct rose_convert_msg rose_etsi_msgs[] = {
  *		operation,                                  oid_prefix, value,
  *			encode_invoke_args,                     encode_result_args,
  *			decode_invoke_args,                     decode_result_args
+ *			size_invoke_args,
+ *			invoke_args,                            result_args
  */
 	/*
 	 * localValue's from Diversion-Operations
@@ -262,63 +299,87 @@ static const struct rose_convert_msg rose_etsi_msgs[] = {
 	 */
 	{
 		ROSE_ETSI_ActivationDiversion,				NULL, 7,
-			rose_enc_etsi_ActivationDiversion_ARG,	NULL,
-			rose_dec_etsi_ActivationDiversion_ARG,	NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_ActivationDiversion_ARG,NULL
 	},
 	{
 		ROSE_ETSI_DeactivationDiversion,			NULL, 8,
-			rose_enc_etsi_DeactivationDiversion_ARG,NULL,
-			rose_dec_etsi_DeactivationDiversion_ARG,NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_DeactivationDiversion_ARG,NULL
 	},
 	{
 		ROSE_ETSI_ActivationStatusNotificationDiv,	NULL, 9,
-			rose_enc_etsi_ActivationStatusNotificationDiv_ARG,NULL,
-			rose_dec_etsi_ActivationStatusNotificationDiv_ARG,NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_ActivationStatusNotificationDiv_ARG,NULL
 	},
 	{
 		ROSE_ETSI_DeactivationStatusNotificationDiv,NULL, 10,
-			rose_enc_etsi_DeactivationStatusNotificationDiv_ARG,NULL,
-			rose_dec_etsi_DeactivationStatusNotificationDiv_ARG,NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_DeactivationStatusNotificationDiv_ARG,NULL
 	},
 	{
 		ROSE_ETSI_InterrogationDiversion,			NULL, 11,
-			rose_enc_etsi_InterrogationDiversion_ARG,rose_enc_etsi_InterrogationDiversion_RES,
-			rose_dec_etsi_InterrogationDiversion_ARG,rose_dec_etsi_InterrogationDiversion_RES
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_InterrogationDiversion_ARG,&rose_codec_etsi_InterrogationDiversion_RES
 	},
 	{
 		ROSE_ETSI_DiversionInformation,				NULL, 12,
-			rose_enc_etsi_DiversionInformation_ARG,	NULL,
-			rose_dec_etsi_DiversionInformation_ARG,	NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_DiversionInformation_ARG,NULL
 	},
 	{
 		ROSE_ETSI_CallDeflection,					NULL, 13,
-			rose_enc_etsi_CallDeflection_ARG,		NULL,
-			rose_dec_etsi_CallDeflection_ARG,		NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_CallDeflection_ARG,	NULL
 	},
 	{
 		ROSE_ETSI_CallRerouting,					NULL, 14,
-			rose_enc_etsi_CallRerouting_ARG,		NULL,
-			rose_dec_etsi_CallRerouting_ARG,		NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_CallRerouting_ARG,		NULL
 	},
 	{
 		ROSE_ETSI_DivertingLegInformation2,			NULL, 15,
-			rose_enc_etsi_DivertingLegInformation2_ARG,NULL,
-			rose_dec_etsi_DivertingLegInformation2_ARG,NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_DivertingLegInformation2_ARG,NULL
 	},
 	{
 		ROSE_ETSI_InterrogateServedUserNumbers,		NULL, 17,
-			NULL,									rose_enc_etsi_InterrogateServedUserNumbers_RES,
-			NULL,									rose_dec_etsi_InterrogateServedUserNumbers_RES
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			NULL,									&rose_codec_etsi_InterrogateServedUserNumbers_RES
 	},
 	{
 		ROSE_ETSI_DivertingLegInformation1,			NULL, 18,
-			rose_enc_etsi_DivertingLegInformation1_ARG,NULL,
-			rose_dec_etsi_DivertingLegInformation1_ARG,NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_DivertingLegInformation1_ARG,NULL
 	},
 	{
 		ROSE_ETSI_DivertingLegInformation3,			NULL, 19,
-			rose_enc_etsi_DivertingLegInformation3_ARG,NULL,
-			rose_dec_etsi_DivertingLegInformation3_ARG,NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_DivertingLegInformation3_ARG,NULL
 	},
 
 	/*
@@ -331,38 +392,52 @@ static const struct rose_convert_msg rose_etsi_msgs[] = {
 	 */
 	{
 		ROSE_ETSI_ChargingRequest,					NULL, 30,
-			rose_enc_etsi_ChargingRequest_ARG,		rose_enc_etsi_ChargingRequest_RES,
-			rose_dec_etsi_ChargingRequest_ARG,		rose_dec_etsi_ChargingRequest_RES
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_ChargingRequest_ARG,	&rose_codec_etsi_ChargingRequest_RES
 	},
 	{
 		ROSE_ETSI_AOCSCurrency,						NULL, 31,
-			rose_enc_etsi_AOCSCurrency_ARG,			NULL,
-			rose_dec_etsi_AOCSCurrency_ARG,			NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_AOCSCurrency_ARG,		NULL
 	},
 	{
 		ROSE_ETSI_AOCSSpecialArr,					NULL, 32,
-			rose_enc_etsi_AOCSSpecialArr_ARG,		NULL,
-			rose_dec_etsi_AOCSSpecialArr_ARG,		NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_AOCSSpecialArr_ARG,	NULL
 	},
 	{
 		ROSE_ETSI_AOCDCurrency,						NULL, 33,
-			rose_enc_etsi_AOCDCurrency_ARG,			NULL,
-			rose_dec_etsi_AOCDCurrency_ARG,			NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_AOCDCurrency_ARG,		NULL
 	},
 	{
 		ROSE_ETSI_AOCDChargingUnit,					NULL, 34,
-			rose_enc_etsi_AOCDChargingUnit_ARG,		NULL,
-			rose_dec_etsi_AOCDChargingUnit_ARG,		NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_AOCDChargingUnit_ARG,	NULL
 	},
 	{
 		ROSE_ETSI_AOCECurrency,						NULL, 35,
-			rose_enc_etsi_AOCECurrency_ARG,			NULL,
-			rose_dec_etsi_AOCECurrency_ARG,			NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_AOCECurrency_ARG,		NULL
 	},
 	{
 		ROSE_ETSI_AOCEChargingUnit,					NULL, 36,
-			rose_enc_etsi_AOCEChargingUnit_ARG,		NULL,
-			rose_dec_etsi_AOCEChargingUnit_ARG,		NULL
+			NULL,									NULL,
+			NULL,									NULL,
+			NULL,
+			&rose_codec_etsi_AOCEChargingUnit_ARG,	NULL
 	},
 
 	/*
@@ -487,7 +562,8 @@ static const struct rose_convert_msg rose_etsi_msgs[] = {
 	{
 		ROSE_ETSI_CCBS_T_Request,					&rose_etsi_ccbs_t, 1,
 			rose_enc_etsi_CCBS_T_Request_ARG,		rose_enc_etsi_CCBS_T_Request_RES,
-			rose_dec_etsi_CCBS_T_Request_ARG,		rose_dec_etsi_CCBS_T_Request_RES
+			rose_dec_etsi_CCBS_T_Request_ARG,		rose_dec_etsi_CCBS_T_Request_RES,
+			rose_enc_etsi_CCBS_T_Request_ARG_size
 	},
 	{
 		ROSE_ETSI_CCBS_T_Call,						&rose_etsi_ccbs_t, 2,
@@ -537,7 +613,8 @@ static const struct rose_convert_msg rose_etsi_msgs[] = {
 	{
 		ROSE_ETSI_CCNR_T_Request,					&rose_etsi_ccnr_t, 1,
 			rose_enc_etsi_CCNR_T_Request_ARG,		rose_enc_etsi_CCNR_T_Request_RES,
-			rose_dec_etsi_CCNR_T_Request_ARG,		rose_dec_etsi_CCNR_T_Request_RES
+			rose_dec_etsi_CCNR_T_Request_ARG,		rose_dec_etsi_CCNR_T_Request_RES,
+			rose_enc_etsi_CCNR_T_Request_ARG_size
 	},
 
 	/*
@@ -783,6 +860,7 @@ static const struct rose_convert_msg rose_qsig_msgs[] = {
  *		operation,                                  oid_prefix, value,
  *			encode_invoke_args,                     encode_result_args,
  *			decode_invoke_args,                     decode_result_args
+ *			size_invoke_args
  */
 	/*
 	 * localValue's from Q.SIG Name-Operations 4th edition
@@ -965,17 +1043,20 @@ static const struct rose_convert_msg rose_qsig_msgs[] = {
 	{
 		ROSE_QSIG_DivertingLegInformation1,			NULL, 20,
 			rose_enc_qsig_DivertingLegInformation1_ARG,NULL,
-			rose_dec_qsig_DivertingLegInformation1_ARG,NULL
+			rose_dec_qsig_DivertingLegInformation1_ARG,NULL,
+			rose_enc_qsig_DivertingLegInformation1_ARG_size
 	},
 	{
 		ROSE_QSIG_DivertingLegInformation2,			NULL, 21,
 			rose_enc_qsig_DivertingLegInformation2_ARG,NULL,
-			rose_dec_qsig_DivertingLegInformation2_ARG,NULL
+			rose_dec_qsig_DivertingLegInformation2_ARG,NULL,
+			rose_enc_qsig_DivertingLegInformation2_ARG_size
 	},
 	{
 		ROSE_QSIG_DivertingLegInformation3,			NULL, 22,
 			rose_enc_qsig_DivertingLegInformation3_ARG,NULL,
-			rose_dec_qsig_DivertingLegInformation3_ARG,NULL
+			rose_dec_qsig_DivertingLegInformation3_ARG,NULL,
+			rose_enc_qsig_DivertingLegInformation3_ARG_size
 	},
 	{
 		ROSE_QSIG_CfnrDivertedLegFailed,			NULL, 23,
@@ -990,12 +1071,14 @@ static const struct rose_convert_msg rose_qsig_msgs[] = {
 	{
 		ROSE_QSIG_CcbsRequest,						NULL, 40,
 			rose_enc_qsig_CcbsRequest_ARG,			rose_enc_qsig_CcbsRequest_RES,
-			rose_dec_qsig_CcbsRequest_ARG,			rose_dec_qsig_CcbsRequest_RES
+			rose_dec_qsig_CcbsRequest_ARG,			rose_dec_qsig_CcbsRequest_RES,
+			rose_enc_qsig_CcbsRequest_ARG_size
 	},
 	{
 		ROSE_QSIG_CcnrRequest,						NULL, 27,
 			rose_enc_qsig_CcnrRequest_ARG,			rose_enc_qsig_CcnrRequest_RES,
-			rose_dec_qsig_CcnrRequest_ARG,			rose_dec_qsig_CcnrRequest_RES
+			rose_dec_qsig_CcnrRequest_ARG,			rose_dec_qsig_CcnrRequest_RES,
+			rose_enc_qsig_CcnrRequest_ARG_size
 	},
 	{
 		ROSE_QSIG_CcCancel,							NULL, 28,
@@ -1226,6 +1309,7 @@ static const struct rose_convert_msg rose_dms100_msgs[] = {
  *		operation,                                  oid_prefix, value,
  *			encode_invoke_args,                     encode_result_args,
  *			decode_invoke_args,                     decode_result_args
+ *			size_invoke_args
  */
 	{
 		ROSE_DMS100_RLT_OperationInd,				NULL, ROSE_DMS100_RLT_OPERATION_IND,
@@ -1319,6 +1403,7 @@ static const struct rose_convert_msg rose_ni2_msgs[] = {
  *		operation,                                  oid_prefix, value,
  *			encode_invoke_args,                     encode_result_args,
  *			decode_invoke_args,                     decode_result_args
+ *			size_invoke_args
  */
 	{
 		ROSE_NI2_InformationFollowing,				&rose_ni2_oid, 4,
@@ -1729,59 +1814,258 @@ const char *rose_reject2str(enum rose_reject_code code)
 	return rose_code2str(code, arr, ARRAY_LEN(arr));
 }
 
+/*! Most conversion table entries a ROSE dialect index can hold. */
+#define ROSE_DIALECT_ENTRIES_MAX	128
+
+/*! \brief Conversion tables of a ROSE dialect and their lookup indexes. */
+struct rose_dialect {
+	/*! \brief Invoke/result message conversion table */
+	const struct rose_convert_msg *msgs;
+	/*! \brief Number of entries in msgs[] */
+	size_t num_msgs;
+	/*! \brief Error code conversion table */
+	const struct rose_convert_error *errors;
+	/*! \brief Number of entries in errors[] */
+	size_t num_errors;
+	/*! \brief msgs[] index + 1 of each library operation code. (0 if not in the dialect) */
+	unsigned char msg_by_op[ROSE_Num_Operation_Codes];
+	/*! \brief errors[] index + 1 of each library error code. (0 if not in the dialect) */
+	unsigned char error_by_code[ROSE_ERROR_Num_Codes];
+	/*! \brief msgs[] indexes sorted by operation-value */
+	unsigned char msg_by_val[ROSE_DIALECT_ENTRIES_MAX];
+	/*! \brief errors[] indexes sorted by error-value */
+	unsigned char error_by_val[ROSE_DIALECT_ENTRIES_MAX];
+};
+
+/* Compile time checks that every conversion table fits in the dialect indexes. */
+typedef char rose_etsi_msgs_fit[(ARRAY_LEN(rose_etsi_msgs) <= ROSE_DIALECT_ENTRIES_MAX) ? 1 : -1];
+typedef char rose_etsi_errors_fit[(ARRAY_LEN(rose_etsi_errors) <= ROSE_DIALECT_ENTRIES_MAX) ? 1 : -1];
+typedef char rose_qsig_msgs_fit[(ARRAY_LEN(rose_qsig_msgs) <= ROSE_DIALECT_ENTRIES_MAX) ? 1 : -1];
+typedef char rose_qsig_errors_fit[(ARRAY_LEN(rose_qsig_errors) <= ROSE_DIALECT_ENTRIES_MAX) ? 1 : -1];
+typedef char rose_dms100_msgs_fit[(ARRAY_LEN(rose_dms100_msgs) <= ROSE_DIALECT_ENTRIES_MAX) ? 1 : -1];
+typedef char rose_dms100_errors_fit[(ARRAY_LEN(rose_dms100_errors) <= ROSE_DIALECT_ENTRIES_MAX) ? 1 : -1];
+typedef char rose_ni2_msgs_fit[(ARRAY_LEN(rose_ni2_msgs) <= ROSE_DIALECT_ENTRIES_MAX) ? 1 : -1];
+typedef char rose_ni2_errors_fit[(ARRAY_LEN(rose_ni2_errors) <= ROSE_DIALECT_ENTRIES_MAX) ? 1 : -1];
+
+static struct rose_dialect rose_etsi_dialect = {
+	.msgs = rose_etsi_msgs,
+	.num_msgs = ARRAY_LEN(rose_etsi_msgs),
+	.errors = rose_etsi_errors,
+	.num_errors = ARRAY_LEN(rose_etsi_errors),
+};
+
+static struct rose_dialect rose_qsig_dialect = {
+	.msgs = rose_qsig_msgs,
+	.num_msgs = ARRAY_LEN(rose_qsig_msgs),
+	.errors = rose_qsig_errors,
+	.num_errors = ARRAY_LEN(rose_qsig_errors),
+};
+
+static struct rose_dialect rose_dms100_dialect = {
+	.msgs = rose_dms100_msgs,
+	.num_msgs = ARRAY_LEN(rose_dms100_msgs),
+	.errors = rose_dms100_errors,
+	.num_errors = ARRAY_LEN(rose_dms100_errors),
+};
+
+static struct rose_dialect rose_ni2_dialect = {
+	.msgs = rose_ni2_msgs,
+	.num_msgs = ARRAY_LEN(rose_ni2_msgs),
+	.errors = rose_ni2_errors,
+	.num_errors = ARRAY_LEN(rose_ni2_errors),
+};
+
 /*!
  * \internal
- * \brief Find an operation message conversion entry using the operation code.
+ * \brief Compare an operation-value or error-value key with a conversion table entry.
  *
- * \param ctrl D channel controller for diagnostic messages or global options.
- * \param operation Library operation-value code.
+ * \param prefix OID prefix subidentifiers of the key.  (NULL if a localValue)
+ * \param num_prefix Number of OID prefix subidentifiers of the key.
+ * \param value Last OID value or localValue of the key.
+ * \param oid_prefix OID prefix of the table entry.  (NULL if a localValue)
+ * \param entry_value Last OID value or localValue of the table entry.
  *
- * \retval Message conversion entry on success.
- * \retval NULL on error.
+ * \note localValue entries sort before OID entries.
+ *
+ * \retval <0 if the key sorts before the entry.
+ * \retval 0 if the key matches the entry.
+ * \retval >0 if the key sorts after the entry.
  */
-static const struct rose_convert_msg *rose_find_msg_by_op_code(struct pri *ctrl,
-	enum rose_operation operation)
+static int rose_convert_val_cmp(const u_int16_t *prefix, unsigned num_prefix,
+	unsigned value, const struct asn1_oid *oid_prefix, unsigned entry_value)
 {
-	const struct rose_convert_msg *found;
-	const struct rose_convert_msg *table;
-	size_t num_entries;
+	unsigned sub_index;
+
+	if (!prefix != !oid_prefix) {
+		return prefix ? 1 : -1;
+	}
+	if (value != entry_value) {
+		return (value < entry_value) ? -1 : 1;
+	}
+	if (!prefix) {
+		return 0;
+	}
+	if (num_prefix != oid_prefix->num_values) {
+		return (num_prefix < oid_prefix->num_values) ? -1 : 1;
+	}
+	for (sub_index = 0; sub_index < num_prefix; ++sub_index) {
+		if (prefix[sub_index] != oid_prefix->value[sub_index]) {
+			return (prefix[sub_index] < oid_prefix->value[sub_index]) ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+/*!
+ * \internal
+ * \brief Build the lookup indexes of a ROSE dialect.
+ *
+ * \param dialect ROSE dialect to index.
+ *
+ * \note Equal entries keep their table order so a lookup finds the
+ * first one like a linear search of the table would.
+ *
+ * \return Nothing
+ */
+static void rose_dialect_build(struct rose_dialect *dialect)
+{
+	const struct asn1_oid *oid_prefix;
+	unsigned value;
 	size_t index;
+	size_t pos;
+
+	memset(dialect->msg_by_op, 0, sizeof(dialect->msg_by_op));
+	for (index = dialect->num_msgs; index--;) {
+		dialect->msg_by_op[dialect->msgs[index].operation] = index + 1;
+	}
+	memset(dialect->error_by_code, 0, sizeof(dialect->error_by_code));
+	for (index = dialect->num_errors; index--;) {
+		dialect->error_by_code[dialect->errors[index].code] = index + 1;
+	}
+
+	/* Insertion sort keeps equal entries in table order. */
+	for (index = 0; index < dialect->num_msgs; ++index) {
+		oid_prefix = dialect->msgs[index].oid_prefix;
+		value = dialect->msgs[index].value;
+		for (pos = index; pos; --pos) {
+			const struct rose_convert_msg *prev;
+
+			prev = &dialect->msgs[dialect->msg_by_val[pos - 1]];
+			if (rose_convert_val_cmp(oid_prefix ? oid_prefix->value : NULL,
+				oid_prefix ? oid_prefix->num_values : 0, value,
+				prev->oid_prefix, prev->value) >= 0) {
+				break;
+			}
+			dialect->msg_by_val[pos] = dialect->msg_by_val[pos - 1];
+		}
+		dialect->msg_by_val[pos] = index;
+	}
+	for (index = 0; index < dialect->num_errors; ++index) {
+		oid_prefix = dialect->errors[index].oid_prefix;
+		value = dialect->errors[index].value;
+		for (pos = index; pos; --pos) {
+			const struct rose_convert_error *prev;
+
+			prev = &dialect->errors[dialect->error_by_val[pos - 1]];
+			if (rose_convert_val_cmp(oid_prefix ? oid_prefix->value : NULL,
+				oid_prefix ? oid_prefix->num_values : 0, value,
+				prev->oid_prefix, prev->value) >= 0) {
+				break;
+			}
+			dialect->error_by_val[pos] = dialect->error_by_val[pos - 1];
+		}
+		dialect->error_by_val[pos] = index;
+	}
+}
+
+/*! Builds the lookup indexes of every ROSE dialect once. */
+static pthread_once_t rose_dialects_once = PTHREAD_ONCE_INIT;
+
+/*!
+ * \internal
+ * \brief Build the lookup indexes of every ROSE dialect.
+ *
+ * \return Nothing
+ */
+static void rose_dialects_build(void)
+{
+	rose_dialect_build(&rose_etsi_dialect);
+	rose_dialect_build(&rose_qsig_dialect);
+	rose_dialect_build(&rose_dms100_dialect);
+	rose_dialect_build(&rose_ni2_dialect);
+}
+
+/*!
+ * \internal
+ * \brief Get the ROSE dialect of the controller.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ *
+ * \note The dialect is resolved once and cached on the controller.
+ *
+ * \retval ROSE dialect on success.
+ * \retval NULL if the switch type does not support ROSE.
+ */
+static const struct rose_dialect *rose_dialect_get(struct pri *ctrl)
+{
+	struct rose_dialect *dialect;
+
+	if (ctrl->rose_dialect_switchtype == ctrl->switchtype) {
+		return ctrl->rose_dialect;
+	}
 
-	/* Determine which message conversion table to use */
+	/* Determine which conversion tables to use */
 	switch (ctrl->switchtype) {
 	case PRI_SWITCH_EUROISDN_T1:
 	case PRI_SWITCH_EUROISDN_E1:
-		table = rose_etsi_msgs;
-		num_entries = ARRAY_LEN(rose_etsi_msgs);
+		dialect = &rose_etsi_dialect;
 		break;
 	case PRI_SWITCH_QSIG:
-		table = rose_qsig_msgs;
-		num_entries = ARRAY_LEN(rose_qsig_msgs);
+		dialect = &rose_qsig_dialect;
 		break;
 	case PRI_SWITCH_DMS100:
-		table = rose_dms100_msgs;
-		num_entries = ARRAY_LEN(rose_dms100_msgs);
+		dialect = &rose_dms100_dialect;
 		break;
 	case PRI_SWITCH_ATT4ESS:
 	case PRI_SWITCH_LUCENT5E:
 	case PRI_SWITCH_NI2:
-		table = rose_ni2_msgs;
-		num_entries = ARRAY_LEN(rose_ni2_msgs);
+		dialect = &rose_ni2_dialect;
 		break;
 	default:
-		return NULL;
+		dialect = NULL;
+		break;
 	}
-
-	/* Search for the table entry */
-	found = NULL;
-	for (index = 0; index < num_entries; ++index) {
-		if (table[index].operation == operation) {
-			found = &table[index];
-			break;
-		}
+	if (dialect) {
+		pthread_once(&rose_dialects_once, rose_dialects_build);
 	}
 
-	return found;
+	ctrl->rose_dialect = dialect;
+	ctrl->rose_dialect_switchtype = ctrl->switchtype;
+	return dialect;
+}
+
+/*!
+ * \internal
+ * \brief Find an operation message conversion entry using the operation code.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param operation Library operation-value code.
+ *
+ * \retval Message conversion entry on success.
+ * \retval NULL on error.
+ */
+static const struct rose_convert_msg *rose_find_msg_by_op_code(struct pri *ctrl,
+	enum rose_operation operation)
+{
+	const struct rose_dialect *dialect;
+	unsigned index;
+
+	dialect = rose_dialect_get(ctrl);
+	if (!dialect || (unsigned) operation >= ROSE_Num_Operation_Codes) {
+		return NULL;
+	}
+	index = dialect->msg_by_op[operation];
+	return index ? &dialect->msgs[index - 1] : NULL;
 }
 
 /*!
@@ -1799,70 +2083,50 @@ static const struct rose_convert_msg *rose_find_msg_by_op_code(struct pri *ctrl,
 static const struct rose_convert_msg *rose_find_msg_by_op_val(struct pri *ctrl,
 	const struct asn1_oid *oid, unsigned local)
 {
-	const struct rose_convert_msg *found;
-	const struct rose_convert_msg *table;
-	size_t num_entries;
-	size_t index;
-	int sub_index;
-
-	/* Determine which message conversion table to use */
-	switch (ctrl->switchtype) {
-	case PRI_SWITCH_EUROISDN_T1:
-	case PRI_SWITCH_EUROISDN_E1:
-		table = rose_etsi_msgs;
-		num_entries = ARRAY_LEN(rose_etsi_msgs);
-		break;
-	case PRI_SWITCH_QSIG:
-		table = rose_qsig_msgs;
-		num_entries = ARRAY_LEN(rose_qsig_msgs);
-		break;
-	case PRI_SWITCH_DMS100:
-		table = rose_dms100_msgs;
-		num_entries = ARRAY_LEN(rose_dms100_msgs);
-		break;
-	case PRI_SWITCH_ATT4ESS:
-	case PRI_SWITCH_LUCENT5E:
-	case PRI_SWITCH_NI2:
-		table = rose_ni2_msgs;
-		num_entries = ARRAY_LEN(rose_ni2_msgs);
-		break;
-	default:
+	const struct rose_dialect *dialect;
+	const struct rose_convert_msg *entry;
+	const u_int16_t *prefix;
+	unsigned num_prefix;
+	size_t low;
+	size_t high;
+	size_t mid;
+
+	dialect = rose_dialect_get(ctrl);
+	if (!dialect) {
 		return NULL;
 	}
-
-	/* Search for the table entry */
-	found = NULL;
 	if (oid) {
 		/* Search for an OID entry */
-		local = oid->value[oid->num_values - 1];
-		for (index = 0; index < num_entries; ++index) {
-			if (table[index].value == local && table[index].oid_prefix
-				&& table[index].oid_prefix->num_values == oid->num_values - 1) {
-				/* Now lets match the OID prefix subidentifiers */
-				for (sub_index = oid->num_values - 2; 0 <= sub_index; --sub_index) {
-					if (oid->value[sub_index]
-						!= table[index].oid_prefix->value[sub_index]) {
-						break;
-					}
-				}
-				if (sub_index == -1) {
-					/* All of the OID subidentifiers matched */
-					found = &table[index];
-					break;
-				}
-			}
-		}
+		prefix = oid->value;
+		num_prefix = oid->num_values - 1;
+		local = oid->value[num_prefix];
 	} else {
 		/* Search for a localValue entry */
-		for (index = 0; index < num_entries; ++index) {
-			if (table[index].value == local && !table[index].oid_prefix) {
-				found = &table[index];
-				break;
-			}
-		}
+		prefix = NULL;
+		num_prefix = 0;
 	}
 
-	return found;
+	/* Binary search for the first matching entry */
+	low = 0;
+	high = dialect->num_msgs;
+	while (low < high) {
+		mid = (low + high) / 2;
+		entry = &dialect->msgs[dialect->msg_by_val[mid]];
+		if (rose_convert_val_cmp(prefix, num_prefix, local, entry->oid_prefix,
+			entry->value) > 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	if (low < dialect->num_msgs) {
+		entry = &dialect->msgs[dialect->msg_by_val[low]];
+		if (!rose_convert_val_cmp(prefix, num_prefix, local, entry->oid_prefix,
+			entry->value)) {
+			return entry;
+		}
+	}
+	return NULL;
 }
 
 /*!
@@ -1878,46 +2142,15 @@ static const struct rose_convert_msg *rose_find_msg_by_op_val(struct pri *ctrl,
 static const struct rose_convert_error *rose_find_error_by_op_code(struct pri *ctrl,
 	enum rose_error_code code)
 {
-	const struct rose_convert_error *found;
-	const struct rose_convert_error *table;
-	size_t num_entries;
-	size_t index;
+	const struct rose_dialect *dialect;
+	unsigned index;
 
-	/* Determine which error conversion table to use */
-	switch (ctrl->switchtype) {
-	case PRI_SWITCH_EUROISDN_T1:
-	case PRI_SWITCH_EUROISDN_E1:
-		table = rose_etsi_errors;
-		num_entries = ARRAY_LEN(rose_etsi_errors);
-		break;
-	case PRI_SWITCH_QSIG:
-		table = rose_qsig_errors;
-		num_entries = ARRAY_LEN(rose_qsig_errors);
-		break;
-	case PRI_SWITCH_DMS100:
-		table = rose_dms100_errors;
-		num_entries = ARRAY_LEN(rose_dms100_errors);
-		break;
-	case PRI_SWITCH_ATT4ESS:
-	case PRI_SWITCH_LUCENT5E:
-	case PRI_SWITCH_NI2:
-		table = rose_ni2_errors;
-		num_entries = ARRAY_LEN(rose_ni2_errors);
-		break;
-	default:
+	dialect = rose_dialect_get(ctrl);
+	if (!dialect || (unsigned) code >= ROSE_ERROR_Num_Codes) {
 		return NULL;
 	}
-
-	/* Search for the table entry */
-	found = NULL;
-	for (index = 0; index < num_entries; ++index) {
-		if (table[index].code == code) {
-			found = &table[index];
-			break;
-		}
-	}
-
-	return found;
+	index = dialect->error_by_code[code];
+	return index ? &dialect->errors[index - 1] : NULL;
 }
 
 /*!
@@ -1935,70 +2168,222 @@ static const struct rose_convert_error *rose_find_error_by_op_code(struct pri *c
 static const struct rose_convert_error *rose_find_error_by_op_val(struct pri *ctrl,
 	const struct asn1_oid *oid, unsigned local)
 {
-	const struct rose_convert_error *found;
-	const struct rose_convert_error *table;
-	size_t num_entries;
-	size_t index;
-	int sub_index;
-
-	/* Determine which error conversion table to use */
-	switch (ctrl->switchtype) {
-	case PRI_SWITCH_EUROISDN_T1:
-	case PRI_SWITCH_EUROISDN_E1:
-		table = rose_etsi_errors;
-		num_entries = ARRAY_LEN(rose_etsi_errors);
-		break;
-	case PRI_SWITCH_QSIG:
-		table = rose_qsig_errors;
-		num_entries = ARRAY_LEN(rose_qsig_errors);
-		break;
-	case PRI_SWITCH_DMS100:
-		table = rose_dms100_errors;
-		num_entries = ARRAY_LEN(rose_dms100_errors);
-		break;
-	case PRI_SWITCH_ATT4ESS:
-	case PRI_SWITCH_LUCENT5E:
-	case PRI_SWITCH_NI2:
-		table = rose_ni2_errors;
-		num_entries = ARRAY_LEN(rose_ni2_errors);
-		break;
-	default:
+	const struct rose_dialect *dialect;
+	const struct rose_convert_error *entry;
+	const u_int16_t *prefix;
+	unsigned num_prefix;
+	size_t low;
+	size_t high;
+	size_t mid;
+
+	dialect = rose_dialect_get(ctrl);
+	if (!dialect) {
 		return NULL;
 	}
-
-	/* Search for the table entry */
-	found = NULL;
 	if (oid) {
 		/* Search for an OID entry */
-		local = oid->value[oid->num_values - 1];
-		for (index = 0; index < num_entries; ++index) {
-			if (table[index].value == local && table[index].oid_prefix
-				&& table[index].oid_prefix->num_values == oid->num_values - 1) {
-				/* Now lets match the OID prefix subidentifiers */
-				for (sub_index = oid->num_values - 2; 0 <= sub_index; --sub_index) {
-					if (oid->value[sub_index]
-						!= table[index].oid_prefix->value[sub_index]) {
-						break;
-					}
-				}
-				if (sub_index == -1) {
-					/* All of the OID subidentifiers matched */
-					found = &table[index];
-					break;
-				}
-			}
-		}
+		prefix = oid->value;
+		num_prefix = oid->num_values - 1;
+		local = oid->value[num_prefix];
 	} else {
 		/* Search for a localValue entry */
-		for (index = 0; index < num_entries; ++index) {
-			if (table[index].value == local && !table[index].oid_prefix) {
-				found = &table[index];
+		prefix = NULL;
+		num_prefix = 0;
+	}
+
+	/* Binary search for the first matching entry */
+	low = 0;
+	high = dialect->num_errors;
+	while (low < high) {
+		mid = (low + high) / 2;
+		entry = &dialect->errors[dialect->error_by_val[mid]];
+		if (rose_convert_val_cmp(prefix, num_prefix, local, entry->oid_prefix,
+			entry->value) > 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	if (low < dialect->num_errors) {
+		entry = &dialect->errors[dialect->error_by_val[low]];
+		if (!rose_convert_val_cmp(prefix, num_prefix, local, entry->oid_prefix,
+			entry->value)) {
+			return entry;
+		}
+	}
+	return NULL;
+}
+
+/*!
+ * \internal
+ * \brief Determine if a conversion table entry has the given operation-value or error-value.
+ *
+ * \param oid Full OID to match if not NULL.
+ * \param local localValue to match if OID is NULL.
+ * \param oid_prefix OID prefix of the table entry.  (NULL if a localValue)
+ * \param value Last OID value or localValue of the table entry.
+ *
+ * \retval TRUE if the entry matches.
+ */
+static int rose_check_val_match(const struct asn1_oid *oid, unsigned local,
+	const struct asn1_oid *oid_prefix, unsigned value)
+{
+	if (!oid) {
+		return !oid_prefix && value == local;
+	}
+	return oid_prefix && oid->num_values == oid_prefix->num_values + 1
+		&& !memcmp(oid->value, oid_prefix->value,
+			oid_prefix->num_values * sizeof(oid->value[0]))
+		&& oid->value[oid_prefix->num_values] == value;
+}
+
+/*!
+ * \internal
+ * \brief Check the message lookups of one key against a linear search of the table.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param dialect ROSE dialect of the controller.
+ * \param oid Full OID key if not NULL.
+ * \param local localValue key if OID is NULL.
+ *
+ * \retval TRUE if the indexed lookups disagree with the linear search.
+ */
+static int rose_check_val_lookup(struct pri *ctrl, const struct rose_dialect *dialect,
+	const struct asn1_oid *oid, unsigned local)
+{
+	const struct rose_convert_msg *msg;
+	const struct rose_convert_error *error;
+	size_t index;
+	int failed;
+
+	failed = 0;
+
+	msg = NULL;
+	for (index = 0; index < dialect->num_msgs; ++index) {
+		if (rose_check_val_match(oid, local, dialect->msgs[index].oid_prefix,
+			dialect->msgs[index].value)) {
+			msg = &dialect->msgs[index];
+			break;
+		}
+	}
+	if (msg != rose_find_msg_by_op_val(ctrl, oid, local)) {
+		pri_error(ctrl, "Operation-value %s%u lookup does not match the table\n",
+			oid ? "OID " : "", oid ? oid->value[oid->num_values - 1] : local);
+		failed = 1;
+	}
+
+	error = NULL;
+	for (index = 0; index < dialect->num_errors; ++index) {
+		if (rose_check_val_match(oid, local, dialect->errors[index].oid_prefix,
+			dialect->errors[index].value)) {
+			error = &dialect->errors[index];
+			break;
+		}
+	}
+	if (error != rose_find_error_by_op_val(ctrl, oid, local)) {
+		pri_error(ctrl, "Error-value %s%u lookup does not match the table\n",
+			oid ? "OID " : "", oid ? oid->value[oid->num_values - 1] : local);
+		failed = 1;
+	}
+
+	return failed;
+}
+
+/*!
+ * \internal
+ * \brief Check the lookups of a conversion table entry key.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param dialect ROSE dialect of the controller.
+ * \param oid_prefix OID prefix of the table entry.  (NULL if a localValue)
+ * \param value Last OID value or localValue of the table entry.
+ *
+ * \return Number of lookups that disagree with a linear search of the tables.
+ */
+static unsigned rose_check_entry_lookup(struct pri *ctrl,
+	const struct rose_dialect *dialect, const struct asn1_oid *oid_prefix, unsigned value)
+{
+	struct asn1_oid oid;
+	unsigned failed;
+
+	/* The value as a localValue whether or not the entry is an OID. */
+	failed = rose_check_val_lookup(ctrl, dialect, NULL, value);
+	if (oid_prefix) {
+		oid = *oid_prefix;
+		oid.value[oid.num_values++] = value;
+		failed += rose_check_val_lookup(ctrl, dialect, &oid, value);
+	}
+	return failed;
+}
+
+/*!
+ * \brief Check the ROSE dialect lookup indexes of the controller.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ *
+ * \details
+ * Every library operation and error code and the operation-value and
+ * error-value of every conversion table entry, both as an OID and as a
+ * localValue, is looked up with the indexes and with a linear search of
+ * the conversion tables.
+ *
+ * \retval Number of lookups that found a different entry.
+ * \retval -1 if the switch type does not support ROSE.
+ */
+int rose_dialect_check(struct pri *ctrl)
+{
+	const struct rose_dialect *dialect;
+	const struct rose_convert_msg *msg;
+	const struct rose_convert_error *error;
+	unsigned failed;
+	unsigned code;
+	size_t index;
+
+	dialect = rose_dialect_get(ctrl);
+	if (!dialect) {
+		return -1;
+	}
+	failed = 0;
+
+	for (code = 0; code < ROSE_Num_Operation_Codes; ++code) {
+		msg = NULL;
+		for (index = 0; index < dialect->num_msgs; ++index) {
+			if (dialect->msgs[index].operation == code) {
+				msg = &dialect->msgs[index];
 				break;
 			}
 		}
+		if (msg != rose_find_msg_by_op_code(ctrl, code)) {
+			pri_error(ctrl, "Operation %s lookup does not match the table\n",
+				rose_operation2str(code));
+			++failed;
+		}
+	}
+	for (code = 0; code < ROSE_ERROR_Num_Codes; ++code) {
+		error = NULL;
+		for (index = 0; index < dialect->num_errors; ++index) {
+			if (dialect->errors[index].code == code) {
+				error = &dialect->errors[index];
+				break;
+			}
+		}
+		if (error != rose_find_error_by_op_code(ctrl, code)) {
+			pri_error(ctrl, "Error %s lookup does not match the table\n",
+				rose_error2str(code));
+			++failed;
+		}
+	}
+
+	for (index = 0; index < dialect->num_msgs; ++index) {
+		failed += rose_check_entry_lookup(ctrl, dialect, dialect->msgs[index].oid_prefix,
+			dialect->msgs[index].value);
+	}
+	for (index = 0; index < dialect->num_errors; ++index) {
+		failed += rose_check_entry_lookup(ctrl, dialect,
+			dialect->errors[index].oid_prefix, dialect->errors[index].value);
 	}
 
-	return found;
+	return failed;
 }
 
 /*!
@@ -2031,6 +2416,34 @@ static unsigned char *rose_enc_operation_value(unsigned char *pos, unsigned char
 	}
 }
 
+/*!
+ * \internal
+ * \brief Determine the encoded size of the Facility ie component operation-value.
+ *
+ * \param oid_prefix Encode as an OID if not NULL.
+ * \param local Encode as a localValue if oid_prefix is NULL
+ * else it is the last OID subidentifier.
+ *
+ * \return Number of octets rose_enc_operation_value() will encode.
+ */
+static size_t rose_enc_operation_value_size(const struct asn1_oid *oid_prefix,
+	unsigned local)
+{
+	struct asn1_oid oid;
+
+	if (oid_prefix) {
+		if (ARRAY_LEN(oid_prefix->value) <= oid_prefix->num_values) {
+			/* rose_enc_operation_value() will fail */
+			return 0;
+		}
+		oid = *oid_prefix;
+		oid.value[oid.num_values++] = local;
+		return asn1_enc_oid_size(&oid);
+	} else {
+		return asn1_enc_int_size(local);
+	}
+}
+
 /*! \brief Mapped to rose_enc_operation_value() */
 #define rose_enc_error_value(pos, end, oid_prefix, local)	\
 	rose_enc_operation_value(pos, end, oid_prefix, local)
@@ -2051,13 +2464,39 @@ unsigned char *rose_encode_invoke(struct pri *ctrl, unsigned char *pos,
 {
 	const struct rose_convert_msg *convert;
 	unsigned char *seq_len;
+	unsigned char *seq_end;
+	size_t seq_length;
+	size_t args_length;
 
 	convert = rose_find_msg_by_op_code(ctrl, msg->operation);
 	if (!convert) {
 		return NULL;
 	}
 
-	ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, ROSE_TAG_COMPONENT_INVOKE);
+	if (convert->size_invoke_args) {
+		args_length = convert->size_invoke_args(&msg->args);
+	} else if (convert->invoke_args) {
+		/* Zero if a described component cannot be sized in advance. */
+		args_length = rose_codec_size(convert->invoke_args, &msg->args);
+	} else {
+		args_length = 0;
+	}
+
+	if (args_length) {
+		/* Encode the final component length up front. */
+		seq_length = asn1_enc_int_size(msg->invoke_id)
+			+ rose_enc_operation_value_size(convert->oid_prefix, convert->value)
+			+ args_length;
+		if (msg->linked_id_present) {
+			seq_length += asn1_enc_int_size(msg->linked_id);
+		}
+		ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, ROSE_TAG_COMPONENT_INVOKE,
+			seq_length);
+		seq_len = NULL;
+	} else {
+		ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, ROSE_TAG_COMPONENT_INVOKE);
+		seq_end = NULL;
+	}
 
 	ASN1_CALL(pos, asn1_enc_int(pos, end, ASN1_TYPE_INTEGER, msg->invoke_id));
 	if (msg->linked_id_present) {
@@ -2069,9 +2508,16 @@ unsigned char *rose_encode_invoke(struct pri *ctrl, unsigned char *pos,
 
 	if (convert->encode_invoke_args) {
 		ASN1_CALL(pos, convert->encode_invoke_args(ctrl, pos, end, &msg->args));
+	} else if (convert->invoke_args) {
+		ASN1_CALL(pos, rose_codec_encode(ctrl, pos, end, convert->invoke_args,
+			&msg->args));
 	}
 
-	ASN1_CONSTRUCTED_END(seq_len, pos, end);
+	if (seq_len) {
+		ASN1_CONSTRUCTED_END(seq_len, pos, end);
+	} else {
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
+	}
 
 	return pos;
 }
@@ -2111,6 +2557,9 @@ unsigned char *rose_encode_result(struct pri *ctrl, unsigned char *pos,
 
 		if (convert->encode_result_args) {
 			ASN1_CALL(pos, convert->encode_result_args(ctrl, pos, end, &msg->args));
+		} else if (convert->result_args) {
+			ASN1_CALL(pos, rose_codec_encode(ctrl, pos, end, convert->result_args,
+				&msg->args));
 		}
 
 		ASN1_CONSTRUCTED_END(op_seq_len, pos, end);
@@ -2446,6 +2895,10 @@ static const unsigned char *rose_decode_invoke(struct pri *ctrl, unsigned tag,
 	if (convert && convert->decode_invoke_args) {
 		ASN1_CALL(pos, asn1_dec_tag(pos, seq_end, &tag));
 		ASN1_CALL(pos, convert->decode_invoke_args(ctrl, tag, pos, seq_end, &msg->args));
+	} else if (convert && convert->invoke_args) {
+		ASN1_CALL(pos, asn1_dec_tag(pos, seq_end, &tag));
+		ASN1_CALL(pos, rose_codec_decode(ctrl, convert->invoke_args, tag, pos, seq_end,
+			&msg->args));
 	}
 
 	ASN1_END_FIXUP(ctrl, pos, seq_offset, seq_end, end);
@@ -2535,6 +2988,10 @@ static const unsigned char *rose_decode_result(struct pri *ctrl, unsigned tag,
 			ASN1_CALL(pos, asn1_dec_tag(pos, op_seq_end, &tag));
 			ASN1_CALL(pos, convert->decode_result_args(ctrl, tag, pos, op_seq_end,
 				&msg->args));
+		} else if (convert && convert->result_args) {
+			ASN1_CALL(pos, asn1_dec_tag(pos, op_seq_end, &tag));
+			ASN1_CALL(pos, rose_codec_decode(ctrl, convert->result_args, tag, pos,
+				op_seq_end, &msg->args));
 		}
 
 		ASN1_END_FIXUP(ctrl, pos, op_seq_offset, op_seq_end, seq_end);
@@ -2745,6 +3202,100 @@ const unsigned char *rose_decode(struct pri *ctrl, const unsigned char *pos,
 	return pos;
 }
 
+/*!
+ * \internal
+ * \brief Allocate memory from the controller ROSE decode arena.
+ *
+ * \param ctrl D channel controller owning the arena.
+ * \param size Number of octets needed.
+ *
+ * \note The memory is given back by restoring ctrl->rose_arena.used.
+ *
+ * \retval Allocated memory on success.
+ * \retval NULL on error.
+ */
+static void *rose_arena_alloc(struct pri *ctrl, size_t size)
+{
+	struct rose_arena *arena;
+	void *mem;
+
+	arena = &ctrl->rose_arena;
+	if (!arena->buf) {
+		arena->buf = malloc(ROSE_ARENA_SIZE);
+		if (!arena->buf) {
+			pri_error(ctrl, "!! Unable to allocate the ROSE decode arena\n");
+			return NULL;
+		}
+		arena->used = 0;
+	}
+
+	size = (size + ROSE_ARENA_ALIGN - 1) & ~(size_t) (ROSE_ARENA_ALIGN - 1);
+	if (ROSE_ARENA_SIZE - arena->used < size) {
+		pri_error(ctrl, "!! ROSE decode arena is full\n");
+		return NULL;
+	}
+	mem = arena->buf + arena->used;
+	arena->used += size;
+
+	return mem;
+}
+
+/*!
+ * \brief Decode the ROSE message into the controller decode arena.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param pos Starting position of the ASN.1 component.
+ * \param end End of ASN.1 decoding data buffer.
+ * \param msg Where to put the decoded ROSE message.
+ *
+ * \details
+ * Only the component that the tag selects is allocated, so a reject
+ * does not pay for the invoke and result argument unions.
+ *
+ * \note The caller saves ctrl->rose_arena.used before decoding and
+ * restores it once the message is handled.
+ *
+ * \retval Start of the next ASN.1 component on success.
+ * \retval NULL on error.
+ */
+const unsigned char *rose_decode_arena(struct pri *ctrl, const unsigned char *pos,
+	const unsigned char *end, struct rose_message **msg)
+{
+	size_t size;
+	unsigned tag;
+
+	*msg = NULL;
+
+	/* Peek at the component tag.  rose_decode() will decode it again. */
+	if (!asn1_dec_tag(pos, end, &tag)) {
+		return NULL;
+	}
+	size = offsetof(struct rose_message, component);
+	switch (tag) {
+	case ROSE_TAG_COMPONENT_INVOKE:
+		size += sizeof((*msg)->component.invoke);
+		break;
+	case ROSE_TAG_COMPONENT_RESULT:
+		size += sizeof((*msg)->component.result);
+		break;
+	case ROSE_TAG_COMPONENT_ERROR:
+		size += sizeof((*msg)->component.error);
+		break;
+	case ROSE_TAG_COMPONENT_REJECT:
+		size += sizeof((*msg)->component.reject);
+		break;
+	default:
+		/* rose_decode() only sets the type before complaining about the tag. */
+		break;
+	}
+
+	*msg = rose_arena_alloc(ctrl, size);
+	if (!*msg) {
+		return NULL;
+	}
+	return rose_decode(ctrl, pos, end, *msg);
+}
+
 /*!
  * \internal
  * \brief Decode the NetworkFacilityExtension argument parameters.
@@ -4408,6 +4408,10 @@ unsigned char *rose_encode(struct pri *ctrl, unsigned char *pos, unsigned char *
 	const struct rose_message *msg);
 const unsigned char *rose_decode(struct pri *ctrl, const unsigned char *pos,
 	const unsigned char *end, struct rose_message *msg);
+const unsigned char *rose_decode_arena(struct pri *ctrl, const unsigned char *pos,
+	const unsigned char *end, struct rose_message **msg);
+
+int rose_dialect_check(struct pri *ctrl);
 
 unsigned char *fac_enc_extension_header(struct pri *ctrl, unsigned char *pos,
 	unsigned char *end, const struct fac_extension_header *header);
@@ -65,15 +65,16 @@ static unsigned char *rose_enc_NetworkPartyNumber(struct pri *ctrl, unsigned cha
 	unsigned char *end, unsigned tag, const unsigned char *number,
 	size_t length_of_number, u_int8_t type_of_number)
 {
-	unsigned char *seq_len;
+	unsigned char *seq_end;
 
-	ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, tag);
+	ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, tag,
+		asn1_enc_int_size(type_of_number) + asn1_enc_tlv_size(length_of_number));
 
 	ASN1_CALL(pos, asn1_enc_int(pos, end, ASN1_TYPE_ENUMERATED, type_of_number));
 	ASN1_CALL(pos, asn1_enc_string_bin(pos, end, ASN1_TYPE_NUMERIC_STRING, number,
 		length_of_number));
 
-	ASN1_CONSTRUCTED_END(seq_len, pos, end);
+	ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
 
 	return pos;
 }
@@ -131,6 +132,25 @@ unsigned char *rose_enc_PartyNumber(struct pri *ctrl, unsigned char *pos,
 	return pos;
 }
 
+/*!
+ * \brief Determine the encoded size of the PartyNumber type.
+ *
+ * \param party_number
+ *
+ * \return Number of octets rose_enc_PartyNumber() will encode.
+ */
+size_t rose_enc_PartyNumber_size(const struct rosePartyNumber *party_number)
+{
+	switch (party_number->plan) {
+	case 1:	/* Public PartyNumber */
+	case 5:	/* Private PartyNumber */
+		return asn1_enc_tlv_size(asn1_enc_int_size(party_number->ton)
+			+ asn1_enc_tlv_size(party_number->length));
+	default:
+		return asn1_enc_tlv_size(party_number->length);
+	}
+}
+
 /*!
  * \brief Encode the PartySubaddress type.
  *
@@ -145,11 +165,16 @@ unsigned char *rose_enc_PartyNumber(struct pri *ctrl, unsigned char *pos,
 unsigned char *rose_enc_PartySubaddress(struct pri *ctrl, unsigned char *pos,
 	unsigned char *end, const struct rosePartySubaddress *party_subaddress)
 {
-	unsigned char *seq_len;
+	unsigned char *seq_end;
+	size_t seq_length;
 
 	switch (party_subaddress->type) {
 	case 0:	/* UserSpecified */
-		ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, ASN1_TAG_SEQUENCE);
+		seq_length = asn1_enc_tlv_size(party_subaddress->length);
+		if (party_subaddress->u.user_specified.odd_count_present) {
+			seq_length += ASN1_ENC_BOOLEAN_SIZE;
+		}
+		ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, ASN1_TAG_SEQUENCE, seq_length);
 
 		ASN1_CALL(pos, asn1_enc_string_bin(pos, end, ASN1_TYPE_OCTET_STRING,
 			party_subaddress->u.user_specified.information, party_subaddress->length));
@@ -158,7 +183,7 @@ unsigned char *rose_enc_PartySubaddress(struct pri *ctrl, unsigned char *pos,
 				party_subaddress->u.user_specified.odd_count));
 		}
 
-		ASN1_CONSTRUCTED_END(seq_len, pos, end);
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
 		break;
 	case 1:	/* NSAP */
 		ASN1_CALL(pos, asn1_enc_string_bin(pos, end, ASN1_TYPE_OCTET_STRING,
@@ -172,6 +197,28 @@ unsigned char *rose_enc_PartySubaddress(struct pri *ctrl, unsigned char *pos,
 	return pos;
 }
 
+/*!
+ * \brief Determine the encoded size of the PartySubaddress type.
+ *
+ * \param party_subaddress
+ *
+ * \return Number of octets rose_enc_PartySubaddress() will encode.
+ */
+size_t rose_enc_PartySubaddress_size(const struct rosePartySubaddress *party_subaddress)
+{
+	size_t seq_length;
+
+	seq_length = asn1_enc_tlv_size(party_subaddress->length);
+	if (party_subaddress->type == 0) {
+		/* UserSpecified */
+		if (party_subaddress->u.user_specified.odd_count_present) {
+			seq_length += ASN1_ENC_BOOLEAN_SIZE;
+		}
+		seq_length = asn1_enc_tlv_size(seq_length);
+	}
+	return seq_length;
+}
+
 /*!
  * \brief Encode the Address type.
  *
@@ -189,20 +236,43 @@ unsigned char *rose_enc_PartySubaddress(struct pri *ctrl, unsigned char *pos,
 unsigned char *rose_enc_Address(struct pri *ctrl, unsigned char *pos, unsigned char *end,
 	unsigned tag, const struct roseAddress *address)
 {
-	unsigned char *seq_len;
+	unsigned char *seq_end;
+	size_t seq_length;
 
-	ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, tag);
+	seq_length = rose_enc_PartyNumber_size(&address->number);
+	if (address->subaddress.length) {
+		seq_length += rose_enc_PartySubaddress_size(&address->subaddress);
+	}
+	ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, tag, seq_length);
 
 	ASN1_CALL(pos, rose_enc_PartyNumber(ctrl, pos, end, &address->number));
 	if (address->subaddress.length) {
 		ASN1_CALL(pos, rose_enc_PartySubaddress(ctrl, pos, end, &address->subaddress));
 	}
 
-	ASN1_CONSTRUCTED_END(seq_len, pos, end);
+	ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
 
 	return pos;
 }
 
+/*!
+ * \brief Determine the encoded size of the Address type.
+ *
+ * \param address
+ *
+ * \return Number of octets rose_enc_Address() will encode.
+ */
+size_t rose_enc_Address_size(const struct roseAddress *address)
+{
+	size_t seq_length;
+
+	seq_length = rose_enc_PartyNumber_size(&address->number);
+	if (address->subaddress.length) {
+		seq_length += rose_enc_PartySubaddress_size(&address->subaddress);
+	}
+	return asn1_enc_tlv_size(seq_length);
+}
+
 /*!
  * \brief Encode the PresentedNumberUnscreened type.
  *
@@ -217,14 +287,15 @@ unsigned char *rose_enc_Address(struct pri *ctrl, unsigned char *pos, unsigned c
 unsigned char *rose_enc_PresentedNumberUnscreened(struct pri *ctrl, unsigned char *pos,
 	unsigned char *end, const struct rosePresentedNumberUnscreened *party)
 {
-	unsigned char *seq_len;
+	unsigned char *seq_end;
 
 	switch (party->presentation) {
 	case 0:	/* presentationAllowedNumber */
 		/* EXPLICIT tag */
-		ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 0);
+		ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 0,
+			rose_enc_PartyNumber_size(&party->number));
 		ASN1_CALL(pos, rose_enc_PartyNumber(ctrl, pos, end, &party->number));
-		ASN1_CONSTRUCTED_END(seq_len, pos, end);
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
 		break;
 	case 1:	/* presentationRestricted */
 		ASN1_CALL(pos, asn1_enc_null(pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 1));
@@ -234,9 +305,10 @@ unsigned char *rose_enc_PresentedNumberUnscreened(struct pri *ctrl, unsigned cha
 		break;
 	case 3:	/* presentationRestrictedNumber */
 		/* EXPLICIT tag */
-		ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 3);
+		ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 3,
+			rose_enc_PartyNumber_size(&party->number));
 		ASN1_CALL(pos, rose_enc_PartyNumber(ctrl, pos, end, &party->number));
-		ASN1_CONSTRUCTED_END(seq_len, pos, end);
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
 		break;
 	default:
 		ASN1_ENC_ERROR(ctrl, "Unknown presentation type");
@@ -246,6 +318,25 @@ unsigned char *rose_enc_PresentedNumberUnscreened(struct pri *ctrl, unsigned cha
 	return pos;
 }
 
+/*!
+ * \brief Determine the encoded size of the PresentedNumberUnscreened type.
+ *
+ * \param party
+ *
+ * \return Number of octets rose_enc_PresentedNumberUnscreened() will encode.
+ */
+size_t rose_enc_PresentedNumberUnscreened_size(
+	const struct rosePresentedNumberUnscreened *party)
+{
+	switch (party->presentation) {
+	case 0:	/* presentationAllowedNumber */
+	case 3:	/* presentationRestrictedNumber */
+		return asn1_enc_tlv_size(rose_enc_PartyNumber_size(&party->number));
+	default:
+		return ASN1_ENC_NULL_SIZE;
+	}
+}
+
 /*!
  * \brief Encode the NumberScreened type.
  *
@@ -403,7 +494,7 @@ static const unsigned char *rose_dec_NumberDigits(struct pri *ctrl, const char *
 {
 	size_t str_len;
 
-	ASN1_CALL(pos, asn1_dec_string_max(ctrl, name, tag, pos, end,
+	ASN1_CALL(pos, asn1_dec_string_max_view(ctrl, name, tag, pos, end,
 		sizeof(party_number->str), party_number->str, &str_len));
 	party_number->length = str_len;
 
@@ -430,7 +521,7 @@ static const unsigned char *rose_dec_NSAPPartyNumber(struct pri *ctrl, const cha
 {
 	size_t str_len;
 
-	ASN1_CALL(pos, asn1_dec_string_bin(ctrl, name, tag, pos, end,
+	ASN1_CALL(pos, asn1_dec_string_bin_view(ctrl, name, tag, pos, end,
 		sizeof(party_number->str), party_number->str, &str_len));
 	party_number->length = str_len;
 
@@ -583,8 +674,8 @@ static const unsigned char *rose_dec_UserSubaddress(struct pri *ctrl, const char
 	/* SubaddressInformation */
 	ASN1_CALL(pos, asn1_dec_tag(pos, seq_end, &tag));
 	ASN1_CHECK_TAG(ctrl, tag, tag & ~ASN1_PC_MASK, ASN1_TYPE_OCTET_STRING);
-	ASN1_CALL(pos, asn1_dec_string_bin(ctrl, "subaddressInformation", tag, pos, seq_end,
-		sizeof(party_subaddress->u.user_specified.information),
+	ASN1_CALL(pos, asn1_dec_string_bin_view(ctrl, "subaddressInformation", tag, pos,
+		seq_end, sizeof(party_subaddress->u.user_specified.information),
 		party_subaddress->u.user_specified.information, &str_len));
 	party_subaddress->length = str_len;
 
@@ -631,7 +722,7 @@ static const unsigned char *rose_dec_NSAPSubaddress(struct pri *ctrl, const char
 
 	party_subaddress->type = 1;	/* NSAP */
 
-	ASN1_CALL(pos, asn1_dec_string_bin(ctrl, name, tag, pos, end,
+	ASN1_CALL(pos, asn1_dec_string_bin_view(ctrl, name, tag, pos, end,
 		sizeof(party_subaddress->u.nsap), party_subaddress->u.nsap, &str_len));
 	party_subaddress->length = str_len;
 
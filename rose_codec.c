@@ -0,0 +1,922 @@
+/*
+ * libpri: An implementation of Primary Rate ISDN
+ *
+ * See http://www.asterisk.org for more information about
+ * the Asterisk project. Please do not directly contact
+ * any of the maintainers of this project for assistance;
+ * the project provides a web site, mailing lists and IRC
+ * channels for your use.
+ *
+ * This program is free software, distributed under the terms of
+ * the GNU General Public License Version 2 as published by the
+ * Free Software Foundation. See the LICENSE file included with
+ * this program for more details.
+ *
+ * In addition, when this program is distributed with Asterisk in
+ * any form that would qualify as a 'combined work' or as a
+ * 'derivative work' (but not mere aggregation), you can redistribute
+ * and/or modify the combination under the terms of the license
+ * provided with that copy of Asterisk, instead of the license
+ * terms granted here.
+ */
+
+/*!
+ * \file
+ * \brief Generic ROSE argument encode/decode driven by operation descriptors
+ *
+ * An operation argument is described by a tree of rose_codec_field
+ * components.  Each component gives its tag, its kind of ASN.1
+ * production, where it is stored, and whether it is OPTIONAL.
+ * The functions here walk that tree to encode, size, and decode the
+ * argument, so an operation only needs a descriptor table.
+ *
+ * \note Components of a SEQUENCE are decoded in the order described except
+ * that a run of OPTIONAL components may be received in any order.
+ */
+
+
+#include <string.h>
+
+#include "compat.h"
+#include "libpri.h"
+#include "pri_internal.h"
+#include "rose.h"
+#include "rose_internal.h"
+#include "asn1.h"
+
+
+/*! Encoded length is not known until the component is encoded. */
+#define ROSE_CODEC_NO_SIZE	((size_t) -1)
+
+/* ------------------------------------------------------------------- */
+
+static size_t rose_codec_field_size(const struct rose_codec_field *field,
+	const unsigned char *base);
+static unsigned char *rose_codec_enc_field(struct pri *ctrl, unsigned char *pos,
+	unsigned char *end, const struct rose_codec_field *field, const unsigned char *base);
+static const unsigned char *rose_codec_dec_field(struct pri *ctrl,
+	const struct rose_codec_field *field, unsigned tag, const unsigned char *pos,
+	const unsigned char *end, unsigned char *base);
+
+/*!
+ * \internal
+ * \brief Get the value of an INTEGER component.
+ *
+ * \param field Component description.
+ * \param data Component storage.
+ *
+ * \return Component value
+ */
+static int32_t rose_codec_get_int(const struct rose_codec_field *field,
+	const unsigned char *data)
+{
+	switch (field->size) {
+	case sizeof(u_int8_t):
+		return *data;
+	case sizeof(int16_t):
+		return *(const int16_t *) data;
+	default:
+		return *(const int32_t *) data;
+	}
+}
+
+/*!
+ * \internal
+ * \brief Set the value of an INTEGER component.
+ *
+ * \param field Component description.
+ * \param data Component storage.
+ * \param value Decoded value to store.
+ *
+ * \return Nothing
+ */
+static void rose_codec_set_int(const struct rose_codec_field *field, unsigned char *data,
+	int32_t value)
+{
+	switch (field->size) {
+	case sizeof(u_int8_t):
+		*data = value;
+		break;
+	case sizeof(int16_t):
+		*(int16_t *) data = value;
+		break;
+	default:
+		*(int32_t *) data = value;
+		break;
+	}
+}
+
+/*!
+ * \internal
+ * \brief Determine if an OPTIONAL component is to be encoded.
+ *
+ * \param field Component description.
+ * \param base Storage of the enclosing production.
+ *
+ * \retval TRUE if the component is present.
+ */
+static int rose_codec_present(const struct rose_codec_field *field,
+	const unsigned char *base)
+{
+	return !(field->flags & ROSE_CODEC_OPTIONAL) || base[field->present];
+}
+
+/*!
+ * \internal
+ * \brief Select the CHOICE alternative to encode.
+ *
+ * \param type CHOICE description.
+ * \param data CHOICE storage.
+ *
+ * \note The first alternative with the discriminator value that is
+ * present is selected.
+ *
+ * \return Alternative to encode or NULL if none.
+ */
+static const struct rose_codec_field *rose_codec_choice(
+	const struct rose_codec_type *type, const unsigned char *data)
+{
+	unsigned index;
+
+	for (index = 0; index < type->num_fields; ++index) {
+		if (type->fields[index].choice == data[type->selector]
+			&& rose_codec_present(&type->fields[index], data)) {
+			return &type->fields[index];
+		}
+	}
+	return NULL;
+}
+
+/*!
+ * \internal
+ * \brief Determine if the component starts with the given tag.
+ *
+ * \param field Component description.
+ * \param tag Decoded component tag.
+ *
+ * \retval TRUE if the tag identifies the component.
+ */
+static int rose_codec_match(const struct rose_codec_field *field, unsigned tag)
+{
+	unsigned index;
+
+	if (field->explicit_tag) {
+		return tag == (field->explicit_tag | ASN1_PC_CONSTRUCTED);
+	}
+	switch (field->kind) {
+	case ROSE_CODEC_STRING:
+		return (tag & ~ASN1_PC_MASK) == field->tag;
+	case ROSE_CODEC_SEQUENCE:
+	case ROSE_CODEC_SEQUENCE_OF:
+		return tag == (field->tag | ASN1_PC_CONSTRUCTED);
+	case ROSE_CODEC_CHOICE:
+		for (index = 0; index < field->type->num_fields; ++index) {
+			if (rose_codec_match(&field->type->fields[index], tag)) {
+				return 1;
+			}
+		}
+		return 0;
+	case ROSE_CODEC_EXTERN:
+		if (field->type->match) {
+			return field->type->match(tag);
+		}
+		/* The production picks its own primitive or constructed encoding. */
+		return !field->tag || (tag & ~ASN1_PC_MASK) == (field->tag & ~ASN1_PC_MASK);
+	default:
+		return tag == field->tag;
+	}
+}
+
+/*!
+ * \internal
+ * \brief Determine the encoded contents length of a SEQUENCE or SEQUENCE OF.
+ *
+ * \param field Component description.
+ * \param data Component storage.
+ *
+ * \return Number of octets after the length or ROSE_CODEC_NO_SIZE.
+ */
+static size_t rose_codec_contents_length(const struct rose_codec_field *field,
+	const unsigned char *data)
+{
+	const struct rose_codec_type *type;
+	unsigned index;
+	size_t length;
+	size_t size;
+
+	type = field->type;
+	length = 0;
+	if (field->kind == ROSE_CODEC_SEQUENCE) {
+		for (index = 0; index < type->num_fields; ++index) {
+			if (!rose_codec_present(&type->fields[index], data)) {
+				continue;
+			}
+			size = rose_codec_field_size(&type->fields[index], data);
+			if (size == ROSE_CODEC_NO_SIZE) {
+				return ROSE_CODEC_NO_SIZE;
+			}
+			length += size;
+		}
+	} else {
+		if (type->max_records < data[type->selector]) {
+			/* The encoder reports too many records. */
+			return ROSE_CODEC_NO_SIZE;
+		}
+		for (index = 0; index < data[type->selector]; ++index) {
+			size = rose_codec_field_size(type->fields,
+				data + index * type->record_size);
+			if (size == ROSE_CODEC_NO_SIZE) {
+				return ROSE_CODEC_NO_SIZE;
+			}
+			length += size;
+		}
+	}
+	return length;
+}
+
+/*!
+ * \internal
+ * \brief Determine the encoded size of a component value without any EXPLICIT tag.
+ *
+ * \param field Component description.
+ * \param data Component storage.
+ *
+ * \return Number of octets or ROSE_CODEC_NO_SIZE.
+ */
+static size_t rose_codec_value_size(const struct rose_codec_field *field,
+	const unsigned char *data)
+{
+	const struct rose_codec_field *alternative;
+	size_t length;
+
+	switch (field->kind) {
+	case ROSE_CODEC_INTEGER:
+		return asn1_enc_int_size(rose_codec_get_int(field, data));
+	case ROSE_CODEC_BOOLEAN:
+		return ASN1_ENC_BOOLEAN_SIZE;
+	case ROSE_CODEC_NULL:
+		return ASN1_ENC_NULL_SIZE;
+	case ROSE_CODEC_STRING:
+		return asn1_enc_string_max_size(data, field->size - 1);
+	case ROSE_CODEC_SEQUENCE:
+	case ROSE_CODEC_SEQUENCE_OF:
+		length = rose_codec_contents_length(field, data);
+		if (length == ROSE_CODEC_NO_SIZE) {
+			return ROSE_CODEC_NO_SIZE;
+		}
+		return asn1_enc_tlv_size(length);
+	case ROSE_CODEC_CHOICE:
+		alternative = rose_codec_choice(field->type, data);
+		if (!alternative) {
+			/* The encoder reports the unknown alternative. */
+			return ROSE_CODEC_NO_SIZE;
+		}
+		return rose_codec_field_size(alternative, data);
+	case ROSE_CODEC_EXTERN:
+		if (!field->type->size) {
+			return ROSE_CODEC_NO_SIZE;
+		}
+		return field->type->size(data);
+	default:
+		return ROSE_CODEC_NO_SIZE;
+	}
+}
+
+/*!
+ * \internal
+ * \brief Determine the encoded size of a component.
+ *
+ * \param field Component description.
+ * \param base Storage of the enclosing production.
+ *
+ * \return Number of octets or ROSE_CODEC_NO_SIZE.
+ */
+static size_t rose_codec_field_size(const struct rose_codec_field *field,
+	const unsigned char *base)
+{
+	size_t size;
+
+	size = rose_codec_value_size(field, base + field->offset);
+	if (field->explicit_tag && size != ROSE_CODEC_NO_SIZE) {
+		size = asn1_enc_tlv_size(size);
+	}
+	return size;
+}
+
+/*!
+ * \internal
+ * \brief Encode the contents of a SEQUENCE or SEQUENCE OF.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param pos Starting position to encode ASN.1 component.
+ * \param end End of ASN.1 encoding data buffer.
+ * \param field Component description.
+ * \param data Component storage.
+ *
+ * \retval Start of the next ASN.1 component to encode on success.
+ * \retval NULL on error.
+ */
+static unsigned char *rose_codec_enc_contents(struct pri *ctrl, unsigned char *pos,
+	unsigned char *end, const struct rose_codec_field *field, const unsigned char *data)
+{
+	const struct rose_codec_type *type;
+	unsigned index;
+
+	type = field->type;
+	if (field->kind == ROSE_CODEC_SEQUENCE) {
+		for (index = 0; index < type->num_fields; ++index) {
+			if (rose_codec_present(&type->fields[index], data)) {
+				ASN1_CALL(pos, rose_codec_enc_field(ctrl, pos, end, &type->fields[index],
+					data));
+			}
+		}
+	} else {
+		if (type->max_records < data[type->selector]) {
+			pri_error(ctrl, "%s error: Too many %s records\n", __FUNCTION__, type->name);
+			return NULL;
+		}
+		for (index = 0; index < data[type->selector]; ++index) {
+			ASN1_CALL(pos, rose_codec_enc_field(ctrl, pos, end, type->fields,
+				data + index * type->record_size));
+		}
+	}
+
+	return pos;
+}
+
+/*!
+ * \internal
+ * \brief Encode a component value without any EXPLICIT tag.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param pos Starting position to encode ASN.1 component.
+ * \param end End of ASN.1 encoding data buffer.
+ * \param field Component description.
+ * \param data Component storage.
+ *
+ * \retval Start of the next ASN.1 component to encode on success.
+ * \retval NULL on error.
+ */
+static unsigned char *rose_codec_enc_value(struct pri *ctrl, unsigned char *pos,
+	unsigned char *end, const struct rose_codec_field *field, const unsigned char *data)
+{
+	const struct rose_codec_field *alternative;
+	unsigned char *seq_len;
+	unsigned char *seq_end;
+	size_t length;
+
+	switch (field->kind) {
+	case ROSE_CODEC_INTEGER:
+		return asn1_enc_int(pos, end, field->tag, rose_codec_get_int(field, data));
+	case ROSE_CODEC_BOOLEAN:
+		return asn1_enc_boolean(pos, end, field->tag, *data);
+	case ROSE_CODEC_NULL:
+		return asn1_enc_null(pos, end, field->tag);
+	case ROSE_CODEC_STRING:
+		return asn1_enc_string_max(pos, end, field->tag, data, field->size - 1);
+	case ROSE_CODEC_SEQUENCE:
+	case ROSE_CODEC_SEQUENCE_OF:
+		length = rose_codec_contents_length(field, data);
+		if (length != ROSE_CODEC_NO_SIZE) {
+			ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, field->tag, length);
+			ASN1_CALL(pos, rose_codec_enc_contents(ctrl, pos, end, field, data));
+			ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
+		} else {
+			ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, field->tag);
+			ASN1_CALL(pos, rose_codec_enc_contents(ctrl, pos, end, field, data));
+			ASN1_CONSTRUCTED_END(seq_len, pos, end);
+		}
+		return pos;
+	case ROSE_CODEC_CHOICE:
+		alternative = rose_codec_choice(field->type, data);
+		if (!alternative) {
+			pri_error(ctrl, "%s error: Unknown %s type\n", __FUNCTION__,
+				field->type->name);
+			return NULL;
+		}
+		return rose_codec_enc_field(ctrl, pos, end, alternative, data);
+	case ROSE_CODEC_EXTERN:
+		return field->type->encode(ctrl, pos, end, field->tag, data);
+	default:
+		return NULL;
+	}
+}
+
+/*!
+ * \internal
+ * \brief Encode a component.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param pos Starting position to encode ASN.1 component.
+ * \param end End of ASN.1 encoding data buffer.
+ * \param field Component description.
+ * \param base Storage of the enclosing production.
+ *
+ * \retval Start of the next ASN.1 component to encode on success.
+ * \retval NULL on error.
+ */
+static unsigned char *rose_codec_enc_field(struct pri *ctrl, unsigned char *pos,
+	unsigned char *end, const struct rose_codec_field *field, const unsigned char *base)
+{
+	const unsigned char *data;
+	unsigned char *explicit_len;
+	unsigned char *explicit_end;
+	size_t length;
+
+	data = base + field->offset;
+	if (!field->explicit_tag) {
+		return rose_codec_enc_value(ctrl, pos, end, field, data);
+	}
+
+	length = rose_codec_value_size(field, data);
+	if (length != ROSE_CODEC_NO_SIZE) {
+		ASN1_CONSTRUCTED_BEGIN_SIZED(explicit_end, pos, end, field->explicit_tag, length);
+		ASN1_CALL(pos, rose_codec_enc_value(ctrl, pos, end, field, data));
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, explicit_end, pos);
+	} else {
+		ASN1_CONSTRUCTED_BEGIN(explicit_len, pos, end, field->explicit_tag);
+		ASN1_CALL(pos, rose_codec_enc_value(ctrl, pos, end, field, data));
+		ASN1_CONSTRUCTED_END(explicit_len, pos, end);
+	}
+
+	return pos;
+}
+
+/*!
+ * \brief Encode ROSE arguments described by a descriptor.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param pos Starting position to encode ASN.1 component.
+ * \param end End of ASN.1 encoding data buffer.
+ * \param field Argument description.
+ * \param args Arguments to encode in the buffer.
+ *
+ * \retval Start of the next ASN.1 component to encode on success.
+ * \retval NULL on error.
+ */
+unsigned char *rose_codec_encode(struct pri *ctrl, unsigned char *pos,
+	unsigned char *end, const struct rose_codec_field *field, const void *args)
+{
+	return rose_codec_enc_field(ctrl, pos, end, field, args);
+}
+
+/*!
+ * \brief Determine the encoded size of ROSE arguments described by a descriptor.
+ *
+ * \param field Argument description.
+ * \param args Arguments to encode.
+ *
+ * \return Number of octets rose_codec_encode() will encode.
+ * \retval 0 if the size is not known in advance.
+ */
+size_t rose_codec_size(const struct rose_codec_field *field, const void *args)
+{
+	size_t size;
+
+	size = rose_codec_field_size(field, args);
+	if (size == ROSE_CODEC_NO_SIZE) {
+		return 0;
+	}
+	return size;
+}
+
+/*!
+ * \internal
+ * \brief Decode a SEQUENCE or SEQUENCE OF.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param field Component description.
+ * \param tag Component tag that identified this production.
+ * \param pos Starting position of the ASN.1 component length.
+ * \param end End of ASN.1 decoding data buffer.
+ * \param data Component storage to fill.
+ *
+ * \retval Start of the next ASN.1 component on success.
+ * \retval NULL on error.
+ */
+static const unsigned char *rose_codec_dec_constructed(struct pri *ctrl,
+	const struct rose_codec_field *field, unsigned tag, const unsigned char *pos,
+	const unsigned char *end, unsigned char *data)
+{
+	const struct rose_codec_type *type;
+	const struct rose_codec_field *component;
+	const unsigned char *seq_end;
+	const unsigned char *save_pos;
+	unsigned index;
+	unsigned run_end;
+	unsigned optional;
+	int length;
+	int seq_offset;
+
+	type = field->type;
+	if (ctrl->debug & PRI_DEBUG_APDU) {
+		if (field->name && type->name) {
+			pri_message(ctrl, "  %s %s %s\n", field->name, type->name,
+				asn1_tag2str(tag));
+		} else {
+			pri_message(ctrl, "  %s %s\n", field->name ? field->name : type->name,
+				asn1_tag2str(tag));
+		}
+	}
+	ASN1_CALL(pos, asn1_dec_length(pos, end, &length));
+	ASN1_END_SETUP(seq_end, seq_offset, length, pos, end);
+
+	if (field->kind == ROSE_CODEC_SEQUENCE) {
+		index = 0;
+		while (index < type->num_fields) {
+			component = &type->fields[index];
+			if (!(component->flags & ROSE_CODEC_OPTIONAL)) {
+				if (seq_end <= pos || *pos == ASN1_INDEF_TERM) {
+					/* Missing component */
+					return NULL;
+				}
+				ASN1_CALL(pos, asn1_dec_tag(pos, seq_end, &tag));
+				ASN1_CALL(pos, rose_codec_dec_field(ctrl, component, tag, pos, seq_end,
+					data));
+				++index;
+				continue;
+			}
+
+			/*
+			 * A sequence specifies an ordered list of component types.
+			 * However, for simplicity we are not checking the order of
+			 * a run of optional components.
+			 */
+			for (run_end = index; run_end < type->num_fields
+				&& (type->fields[run_end].flags & ROSE_CODEC_OPTIONAL); ++run_end) {
+				data[type->fields[run_end].present] = 0;
+			}
+			while (pos < seq_end && *pos != ASN1_INDEF_TERM) {
+				save_pos = pos;
+				ASN1_CALL(pos, asn1_dec_tag(pos, seq_end, &tag));
+				for (optional = index; optional < run_end; ++optional) {
+					if (rose_codec_match(&type->fields[optional], tag)) {
+						break;
+					}
+				}
+				if (optional == run_end) {
+					if (run_end == type->num_fields) {
+						ASN1_DID_NOT_EXPECT_TAG(ctrl, tag);
+						return NULL;
+					}
+					/* The next mandatory component must match it. */
+					pos = save_pos;
+					break;
+				}
+				component = &type->fields[optional];
+				ASN1_CALL(pos, rose_codec_dec_field(ctrl, component, tag, pos, seq_end,
+					data));
+				if ((component->flags & (ROSE_CODEC_OPTIONAL | ROSE_CODEC_IMPLIED))
+					== ROSE_CODEC_OPTIONAL) {
+					data[component->present] = 1;
+				}
+			}
+			index = run_end;
+		}
+	} else {
+		index = 0;
+		while (pos < seq_end && *pos != ASN1_INDEF_TERM) {
+			if (index < type->max_records) {
+				ASN1_CALL(pos, asn1_dec_tag(pos, seq_end, &tag));
+				ASN1_CALL(pos, rose_codec_dec_field(ctrl, type->fields, tag, pos,
+					seq_end, data + index * type->record_size));
+				++index;
+			} else {
+				/* Too many records */
+				return NULL;
+			}
+		}
+		data[type->selector] = index;
+	}
+
+	ASN1_END_FIXUP(ctrl, pos, seq_offset, seq_end, end);
+
+	return pos;
+}
+
+/*!
+ * \internal
+ * \brief Decode a component value without any EXPLICIT tag.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param field Component description.
+ * \param tag Component tag that identified this production.
+ * \param pos Starting position of the ASN.1 component length.
+ * \param end End of ASN.1 decoding data buffer.
+ * \param data Component storage to fill.
+ *
+ * \retval Start of the next ASN.1 component on success.
+ * \retval NULL on error.
+ */
+static const unsigned char *rose_codec_dec_value(struct pri *ctrl,
+	const struct rose_codec_field *field, unsigned tag, const unsigned char *pos,
+	const unsigned char *end, unsigned char *data)
+{
+	const struct rose_codec_type *type;
+	unsigned index;
+	int32_t value;
+	size_t str_len;
+
+	switch (field->kind) {
+	case ROSE_CODEC_INTEGER:
+		ASN1_CHECK_TAG(ctrl, tag, tag, field->tag);
+		ASN1_CALL(pos, asn1_dec_int(ctrl, field->name, tag, pos, end, &value));
+		rose_codec_set_int(field, data, value);
+		break;
+	case ROSE_CODEC_BOOLEAN:
+		ASN1_CHECK_TAG(ctrl, tag, tag, field->tag);
+		ASN1_CALL(pos, asn1_dec_boolean(ctrl, field->name, tag, pos, end, &value));
+		*data = value;
+		break;
+	case ROSE_CODEC_NULL:
+		ASN1_CHECK_TAG(ctrl, tag, tag, field->tag);
+		ASN1_CALL(pos, asn1_dec_null(ctrl, field->name, tag, pos, end));
+		memset(data, 0, field->size);
+		break;
+	case ROSE_CODEC_STRING:
+		ASN1_CHECK_TAG(ctrl, tag, tag & ~ASN1_PC_MASK, field->tag);
+		ASN1_CALL(pos, asn1_dec_string_max(ctrl, field->name, tag, pos, end,
+			field->size, data, &str_len));
+		break;
+	case ROSE_CODEC_SEQUENCE:
+	case ROSE_CODEC_SEQUENCE_OF:
+		ASN1_CHECK_TAG(ctrl, tag, tag, field->tag | ASN1_PC_CONSTRUCTED);
+		ASN1_CALL(pos, rose_codec_dec_constructed(ctrl, field, tag, pos, end, data));
+		break;
+	case ROSE_CODEC_CHOICE:
+		type = field->type;
+		if (field->name && type->name && (ctrl->debug & PRI_DEBUG_APDU)) {
+			pri_message(ctrl, "  %s %s\n", field->name, type->name);
+		}
+		for (index = 0; index < type->num_fields; ++index) {
+			if (rose_codec_match(&type->fields[index], tag)) {
+				data[type->selector] = type->fields[index].choice;
+				return rose_codec_dec_field(ctrl, &type->fields[index], tag, pos, end,
+					data);
+			}
+		}
+		ASN1_DID_NOT_EXPECT_TAG(ctrl, tag);
+		return NULL;
+	case ROSE_CODEC_EXTERN:
+		if (field->tag && !rose_codec_match(field, tag)) {
+			ASN1_DID_NOT_EXPECT_TAG(ctrl, tag);
+			return NULL;
+		}
+		ASN1_CALL(pos, field->type->decode(ctrl, field->name, tag, pos, end, data,
+			field->size));
+		break;
+	default:
+		return NULL;
+	}
+
+	return pos;
+}
+
+/*!
+ * \internal
+ * \brief Decode a component.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param field Component description.
+ * \param tag Component tag that identified this production.
+ * \param pos Starting position of the ASN.1 component length.
+ * \param end End of ASN.1 decoding data buffer.
+ * \param base Storage of the enclosing production to fill.
+ *
+ * \retval Start of the next ASN.1 component on success.
+ * \retval NULL on error.
+ */
+static const unsigned char *rose_codec_dec_field(struct pri *ctrl,
+	const struct rose_codec_field *field, unsigned tag, const unsigned char *pos,
+	const unsigned char *end, unsigned char *base)
+{
+	const unsigned char *explicit_end;
+	int length;
+	int explicit_offset;
+
+	if (!field->explicit_tag) {
+		return rose_codec_dec_value(ctrl, field, tag, pos, end, base + field->offset);
+	}
+
+	/* Remove EXPLICIT tag */
+	ASN1_CHECK_TAG(ctrl, tag, tag, field->explicit_tag | ASN1_PC_CONSTRUCTED);
+	if (ctrl->debug & PRI_DEBUG_APDU) {
+		pri_message(ctrl, "  Explicit %s\n", asn1_tag2str(tag));
+	}
+	ASN1_CALL(pos, asn1_dec_length(pos, end, &length));
+	ASN1_END_SETUP(explicit_end, explicit_offset, length, pos, end);
+
+	ASN1_CALL(pos, asn1_dec_tag(pos, explicit_end, &tag));
+	ASN1_CALL(pos, rose_codec_dec_value(ctrl, field, tag, pos, explicit_end,
+		base + field->offset));
+
+	ASN1_END_FIXUP(ctrl, pos, explicit_offset, explicit_end, end);
+
+	return pos;
+}
+
+/*!
+ * \brief Decode ROSE arguments described by a descriptor.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param field Argument description.
+ * \param tag Component tag that identified this structure.
+ * \param pos Starting position of the ASN.1 component length.
+ * \param end End of ASN.1 decoding data buffer.
+ * \param args Arguments to fill in from the decoded buffer.
+ *
+ * \retval Start of the next ASN.1 component on success.
+ * \retval NULL on error.
+ */
+const unsigned char *rose_codec_decode(struct pri *ctrl,
+	const struct rose_codec_field *field, unsigned tag, const unsigned char *pos,
+	const unsigned char *end, void *args)
+{
+	return rose_codec_dec_field(ctrl, field, tag, pos, end, args);
+}
+
+/* ------------------------------------------------------------------- */
+
+/*
+ * EXTERN adapters for the common addressing and Q.931 ie productions.
+ */
+
+static unsigned char *rose_codec_enc_PartyNumber(struct pri *ctrl, unsigned char *pos,
+	unsigned char *end, unsigned tag, const void *value)
+{
+	return rose_enc_PartyNumber(ctrl, pos, end, value);
+}
+
+static size_t rose_codec_size_PartyNumber(const void *value)
+{
+	return rose_enc_PartyNumber_size(value);
+}
+
+static const unsigned char *rose_codec_dec_PartyNumber(struct pri *ctrl,
+	const char *name, unsigned tag, const unsigned char *pos, const unsigned char *end,
+	void *value, size_t size)
+{
+	return rose_dec_PartyNumber(ctrl, name, tag, pos, end, value);
+}
+
+static int rose_codec_match_PartyNumber(unsigned tag)
+{
+	switch (tag & ~ASN1_PC_MASK) {
+	case ASN1_CLASS_CONTEXT_SPECIFIC | 0:
+	case ASN1_CLASS_CONTEXT_SPECIFIC | 1:
+	case ASN1_CLASS_CONTEXT_SPECIFIC | 2:
+	case ASN1_CLASS_CONTEXT_SPECIFIC | 3:
+	case ASN1_CLASS_CONTEXT_SPECIFIC | 4:
+	case ASN1_CLASS_CONTEXT_SPECIFIC | 5:
+	case ASN1_CLASS_CONTEXT_SPECIFIC | 8:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+const struct rose_codec_type rose_codec_PartyNumber = {
+	"PartyNumber", NULL, 0, 0, 0, 0,
+	rose_codec_enc_PartyNumber, rose_codec_size_PartyNumber,
+	rose_codec_dec_PartyNumber, rose_codec_match_PartyNumber
+};
+
+static unsigned char *rose_codec_enc_PartySubaddress(struct pri *ctrl,
+	unsigned char *pos, unsigned char *end, unsigned tag, const void *value)
+{
+	return rose_enc_PartySubaddress(ctrl, pos, end, value);
+}
+
+static size_t rose_codec_size_PartySubaddress(const void *value)
+{
+	return rose_enc_PartySubaddress_size(value);
+}
+
+static const unsigned char *rose_codec_dec_PartySubaddress(struct pri *ctrl,
+	const char *name, unsigned tag, const unsigned char *pos, const unsigned char *end,
+	void *value, size_t size)
+{
+	return rose_dec_PartySubaddress(ctrl, name, tag, pos, end, value);
+}
+
+static int rose_codec_match_PartySubaddress(unsigned tag)
+{
+	return tag == ASN1_TAG_SEQUENCE || (tag & ~ASN1_PC_MASK) == ASN1_TYPE_OCTET_STRING;
+}
+
+const struct rose_codec_type rose_codec_PartySubaddress = {
+	"PartySubaddress", NULL, 0, 0, 0, 0,
+	rose_codec_enc_PartySubaddress, rose_codec_size_PartySubaddress,
+	rose_codec_dec_PartySubaddress, rose_codec_match_PartySubaddress
+};
+
+static unsigned char *rose_codec_enc_Address(struct pri *ctrl, unsigned char *pos,
+	unsigned char *end, unsigned tag, const void *value)
+{
+	return rose_enc_Address(ctrl, pos, end, tag, value);
+}
+
+static const unsigned char *rose_codec_dec_Address(struct pri *ctrl, const char *name,
+	unsigned tag, const unsigned char *pos, const unsigned char *end, void *value,
+	size_t size)
+{
+	return rose_dec_Address(ctrl, name, tag, pos, end, value);
+}
+
+const struct rose_codec_type rose_codec_Address = {
+	"Address", NULL, 0, 0, 0, 0,
+	rose_codec_enc_Address, NULL,
+	rose_codec_dec_Address, NULL
+};
+
+static unsigned char *rose_codec_enc_PresentedNumberUnscreened(struct pri *ctrl,
+	unsigned char *pos, unsigned char *end, unsigned tag, const void *value)
+{
+	return rose_enc_PresentedNumberUnscreened(ctrl, pos, end, value);
+}
+
+static size_t rose_codec_size_PresentedNumberUnscreened(const void *value)
+{
+	return rose_enc_PresentedNumberUnscreened_size(value);
+}
+
+static const unsigned char *rose_codec_dec_PresentedNumberUnscreened(struct pri *ctrl,
+	const char *name, unsigned tag, const unsigned char *pos, const unsigned char *end,
+	void *value, size_t size)
+{
+	return rose_dec_PresentedNumberUnscreened(ctrl, name, tag, pos, end, value);
+}
+
+/*!
+ * \internal
+ * \brief Determine if the tag starts a presented number or address.
+ *
+ * \param tag Decoded component tag.
+ *
+ * \retval TRUE if the tag is one of the presentation alternatives.
+ */
+static int rose_codec_match_Presented(unsigned tag)
+{
+	switch (tag) {
+	case ASN1_CLASS_CONTEXT_SPECIFIC | ASN1_PC_CONSTRUCTED | 0:
+	case ASN1_CLASS_CONTEXT_SPECIFIC | 1:
+	case ASN1_CLASS_CONTEXT_SPECIFIC | 2:
+	case ASN1_CLASS_CONTEXT_SPECIFIC | ASN1_PC_CONSTRUCTED | 3:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+const struct rose_codec_type rose_codec_PresentedNumberUnscreened = {
+	"PresentedNumberUnscreened", NULL, 0, 0, 0, 0,
+	rose_codec_enc_PresentedNumberUnscreened, rose_codec_size_PresentedNumberUnscreened,
+	rose_codec_dec_PresentedNumberUnscreened, rose_codec_match_Presented
+};
+
+static unsigned char *rose_codec_enc_PresentedAddressScreened(struct pri *ctrl,
+	unsigned char *pos, unsigned char *end, unsigned tag, const void *value)
+{
+	return rose_enc_PresentedAddressScreened(ctrl, pos, end, value);
+}
+
+static const unsigned char *rose_codec_dec_PresentedAddressScreened(struct pri *ctrl,
+	const char *name, unsigned tag, const unsigned char *pos, const unsigned char *end,
+	void *value, size_t size)
+{
+	return rose_dec_PresentedAddressScreened(ctrl, name, tag, pos, end, value);
+}
+
+const struct rose_codec_type rose_codec_PresentedAddressScreened = {
+	"PresentedAddressScreened", NULL, 0, 0, 0, 0,
+	rose_codec_enc_PresentedAddressScreened, NULL,
+	rose_codec_dec_PresentedAddressScreened, rose_codec_match_Presented
+};
+
+static unsigned char *rose_codec_enc_Q931ie(struct pri *ctrl, unsigned char *pos,
+	unsigned char *end, unsigned tag, const void *value)
+{
+	return rose_enc_Q931ie(ctrl, pos, end, tag, value);
+}
+
+static size_t rose_codec_size_Q931ie(const void *value)
+{
+	return rose_enc_Q931ie_size(value);
+}
+
+static const unsigned char *rose_codec_dec_Q931ie(struct pri *ctrl, const char *name,
+	unsigned tag, const unsigned char *pos, const unsigned char *end, void *value,
+	size_t size)
+{
+	return rose_dec_Q931ie(ctrl, name, tag, pos, end, value, size);
+}
+
+/*! \note The field size is the size of the contents buffer after the struct. */
+const struct rose_codec_type rose_codec_Q931ie = {
+	"Q931ie", NULL, 0, 0, 0, 0,
+	rose_codec_enc_Q931ie, rose_codec_size_Q931ie,
+	rose_codec_dec_Q931ie, NULL
+};
+
+/* ------------------------------------------------------------------- */
+/* end rose_codec.c */
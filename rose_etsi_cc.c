@@ -662,6 +662,34 @@ unsigned char *rose_enc_etsi_CCNRInterrogate_RES(struct pri *ctrl, unsigned char
 		&args->etsi.CCNRInterrogate);
 }
 
+/*!
+ * \internal
+ * \brief Determine the encoded contents length of the CCBS-T/CCNR-T-Request arguments.
+ *
+ * \param ccbs_t_request Information to encode.
+ *
+ * \return Number of octets rose_enc_etsi_CC_T_Request_ARG_Backend() will encode
+ * after the length.
+ */
+static size_t rose_enc_etsi_CC_T_Request_ARG_length(
+	const struct roseEtsiCCBS_T_Request_ARG *ccbs_t_request)
+{
+	size_t length;
+
+	length = rose_enc_Address_size(&ccbs_t_request->destination)
+		+ rose_enc_Q931ie_size(&ccbs_t_request->q931ie);
+	if (ccbs_t_request->retention_supported) {
+		length += ASN1_ENC_BOOLEAN_SIZE;
+	}
+	if (ccbs_t_request->presentation_allowed_indicator_present) {
+		length += ASN1_ENC_BOOLEAN_SIZE;
+	}
+	if (ccbs_t_request->originating.number.length) {
+		length += rose_enc_Address_size(&ccbs_t_request->originating);
+	}
+	return length;
+}
+
 /*!
  * \internal
  * \brief Encode the CCBS-T/CCNR-T-Request invoke facility ie arguments.
@@ -678,9 +706,10 @@ static unsigned char *rose_enc_etsi_CC_T_Request_ARG_Backend(struct pri *ctrl,
 	unsigned char *pos, unsigned char *end,
 	const struct roseEtsiCCBS_T_Request_ARG *ccbs_t_request)
 {
-	unsigned char *seq_len;
+	unsigned char *seq_end;
 
-	ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, ASN1_TAG_SEQUENCE);
+	ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, ASN1_TAG_SEQUENCE,
+		rose_enc_etsi_CC_T_Request_ARG_length(ccbs_t_request));
 
 	ASN1_CALL(pos, rose_enc_Address(ctrl, pos, end, ASN1_TAG_SEQUENCE,
 		&ccbs_t_request->destination));
@@ -700,7 +729,7 @@ static unsigned char *rose_enc_etsi_CC_T_Request_ARG_Backend(struct pri *ctrl,
 			&ccbs_t_request->originating));
 	}
 
-	ASN1_CONSTRUCTED_END(seq_len, pos, end);
+	ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
 
 	return pos;
 }
@@ -741,6 +770,34 @@ unsigned char *rose_enc_etsi_CCNR_T_Request_ARG(struct pri *ctrl, unsigned char
 		&args->etsi.CCNR_T_Request);
 }
 
+/*!
+ * \brief Determine the encoded size of the CCBS_T_Request invoke
+ * facility ie arguments.
+ *
+ * \param args Arguments to encode in the buffer.
+ *
+ * \return Number of octets rose_enc_etsi_CCBS_T_Request_ARG() will encode.
+ */
+size_t rose_enc_etsi_CCBS_T_Request_ARG_size(const union rose_msg_invoke_args *args)
+{
+	return asn1_enc_tlv_size(rose_enc_etsi_CC_T_Request_ARG_length(
+		&args->etsi.CCBS_T_Request));
+}
+
+/*!
+ * \brief Determine the encoded size of the CCNR_T_Request invoke
+ * facility ie arguments.
+ *
+ * \param args Arguments to encode in the buffer.
+ *
+ * \return Number of octets rose_enc_etsi_CCNR_T_Request_ARG() will encode.
+ */
+size_t rose_enc_etsi_CCNR_T_Request_ARG_size(const union rose_msg_invoke_args *args)
+{
+	return asn1_enc_tlv_size(rose_enc_etsi_CC_T_Request_ARG_length(
+		&args->etsi.CCNR_T_Request));
+}
+
 /*!
  * \internal
  * \brief Encode the CCBS-T/CCNR-T-Request result facility ie arguments.
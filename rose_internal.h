@@ -47,6 +47,7 @@ extern "C" {
 /* Embedded-Q931-Types */
 unsigned char *rose_enc_Q931ie(struct pri *ctrl, unsigned char *pos, unsigned char *end,
 	unsigned tag, const struct roseQ931ie *q931ie);
+size_t rose_enc_Q931ie_size(const struct roseQ931ie *q931ie);
 
 const unsigned char *rose_dec_Q931ie(struct pri *ctrl, const char *name, unsigned tag,
 	const unsigned char *pos, const unsigned char *end, struct roseQ931ie *q931ie,
@@ -70,6 +71,12 @@ unsigned char *rose_enc_AddressScreened(struct pri *ctrl, unsigned char *pos,
 unsigned char *rose_enc_PresentedAddressScreened(struct pri *ctrl, unsigned char *pos,
 	unsigned char *end, const struct rosePresentedAddressScreened *party);
 
+size_t rose_enc_PartyNumber_size(const struct rosePartyNumber *party_number);
+size_t rose_enc_PartySubaddress_size(const struct rosePartySubaddress *party_subaddress);
+size_t rose_enc_Address_size(const struct roseAddress *address);
+size_t rose_enc_PresentedNumberUnscreened_size(
+	const struct rosePresentedNumberUnscreened *party);
+
 const unsigned char *rose_dec_PartyNumber(struct pri *ctrl, const char *name,
 	unsigned tag, const unsigned char *pos, const unsigned char *end,
 	struct rosePartyNumber *party_number);
@@ -94,116 +101,136 @@ const unsigned char *rose_dec_PresentedAddressScreened(struct pri *ctrl,
 	const char *name, unsigned tag, const unsigned char *pos, const unsigned char *end,
 	struct rosePresentedAddressScreened *party);
 
-/* ETSI Advice-of-Charge (AOC) */
-unsigned char *rose_enc_etsi_ChargingRequest_ARG(struct pri *ctrl, unsigned char *pos,
-	unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_ChargingRequest_RES(struct pri *ctrl, unsigned char *pos,
-	unsigned char *end, const union rose_msg_result_args *args);
-unsigned char *rose_enc_etsi_AOCSCurrency_ARG(struct pri *ctrl, unsigned char *pos,
-	unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_AOCSSpecialArr_ARG(struct pri *ctrl, unsigned char *pos,
-	unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_AOCDCurrency_ARG(struct pri *ctrl, unsigned char *pos,
-	unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_AOCDChargingUnit_ARG(struct pri *ctrl, unsigned char *pos,
-	unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_AOCECurrency_ARG(struct pri *ctrl, unsigned char *pos,
-	unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_AOCEChargingUnit_ARG(struct pri *ctrl, unsigned char *pos,
-	unsigned char *end, const union rose_msg_invoke_args *args);
+/* Generic descriptor driven argument codec */
+
+/*! \brief ASN.1 productions interpreted by the generic ROSE codec. */
+enum rose_codec_kind {
+	/*! INTEGER or ENUMERATED stored in a u_int8_t, int16_t, or 32 bit integer. */
+	ROSE_CODEC_INTEGER,
+	/*! BOOLEAN stored in a u_int8_t. */
+	ROSE_CODEC_BOOLEAN,
+	/*! NULL.  A nonzero size clears that much storage when decoded. */
+	ROSE_CODEC_NULL,
+	/*! Truncatable character string stored in a null terminated buffer. */
+	ROSE_CODEC_STRING,
+	/*! SEQUENCE of the component fields of the type. */
+	ROSE_CODEC_SEQUENCE,
+	/*! SEQUENCE OF or SET OF the record field of the type. */
+	ROSE_CODEC_SEQUENCE_OF,
+	/*! CHOICE of the alternative fields of the type. */
+	ROSE_CODEC_CHOICE,
+	/*! Production coded by the functions of the type. */
+	ROSE_CODEC_EXTERN
+};
+
+/*! The component is OPTIONAL or has a DEFAULT value of zero. */
+#define ROSE_CODEC_OPTIONAL		0x01
+/*!
+ * The presence octet of an OPTIONAL component is part of its value
+ * (a length or the DEFAULT value) so the decoder does not set it.
+ */
+#define ROSE_CODEC_IMPLIED		0x02
+
+/*! \brief Offset and storage size columns of a rose_codec_field. */
+#define ROSE_CODEC_MEMBER(type, member) \
+	offsetof(type, member), sizeof(((type *) 0)->member)
+
+struct rose_codec_type;
+
+/*! \brief Component of a ROSE argument described for the generic codec. */
+struct rose_codec_field {
+	/*! \brief Component name for APDU debug output. (NULL if none) */
+	const char *name;
+	/*! \brief Kind of ASN.1 production (enum rose_codec_kind) */
+	u_int8_t kind;
+	/*! \brief ROSE_CODEC_OPTIONAL and ROSE_CODEC_IMPLIED flags */
+	u_int8_t flags;
+	/*!
+	 * \brief Component tag.
+	 * \note The constructed bit is implied for SEQUENCE and SEQUENCE OF.
+	 * \note Zero for an untagged CHOICE.
+	 */
+	u_int8_t tag;
+	/*! \brief EXPLICIT tag wrapped around the component. (Zero if none) */
+	u_int8_t explicit_tag;
+	/*! \brief Offset of the component storage within the enclosing storage. */
+	u_int16_t offset;
+	/*! \brief Integer width, string buffer size, or Q.931 ie contents size. */
+	u_int16_t size;
+	/*! \brief Offset of the u_int8_t presence octet of an OPTIONAL component. */
+	u_int16_t present;
+	/*! \brief Discriminator value that selects this CHOICE alternative. */
+	u_int8_t choice;
+	/*! \brief Constructed or EXTERN production description. */
+	const struct rose_codec_type *type;
+};
+
+/*! \brief Constructed or EXTERN ROSE production described for the generic codec. */
+struct rose_codec_type {
+	/*! \brief Production name for APDU debug output. (NULL if none) */
+	const char *name;
+	/*! \brief SEQUENCE components, CHOICE alternatives, or the SEQUENCE OF record. */
+	const struct rose_codec_field *fields;
+	/*! \brief Number of fields[] */
+	u_int8_t num_fields;
+	/*! \brief SEQUENCE OF maximum number of records */
+	u_int8_t max_records;
+	/*! \brief Offset of the u_int8_t CHOICE discriminator or SEQUENCE OF count */
+	u_int16_t selector;
+	/*! \brief SEQUENCE OF distance between records */
+	u_int16_t record_size;
+
+	/*! \brief EXTERN encoder.  The tag is the field tag. */
+	unsigned char *(*encode)(struct pri *ctrl, unsigned char *pos, unsigned char *end,
+		unsigned tag, const void *value);
+	/*! \brief EXTERN encoded size.  (NULL if not known in advance) */
+	size_t (*size)(const void *value);
+	/*! \brief EXTERN decoder.  The size is the field size. */
+	const unsigned char *(*decode)(struct pri *ctrl, const char *name, unsigned tag,
+		const unsigned char *pos, const unsigned char *end, void *value, size_t size);
+	/*! \brief Determine if an untagged EXTERN production starts with the tag. */
+	int (*match)(unsigned tag);
+};
+
+extern const struct rose_codec_type rose_codec_PartyNumber;
+extern const struct rose_codec_type rose_codec_PartySubaddress;
+extern const struct rose_codec_type rose_codec_Address;
+extern const struct rose_codec_type rose_codec_PresentedNumberUnscreened;
+extern const struct rose_codec_type rose_codec_PresentedAddressScreened;
+extern const struct rose_codec_type rose_codec_Q931ie;
+
+unsigned char *rose_codec_encode(struct pri *ctrl, unsigned char *pos,
+	unsigned char *end, const struct rose_codec_field *field, const void *args);
+size_t rose_codec_size(const struct rose_codec_field *field, const void *args);
+const unsigned char *rose_codec_decode(struct pri *ctrl,
+	const struct rose_codec_field *field, unsigned tag, const unsigned char *pos,
+	const unsigned char *end, void *args);
 
-const unsigned char *rose_dec_etsi_ChargingRequest_ARG(struct pri *ctrl, unsigned tag,
-	const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_ChargingRequest_RES(struct pri *ctrl, unsigned tag,
-	const unsigned char *pos, const unsigned char *end,
-	union rose_msg_result_args *args);
-const unsigned char *rose_dec_etsi_AOCSCurrency_ARG(struct pri *ctrl, unsigned tag,
-	const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_AOCSSpecialArr_ARG(struct pri *ctrl, unsigned tag,
-	const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_AOCDCurrency_ARG(struct pri *ctrl, unsigned tag,
-	const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_AOCDChargingUnit_ARG(struct pri *ctrl, unsigned tag,
-	const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_AOCECurrency_ARG(struct pri *ctrl, unsigned tag,
-	const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_AOCEChargingUnit_ARG(struct pri *ctrl, unsigned tag,
-	const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
+/* ETSI Advice-of-Charge (AOC) */
+extern const struct rose_codec_field rose_codec_etsi_ChargingRequest_ARG;
+extern const struct rose_codec_field rose_codec_etsi_ChargingRequest_RES;
+extern const struct rose_codec_field rose_codec_etsi_AOCSCurrency_ARG;
+extern const struct rose_codec_field rose_codec_etsi_AOCSSpecialArr_ARG;
+extern const struct rose_codec_field rose_codec_etsi_AOCDCurrency_ARG;
+extern const struct rose_codec_field rose_codec_etsi_AOCDChargingUnit_ARG;
+extern const struct rose_codec_field rose_codec_etsi_AOCECurrency_ARG;
+extern const struct rose_codec_field rose_codec_etsi_AOCEChargingUnit_ARG;
 
 /* ETSI Call Diversion */
-unsigned char *rose_enc_etsi_ActivationDiversion_ARG(struct pri *ctrl,
-	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_DeactivationDiversion_ARG(struct pri *ctrl,
-	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_ActivationStatusNotificationDiv_ARG(struct pri *ctrl,
-	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_DeactivationStatusNotificationDiv_ARG(struct pri *ctrl,
-	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_InterrogationDiversion_ARG(struct pri *ctrl,
-	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_InterrogationDiversion_RES(struct pri *ctrl,
-	unsigned char *pos, unsigned char *end, const union rose_msg_result_args *args);
-unsigned char *rose_enc_etsi_DiversionInformation_ARG(struct pri *ctrl,
-	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_CallDeflection_ARG(struct pri *ctrl, unsigned char *pos,
-	unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_CallRerouting_ARG(struct pri *ctrl, unsigned char *pos,
-	unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_InterrogateServedUserNumbers_RES(struct pri *ctrl,
-	unsigned char *pos, unsigned char *end, const union rose_msg_result_args *args);
-unsigned char *rose_enc_etsi_DivertingLegInformation1_ARG(struct pri *ctrl,
-	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_DivertingLegInformation2_ARG(struct pri *ctrl,
-	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args);
-unsigned char *rose_enc_etsi_DivertingLegInformation3_ARG(struct pri *ctrl,
-	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args);
-
-const unsigned char *rose_dec_etsi_ActivationDiversion_ARG(struct pri *ctrl,
-	unsigned tag, const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_DeactivationDiversion_ARG(struct pri *ctrl,
-	unsigned tag, const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_ActivationStatusNotificationDiv_ARG(struct pri *ctrl,
-	unsigned tag, const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_DeactivationStatusNotificationDiv_ARG(struct pri
-	*ctrl, unsigned tag, const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_InterrogationDiversion_ARG(struct pri *ctrl,
-	unsigned tag, const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_InterrogationDiversion_RES(struct pri *ctrl,
-	unsigned tag, const unsigned char *pos, const unsigned char *end,
-	union rose_msg_result_args *args);
-const unsigned char *rose_dec_etsi_DiversionInformation_ARG(struct pri *ctrl,
-	unsigned tag, const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_CallDeflection_ARG(struct pri *ctrl, unsigned tag,
-	const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_CallRerouting_ARG(struct pri *ctrl, unsigned tag,
-	const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_InterrogateServedUserNumbers_RES(struct pri *ctrl,
-	unsigned tag, const unsigned char *pos, const unsigned char *end,
-	union rose_msg_result_args *args);
-const unsigned char *rose_dec_etsi_DivertingLegInformation1_ARG(struct pri *ctrl,
-	unsigned tag, const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_DivertingLegInformation2_ARG(struct pri *ctrl,
-	unsigned tag, const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
-const unsigned char *rose_dec_etsi_DivertingLegInformation3_ARG(struct pri *ctrl,
-	unsigned tag, const unsigned char *pos, const unsigned char *end,
-	union rose_msg_invoke_args *args);
+extern const struct rose_codec_field rose_codec_etsi_ActivationDiversion_ARG;
+extern const struct rose_codec_field rose_codec_etsi_DeactivationDiversion_ARG;
+extern const struct rose_codec_field rose_codec_etsi_ActivationStatusNotificationDiv_ARG;
+extern const struct rose_codec_field
+	rose_codec_etsi_DeactivationStatusNotificationDiv_ARG;
+extern const struct rose_codec_field rose_codec_etsi_InterrogationDiversion_ARG;
+extern const struct rose_codec_field rose_codec_etsi_InterrogationDiversion_RES;
+extern const struct rose_codec_field rose_codec_etsi_DiversionInformation_ARG;
+extern const struct rose_codec_field rose_codec_etsi_CallDeflection_ARG;
+extern const struct rose_codec_field rose_codec_etsi_CallRerouting_ARG;
+extern const struct rose_codec_field rose_codec_etsi_InterrogateServedUserNumbers_RES;
+extern const struct rose_codec_field rose_codec_etsi_DivertingLegInformation1_ARG;
+extern const struct rose_codec_field rose_codec_etsi_DivertingLegInformation2_ARG;
+extern const struct rose_codec_field rose_codec_etsi_DivertingLegInformation3_ARG;
 
 /* ETSI Explicit Call Transfer (ECT) */
 unsigned char *rose_enc_etsi_ExplicitEctExecute_ARG(struct pri *ctrl, unsigned char *pos,
@@ -349,6 +376,8 @@ unsigned char *rose_enc_etsi_CCBS_T_Request_ARG(struct pri *ctrl, unsigned char
 	unsigned char *end, const union rose_msg_invoke_args *args);
 unsigned char *rose_enc_etsi_CCNR_T_Request_ARG(struct pri *ctrl, unsigned char *pos,
 	unsigned char *end, const union rose_msg_invoke_args *args);
+size_t rose_enc_etsi_CCBS_T_Request_ARG_size(const union rose_msg_invoke_args *args);
+size_t rose_enc_etsi_CCNR_T_Request_ARG_size(const union rose_msg_invoke_args *args);
 unsigned char *rose_enc_etsi_CCBS_T_Request_RES(struct pri *ctrl, unsigned char *pos,
 	unsigned char *end, const union rose_msg_result_args *args);
 unsigned char *rose_enc_etsi_CCNR_T_Request_RES(struct pri *ctrl, unsigned char *pos,
@@ -388,6 +417,7 @@ const unsigned char *rose_dec_etsi_MWIIndicate_ARG(struct pri *ctrl, unsigned ta
 /* Q.SIG Name-Operations */
 unsigned char *rose_enc_qsig_Name(struct pri *ctrl, unsigned char *pos,
 	unsigned char *end, const struct roseQsigName *name);
+size_t rose_enc_qsig_Name_size(const struct roseQsigName *name);
 
 const unsigned char *rose_dec_qsig_Name(struct pri *ctrl, const char *fname,
 	unsigned tag, const unsigned char *pos, const unsigned char *end,
@@ -496,6 +526,12 @@ unsigned char *rose_enc_qsig_DivertingLegInformation2_ARG(struct pri *ctrl,
 	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args);
 unsigned char *rose_enc_qsig_DivertingLegInformation3_ARG(struct pri *ctrl,
 	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args);
+size_t rose_enc_qsig_DivertingLegInformation1_ARG_size(
+	const union rose_msg_invoke_args *args);
+size_t rose_enc_qsig_DivertingLegInformation2_ARG_size(
+	const union rose_msg_invoke_args *args);
+size_t rose_enc_qsig_DivertingLegInformation3_ARG_size(
+	const union rose_msg_invoke_args *args);
 
 const unsigned char *rose_dec_qsig_ActivateDiversionQ_ARG(struct pri *ctrl, unsigned tag,
 	const unsigned char *pos, const unsigned char *end,
@@ -568,6 +604,8 @@ unsigned char *rose_enc_qsig_CcbsRequest_ARG(struct pri *ctrl, unsigned char *po
 	unsigned char *end, const union rose_msg_invoke_args *args);
 unsigned char *rose_enc_qsig_CcnrRequest_ARG(struct pri *ctrl, unsigned char *pos,
 	unsigned char *end, const union rose_msg_invoke_args *args);
+size_t rose_enc_qsig_CcbsRequest_ARG_size(const union rose_msg_invoke_args *args);
+size_t rose_enc_qsig_CcnrRequest_ARG_size(const union rose_msg_invoke_args *args);
 unsigned char *rose_enc_qsig_CcbsRequest_RES(struct pri *ctrl, unsigned char *pos,
 	unsigned char *end, const union rose_msg_result_args *args);
 unsigned char *rose_enc_qsig_CcnrRequest_RES(struct pri *ctrl, unsigned char *pos,
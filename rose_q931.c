@@ -62,6 +62,18 @@ unsigned char *rose_enc_Q931ie(struct pri *ctrl, unsigned char *pos, unsigned ch
 	return asn1_enc_string_bin(pos, end, tag, q931ie->contents, q931ie->length);
 }
 
+/*!
+ * \brief Determine the encoded size of the Q.931 ie value.
+ *
+ * \param q931ie Q.931 ie information to encode.
+ *
+ * \return Number of octets rose_enc_Q931ie() will encode.
+ */
+size_t rose_enc_Q931ie_size(const struct roseQ931ie *q931ie)
+{
+	return asn1_enc_tlv_size(q931ie->length);
+}
+
 /*!
  * \brief Decode the Q.931 ie value.
  *
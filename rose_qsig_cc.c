@@ -68,6 +68,39 @@ static unsigned char *rose_enc_qsig_CcExtension(struct pri *ctrl, unsigned char
 	return asn1_enc_null(pos, end, ASN1_TYPE_NULL);
 }
 
+/*!
+ * \internal
+ * \brief Determine the encoded contents length of the CcRequestArg type.
+ *
+ * \param cc_request_arg Call-completion request arguments to encode.
+ *
+ * \return Number of octets rose_enc_qsig_CcRequestArg() will encode after the length.
+ */
+static size_t rose_enc_qsig_CcRequestArg_length(
+	const struct roseQsigCcRequestArg *cc_request_arg)
+{
+	size_t length;
+
+	length = rose_enc_PresentedNumberUnscreened_size(&cc_request_arg->number_a)
+		+ rose_enc_PartyNumber_size(&cc_request_arg->number_b)
+		+ rose_enc_Q931ie_size(&cc_request_arg->q931ie);
+	if (cc_request_arg->subaddr_a.length) {
+		length += asn1_enc_tlv_size(
+			rose_enc_PartySubaddress_size(&cc_request_arg->subaddr_a));
+	}
+	if (cc_request_arg->subaddr_b.length) {
+		length += asn1_enc_tlv_size(
+			rose_enc_PartySubaddress_size(&cc_request_arg->subaddr_b));
+	}
+	if (cc_request_arg->can_retain_service) {
+		length += ASN1_ENC_BOOLEAN_SIZE;
+	}
+	if (cc_request_arg->retain_sig_connection_present) {
+		length += ASN1_ENC_BOOLEAN_SIZE;
+	}
+	return length;
+}
+
 /*!
  * \internal
  * \brief Encode the CcRequestArg type.
@@ -86,10 +119,11 @@ static unsigned char *rose_enc_qsig_CcExtension(struct pri *ctrl, unsigned char
 static unsigned char *rose_enc_qsig_CcRequestArg(struct pri *ctrl, unsigned char *pos,
 	unsigned char *end, unsigned tag, const struct roseQsigCcRequestArg *cc_request_arg)
 {
-	unsigned char *seq_len;
-	unsigned char *exp_len;
+	unsigned char *seq_end;
+	unsigned char *exp_end;
 
-	ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, tag);
+	ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, tag,
+		rose_enc_qsig_CcRequestArg_length(cc_request_arg));
 
 	ASN1_CALL(pos, rose_enc_PresentedNumberUnscreened(ctrl, pos, end,
 		&cc_request_arg->number_a));
@@ -99,18 +133,20 @@ static unsigned char *rose_enc_qsig_CcRequestArg(struct pri *ctrl, unsigned char
 
 	if (cc_request_arg->subaddr_a.length) {
 		/* EXPLICIT tag */
-		ASN1_CONSTRUCTED_BEGIN(exp_len, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 10);
+		ASN1_CONSTRUCTED_BEGIN_SIZED(exp_end, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 10,
+			rose_enc_PartySubaddress_size(&cc_request_arg->subaddr_a));
 		ASN1_CALL(pos, rose_enc_PartySubaddress(ctrl, pos, end,
 			&cc_request_arg->subaddr_a));
-		ASN1_CONSTRUCTED_END(exp_len, pos, end);
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, exp_end, pos);
 	}
 
 	if (cc_request_arg->subaddr_b.length) {
 		/* EXPLICIT tag */
-		ASN1_CONSTRUCTED_BEGIN(exp_len, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 11);
+		ASN1_CONSTRUCTED_BEGIN_SIZED(exp_end, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 11,
+			rose_enc_PartySubaddress_size(&cc_request_arg->subaddr_b));
 		ASN1_CALL(pos, rose_enc_PartySubaddress(ctrl, pos, end,
 			&cc_request_arg->subaddr_b));
-		ASN1_CONSTRUCTED_END(exp_len, pos, end);
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, exp_end, pos);
 	}
 
 	if (cc_request_arg->can_retain_service) {
@@ -126,7 +162,7 @@ static unsigned char *rose_enc_qsig_CcRequestArg(struct pri *ctrl, unsigned char
 
 	/* No extension to encode */
 
-	ASN1_CONSTRUCTED_END(seq_len, pos, end);
+	ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
 
 	return pos;
 }
@@ -167,6 +203,34 @@ unsigned char *rose_enc_qsig_CcnrRequest_ARG(struct pri *ctrl, unsigned char *po
 		&args->qsig.CcnrRequest);
 }
 
+/*!
+ * \brief Determine the encoded size of the Q.SIG CcbsRequest invoke
+ * facility ie arguments.
+ *
+ * \param args Arguments to encode in the buffer.
+ *
+ * \return Number of octets rose_enc_qsig_CcbsRequest_ARG() will encode.
+ */
+size_t rose_enc_qsig_CcbsRequest_ARG_size(const union rose_msg_invoke_args *args)
+{
+	return asn1_enc_tlv_size(rose_enc_qsig_CcRequestArg_length(
+		&args->qsig.CcbsRequest));
+}
+
+/*!
+ * \brief Determine the encoded size of the Q.SIG CcnrRequest invoke
+ * facility ie arguments.
+ *
+ * \param args Arguments to encode in the buffer.
+ *
+ * \return Number of octets rose_enc_qsig_CcnrRequest_ARG() will encode.
+ */
+size_t rose_enc_qsig_CcnrRequest_ARG_size(const union rose_msg_invoke_args *args)
+{
+	return asn1_enc_tlv_size(rose_enc_qsig_CcRequestArg_length(
+		&args->qsig.CcnrRequest));
+}
+
 /*!
  * \internal
  * \brief Encode the CcRequestRes type.
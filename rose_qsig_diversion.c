@@ -381,6 +381,23 @@ unsigned char *rose_enc_qsig_CallRerouting_ARG(struct pri *ctrl, unsigned char *
 	return pos;
 }
 
+/*!
+ * \internal
+ * \brief Determine the encoded contents length of the DivertingLegInformation1 arguments.
+ *
+ * \param diverting_leg_information_1 Information to encode.
+ *
+ * \return Number of octets rose_enc_qsig_DivertingLegInformation1_ARG() will encode
+ * after the length.
+ */
+static size_t rose_enc_qsig_DivertingLegInformation1_ARG_length(
+	const struct roseQsigDivertingLegInformation1_ARG *diverting_leg_information_1)
+{
+	return asn1_enc_int_size(diverting_leg_information_1->diversion_reason)
+		+ asn1_enc_int_size(diverting_leg_information_1->subscription_option)
+		+ rose_enc_PartyNumber_size(&diverting_leg_information_1->nominated_number);
+}
+
 /*!
  * \brief Encode the DivertingLegInformation1 invoke facility ie arguments.
  *
@@ -396,11 +413,12 @@ unsigned char *rose_enc_qsig_DivertingLegInformation1_ARG(struct pri *ctrl,
 	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args)
 {
 	const struct roseQsigDivertingLegInformation1_ARG *diverting_leg_information_1;
-	unsigned char *seq_len;
-
-	ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, ASN1_TAG_SEQUENCE);
+	unsigned char *seq_end;
 
 	diverting_leg_information_1 = &args->qsig.DivertingLegInformation1;
+	ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, ASN1_TAG_SEQUENCE,
+		rose_enc_qsig_DivertingLegInformation1_ARG_length(diverting_leg_information_1));
+
 	ASN1_CALL(pos, asn1_enc_int(pos, end, ASN1_TYPE_ENUMERATED,
 		diverting_leg_information_1->diversion_reason));
 	ASN1_CALL(pos, asn1_enc_int(pos, end, ASN1_TYPE_ENUMERATED,
@@ -410,11 +428,65 @@ unsigned char *rose_enc_qsig_DivertingLegInformation1_ARG(struct pri *ctrl,
 
 	/* No extension to encode */
 
-	ASN1_CONSTRUCTED_END(seq_len, pos, end);
+	ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
 
 	return pos;
 }
 
+/*!
+ * \brief Determine the encoded size of the DivertingLegInformation1 invoke
+ * facility ie arguments.
+ *
+ * \param args Arguments to encode in the buffer.
+ *
+ * \return Number of octets rose_enc_qsig_DivertingLegInformation1_ARG() will encode.
+ */
+size_t rose_enc_qsig_DivertingLegInformation1_ARG_size(
+	const union rose_msg_invoke_args *args)
+{
+	return asn1_enc_tlv_size(rose_enc_qsig_DivertingLegInformation1_ARG_length(
+		&args->qsig.DivertingLegInformation1));
+}
+
+/*!
+ * \internal
+ * \brief Determine the encoded contents length of the DivertingLegInformation2 arguments.
+ *
+ * \param diverting_leg_information_2 Information to encode.
+ *
+ * \return Number of octets rose_enc_qsig_DivertingLegInformation2_ARG() will encode
+ * after the length.
+ */
+static size_t rose_enc_qsig_DivertingLegInformation2_ARG_length(
+	const struct roseQsigDivertingLegInformation2_ARG *diverting_leg_information_2)
+{
+	size_t length;
+
+	length = asn1_enc_int_size(diverting_leg_information_2->diversion_counter)
+		+ asn1_enc_int_size(diverting_leg_information_2->diversion_reason);
+	if (diverting_leg_information_2->original_diversion_reason_present) {
+		length += asn1_enc_int_size(
+			diverting_leg_information_2->original_diversion_reason);
+	}
+	if (diverting_leg_information_2->diverting_present) {
+		length += asn1_enc_tlv_size(rose_enc_PresentedNumberUnscreened_size(
+			&diverting_leg_information_2->diverting));
+	}
+	if (diverting_leg_information_2->original_called_present) {
+		length += asn1_enc_tlv_size(rose_enc_PresentedNumberUnscreened_size(
+			&diverting_leg_information_2->original_called));
+	}
+	if (diverting_leg_information_2->redirecting_name_present) {
+		length += asn1_enc_tlv_size(rose_enc_qsig_Name_size(
+			&diverting_leg_information_2->redirecting_name));
+	}
+	if (diverting_leg_information_2->original_called_name_present) {
+		length += asn1_enc_tlv_size(rose_enc_qsig_Name_size(
+			&diverting_leg_information_2->original_called_name));
+	}
+	return length;
+}
+
 /*!
  * \brief Encode the DivertingLegInformation2 invoke facility ie arguments.
  *
@@ -430,12 +502,13 @@ unsigned char *rose_enc_qsig_DivertingLegInformation2_ARG(struct pri *ctrl,
 	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args)
 {
 	const struct roseQsigDivertingLegInformation2_ARG *diverting_leg_information_2;
-	unsigned char *seq_len;
-	unsigned char *exp_len;
-
-	ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, ASN1_TAG_SEQUENCE);
+	unsigned char *seq_end;
+	unsigned char *exp_end;
 
 	diverting_leg_information_2 = &args->qsig.DivertingLegInformation2;
+	ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, ASN1_TAG_SEQUENCE,
+		rose_enc_qsig_DivertingLegInformation2_ARG_length(diverting_leg_information_2));
+
 	ASN1_CALL(pos, asn1_enc_int(pos, end, ASN1_TYPE_INTEGER,
 		diverting_leg_information_2->diversion_counter));
 	ASN1_CALL(pos, asn1_enc_int(pos, end, ASN1_TYPE_ENUMERATED,
@@ -447,43 +520,86 @@ unsigned char *rose_enc_qsig_DivertingLegInformation2_ARG(struct pri *ctrl,
 
 	if (diverting_leg_information_2->diverting_present) {
 		/* EXPLICIT tag */
-		ASN1_CONSTRUCTED_BEGIN(exp_len, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 1);
+		ASN1_CONSTRUCTED_BEGIN_SIZED(exp_end, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 1,
+			rose_enc_PresentedNumberUnscreened_size(
+				&diverting_leg_information_2->diverting));
 		ASN1_CALL(pos, rose_enc_PresentedNumberUnscreened(ctrl, pos, end,
 			&diverting_leg_information_2->diverting));
-		ASN1_CONSTRUCTED_END(exp_len, pos, end);
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, exp_end, pos);
 	}
 
 	if (diverting_leg_information_2->original_called_present) {
 		/* EXPLICIT tag */
-		ASN1_CONSTRUCTED_BEGIN(exp_len, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 2);
+		ASN1_CONSTRUCTED_BEGIN_SIZED(exp_end, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 2,
+			rose_enc_PresentedNumberUnscreened_size(
+				&diverting_leg_information_2->original_called));
 		ASN1_CALL(pos, rose_enc_PresentedNumberUnscreened(ctrl, pos, end,
 			&diverting_leg_information_2->original_called));
-		ASN1_CONSTRUCTED_END(exp_len, pos, end);
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, exp_end, pos);
 	}
 
 	if (diverting_leg_information_2->redirecting_name_present) {
 		/* EXPLICIT tag */
-		ASN1_CONSTRUCTED_BEGIN(exp_len, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 3);
+		ASN1_CONSTRUCTED_BEGIN_SIZED(exp_end, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 3,
+			rose_enc_qsig_Name_size(&diverting_leg_information_2->redirecting_name));
 		ASN1_CALL(pos, rose_enc_qsig_Name(ctrl, pos, end,
 			&diverting_leg_information_2->redirecting_name));
-		ASN1_CONSTRUCTED_END(exp_len, pos, end);
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, exp_end, pos);
 	}
 
 	if (diverting_leg_information_2->original_called_name_present) {
 		/* EXPLICIT tag */
-		ASN1_CONSTRUCTED_BEGIN(exp_len, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 4);
+		ASN1_CONSTRUCTED_BEGIN_SIZED(exp_end, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 4,
+			rose_enc_qsig_Name_size(&diverting_leg_information_2->original_called_name));
 		ASN1_CALL(pos, rose_enc_qsig_Name(ctrl, pos, end,
 			&diverting_leg_information_2->original_called_name));
-		ASN1_CONSTRUCTED_END(exp_len, pos, end);
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, exp_end, pos);
 	}
 
 	/* No extension to encode */
 
-	ASN1_CONSTRUCTED_END(seq_len, pos, end);
+	ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
 
 	return pos;
 }
 
+/*!
+ * \brief Determine the encoded size of the DivertingLegInformation2 invoke
+ * facility ie arguments.
+ *
+ * \param args Arguments to encode in the buffer.
+ *
+ * \return Number of octets rose_enc_qsig_DivertingLegInformation2_ARG() will encode.
+ */
+size_t rose_enc_qsig_DivertingLegInformation2_ARG_size(
+	const union rose_msg_invoke_args *args)
+{
+	return asn1_enc_tlv_size(rose_enc_qsig_DivertingLegInformation2_ARG_length(
+		&args->qsig.DivertingLegInformation2));
+}
+
+/*!
+ * \internal
+ * \brief Determine the encoded contents length of the DivertingLegInformation3 arguments.
+ *
+ * \param diverting_leg_information_3 Information to encode.
+ *
+ * \return Number of octets rose_enc_qsig_DivertingLegInformation3_ARG() will encode
+ * after the length.
+ */
+static size_t rose_enc_qsig_DivertingLegInformation3_ARG_length(
+	const struct roseQsigDivertingLegInformation3_ARG *diverting_leg_information_3)
+{
+	size_t length;
+
+	length = ASN1_ENC_BOOLEAN_SIZE;
+	if (diverting_leg_information_3->redirection_name_present) {
+		length += asn1_enc_tlv_size(rose_enc_qsig_Name_size(
+			&diverting_leg_information_3->redirection_name));
+	}
+	return length;
+}
+
 /*!
  * \brief Encode the DivertingLegInformation3 invoke facility ie arguments.
  *
@@ -499,30 +615,47 @@ unsigned char *rose_enc_qsig_DivertingLegInformation3_ARG(struct pri *ctrl,
 	unsigned char *pos, unsigned char *end, const union rose_msg_invoke_args *args)
 {
 	const struct roseQsigDivertingLegInformation3_ARG *diverting_leg_information_3;
-	unsigned char *seq_len;
-	unsigned char *exp_len;
-
-	ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, ASN1_TAG_SEQUENCE);
+	unsigned char *seq_end;
+	unsigned char *exp_end;
 
 	diverting_leg_information_3 = &args->qsig.DivertingLegInformation3;
+	ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, ASN1_TAG_SEQUENCE,
+		rose_enc_qsig_DivertingLegInformation3_ARG_length(diverting_leg_information_3));
+
 	ASN1_CALL(pos, asn1_enc_boolean(pos, end, ASN1_TYPE_BOOLEAN,
 		diverting_leg_information_3->presentation_allowed_indicator));
 
 	if (diverting_leg_information_3->redirection_name_present) {
 		/* EXPLICIT tag */
-		ASN1_CONSTRUCTED_BEGIN(exp_len, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 0);
+		ASN1_CONSTRUCTED_BEGIN_SIZED(exp_end, pos, end, ASN1_CLASS_CONTEXT_SPECIFIC | 0,
+			rose_enc_qsig_Name_size(&diverting_leg_information_3->redirection_name));
 		ASN1_CALL(pos, rose_enc_qsig_Name(ctrl, pos, end,
 			&diverting_leg_information_3->redirection_name));
-		ASN1_CONSTRUCTED_END(exp_len, pos, end);
+		ASN1_CONSTRUCTED_END_SIZED(ctrl, exp_end, pos);
 	}
 
 	/* No extension to encode */
 
-	ASN1_CONSTRUCTED_END(seq_len, pos, end);
+	ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
 
 	return pos;
 }
 
+/*!
+ * \brief Determine the encoded size of the DivertingLegInformation3 invoke
+ * facility ie arguments.
+ *
+ * \param args Arguments to encode in the buffer.
+ *
+ * \return Number of octets rose_enc_qsig_DivertingLegInformation3_ARG() will encode.
+ */
+size_t rose_enc_qsig_DivertingLegInformation3_ARG_size(
+	const union rose_msg_invoke_args *args)
+{
+	return asn1_enc_tlv_size(rose_enc_qsig_DivertingLegInformation3_ARG_length(
+		&args->qsig.DivertingLegInformation3));
+}
+
 /*!
  * \internal
  * \brief Decode the IntResult argument parameters.
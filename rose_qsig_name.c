@@ -62,15 +62,16 @@
 static unsigned char *rose_enc_qsig_NameSet(struct pri *ctrl, unsigned char *pos,
 	unsigned char *end, unsigned tag, const struct roseQsigName *name)
 {
-	unsigned char *seq_len;
+	unsigned char *seq_end;
 
-	ASN1_CONSTRUCTED_BEGIN(seq_len, pos, end, tag);
+	ASN1_CONSTRUCTED_BEGIN_SIZED(seq_end, pos, end, tag,
+		asn1_enc_tlv_size(name->length) + asn1_enc_int_size(name->char_set));
 
 	ASN1_CALL(pos, asn1_enc_string_bin(pos, end, ASN1_TYPE_OCTET_STRING, name->data,
 		name->length));
 	ASN1_CALL(pos, asn1_enc_int(pos, end, ASN1_TYPE_INTEGER, name->char_set));
 
-	ASN1_CONSTRUCTED_END(seq_len, pos, end);
+	ASN1_CONSTRUCTED_END_SIZED(ctrl, seq_end, pos);
 
 	return pos;
 }
@@ -125,6 +126,32 @@ unsigned char *rose_enc_qsig_Name(struct pri *ctrl, unsigned char *pos,
 	return pos;
 }
 
+/*!
+ * \brief Determine the encoded size of the Q.SIG Name type.
+ *
+ * \param name
+ *
+ * \return Number of octets rose_enc_qsig_Name() will encode.
+ */
+size_t rose_enc_qsig_Name_size(const struct roseQsigName *name)
+{
+	switch (name->presentation) {
+	case 1:	/* presentation_allowed */
+	case 2:	/* presentation_restricted */
+		if (name->char_set == 1) {
+			return asn1_enc_tlv_size(name->length);
+		}
+		return asn1_enc_tlv_size(asn1_enc_tlv_size(name->length)
+			+ asn1_enc_int_size(name->char_set));
+	case 3:	/* presentation_restricted_null */
+	case 4:	/* name_not_available */
+		return ASN1_ENC_NULL_SIZE;
+	default:
+		/* optional_name_not_present */
+		return 0;
+	}
+}
+
 /*!
  * \internal
  * \brief Encode the Q.SIG party-Name invoke facility ie arguments.
@@ -232,8 +259,8 @@ static const unsigned char *rose_dec_qsig_NameData(struct pri *ctrl, const char
 {
 	size_t str_len;
 
-	ASN1_CALL(pos, asn1_dec_string_bin(ctrl, fname, tag, pos, end, sizeof(name->data),
-		name->data, &str_len));
+	ASN1_CALL(pos, asn1_dec_string_bin_view(ctrl, fname, tag, pos, end,
+		sizeof(name->data), name->data, &str_len));
 	name->length = str_len;
 
 	return pos;
@@ -35,7 +35,9 @@
 #include "compat.h"
 #include "libpri.h"
 #include "pri_internal.h"
+#include "pri_facility.h"
 #include "rose.h"
+#include "asn1.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -1609,6 +1611,109 @@ static unsigned char rose_etsi_unused[] = {
 };
 
 
+static unsigned char rose_etsi_optional_any_order[] = {
+/* *INDENT-OFF* */
+/*
+ *	Context Specific/C [1 0x01] <A1> Len:27 <1B>
+ *		Integer(2 0x02) <02> Len:1 <01>
+ *			<4E>
+ *		Integer(2 0x02) <02> Len:1 <01>
+ *			<0C> -- DiversionInformation
+ *		Sequence/C(48 0x30) <30> Len:19 <13>
+ *			Enumerated(10 0x0A) <0A> Len:1 <01>
+ *				<03>
+ *			Enumerated(10 0x0A) <0A> Len:1 <01>
+ *				<05>
+ *			Context Specific/C [3 0x03] <A3> Len:3 <03>
+ *				Enumerated(10 0x0A) <0A> Len:1 <01>
+ *					<03>
+ *			Context Specific/C [2 0x02] <A2> Len:2 <02>
+ *				Context Specific [1 0x01] <81> Len:0 <00>
+ *			Context Specific/C [0 0x00] <A0> Len:2 <02>
+ *				Context Specific [1 0x01] <81> Len:0 <00>
+ */
+	0x91,
+	0xA1, 0x1B,
+		0x02, 0x01,
+			0x4E,
+		0x02, 0x01,
+			0x0C,
+		0x30, 0x13,
+			0x0A, 0x01,
+				0x03,
+			0x0A, 0x01,
+				0x05,
+			0xA3, 0x03,
+				0x0A, 0x01,
+					0x03,
+			0xA2, 0x02,
+				0x81, 0x00,
+			0xA0, 0x02,
+				0x81, 0x00
+/* *INDENT-ON* */
+};
+
+static const struct rose_message rose_etsi_optional_any_order_msg = {
+/* *INDENT-OFF* */
+	.type = ROSE_COMP_TYPE_INVOKE,
+	.component.invoke.operation = ROSE_ETSI_DiversionInformation,
+	.component.invoke.invoke_id = 78,
+	.component.invoke.args.etsi.DiversionInformation.diversion_reason = 3,
+	.component.invoke.args.etsi.DiversionInformation.basic_service = 5,
+	.component.invoke.args.etsi.DiversionInformation.calling_present = 1,
+	.component.invoke.args.etsi.DiversionInformation.calling.presentation = 1,
+	.component.invoke.args.etsi.DiversionInformation.last_diverting_present = 1,
+	.component.invoke.args.etsi.DiversionInformation.last_diverting.presentation = 1,
+	.component.invoke.args.etsi.DiversionInformation.last_diverting_reason_present = 1,
+	.component.invoke.args.etsi.DiversionInformation.last_diverting_reason = 3,
+/* *INDENT-ON* */
+};
+
+static unsigned char rose_etsi_optional_unknown[] = {
+/* *INDENT-OFF* */
+/*
+ *	Context Specific/C [1 0x01] <A1> Len:29 <1D>
+ *		Integer(2 0x02) <02> Len:1 <01>
+ *			<4E>
+ *		Integer(2 0x02) <02> Len:1 <01>
+ *			<0C> -- DiversionInformation
+ *		Sequence/C(48 0x30) <30> Len:21 <15>
+ *			Enumerated(10 0x0A) <0A> Len:1 <01>
+ *				<03>
+ *			Enumerated(10 0x0A) <0A> Len:1 <01>
+ *				<05>
+ *			Context Specific/C [3 0x03] <A3> Len:3 <03>
+ *				Enumerated(10 0x0A) <0A> Len:1 <01>
+ *					<03>
+ *			Context Specific [7 0x07] <87> Len:0 <00> -- Not a DiversionInformation component
+ *			Context Specific/C [2 0x02] <A2> Len:2 <02>
+ *				Context Specific [1 0x01] <81> Len:0 <00>
+ *			Context Specific/C [0 0x00] <A0> Len:2 <02>
+ *				Context Specific [1 0x01] <81> Len:0 <00>
+ */
+	0x91,
+	0xA1, 0x1D,
+		0x02, 0x01,
+			0x4E,
+		0x02, 0x01,
+			0x0C,
+		0x30, 0x15,
+			0x0A, 0x01,
+				0x03,
+			0x0A, 0x01,
+				0x05,
+			0xA3, 0x03,
+				0x0A, 0x01,
+					0x03,
+			0x87, 0x00,
+			0xA2, 0x02,
+				0x81, 0x00,
+			0xA0, 0x02,
+				0x81, 0x00
+/* *INDENT-ON* */
+};
+
+
 static const struct rose_message rose_qsig_msgs[] = {
 /* *INDENT-OFF* */
 	/* Q.SIG Name-Operations */
@@ -3046,6 +3151,368 @@ static void rose_test_exception(struct pri *ctrl, const char *name,
 		"************************************************************\n");
 }
 
+/*!
+ * \internal
+ * \brief Test ROSE decoding a message encoding gives the expected message.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param name Test name for the encoded message.
+ * \param msg_buf Encoded message to decode.
+ * \param msg_len Length of encoded message buffer.
+ * \param expected_msg Message data the encoding must decode to.
+ *
+ * \return Nothing
+ */
+static void rose_test_decode(struct pri *ctrl, const char *name,
+	const unsigned char *msg, size_t msg_len, const struct rose_message *expected_msg)
+{
+	const unsigned char *pos;
+	const unsigned char *end;
+	struct fac_extension_header header;
+	struct rose_message decoded_msg;
+
+	pri_message(ctrl, "\n\n"
+		"%s test: Message encoded length is %u\n", name, (unsigned) msg_len);
+
+	/* Clear the decoded message contents for comparison. */
+	memset(&decoded_msg, 0, sizeof(decoded_msg));
+
+	pos = msg;
+	end = msg + msg_len;
+	pos = facility_decode_header(ctrl, pos, end, &header);
+	if (!pos) {
+		pri_error(ctrl, "Error: %s test: Message failed to decode header\n", name);
+	} else {
+		pos = rose_decode(ctrl, pos, end, &decoded_msg);
+		if (!pos) {
+			pri_error(ctrl, "Error: %s test: Message failed to decode ROSE\n", name);
+		} else if (memcmp(expected_msg, &decoded_msg, sizeof(decoded_msg))) {
+			pri_error(ctrl, "Error: %s test: ROSE did not match\n", name);
+		}
+	}
+
+	pri_message(ctrl, "\n\n"
+		"************************************************************\n");
+}
+
+/*!
+ * \internal
+ * \brief Test ROSE decoding rejects an invalid message encoding.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param name Test name for the encoded message.
+ * \param msg_buf Encoded message to decode.
+ * \param msg_len Length of encoded message buffer.
+ *
+ * \return Nothing
+ */
+static void rose_test_invalid(struct pri *ctrl, const char *name,
+	const unsigned char *msg, size_t msg_len)
+{
+	const unsigned char *pos;
+	const unsigned char *end;
+	struct fac_extension_header header;
+	struct rose_message decoded_msg;
+
+	pri_message(ctrl, "\n\n"
+		"%s test: Message encoded length is %u\n", name, (unsigned) msg_len);
+
+	pos = msg;
+	end = msg + msg_len;
+	pos = facility_decode_header(ctrl, pos, end, &header);
+	if (!pos) {
+		pri_error(ctrl, "Error: %s test: Message failed to decode header\n", name);
+	} else {
+		while (pos < end) {
+			pos = rose_decode(ctrl, pos, end, &decoded_msg);
+			if (!pos) {
+				break;
+			}
+		}
+		if (pos) {
+			pri_error(ctrl, "Error: %s test: Invalid message decoded\n", name);
+		}
+	}
+
+	pri_message(ctrl, "\n\n"
+		"************************************************************\n");
+}
+
+/*!
+ * \internal
+ * \brief Test ROSE encoding and decoding a message longer than a short form length.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param name Test name for the message.
+ * \param encode_msg Message data to encode.
+ *
+ * \return Nothing
+ */
+static void rose_test_long_msg(struct pri *ctrl, const char *name,
+	const struct rose_message *encode_msg)
+{
+	static unsigned char buf[1024];
+	unsigned char *component;
+	unsigned char *enc_end;
+
+	component = facility_encode_header(ctrl, buf, buf + sizeof(buf), &fac_headers[0]);
+	enc_end = rose_encode(ctrl, component, buf + sizeof(buf), encode_msg);
+	if (!enc_end) {
+		pri_error(ctrl, "Error: %s test: Message failed to encode\n", name);
+		return;
+	}
+	if (!(component[1] & 0x80) || enc_end - component <= 2 + 127) {
+		pri_error(ctrl, "Error: %s test: Component length is not long form\n", name);
+	}
+	rose_test_decode(ctrl, name, buf, enc_end - buf, encode_msg);
+}
+
+/*!
+ * \internal
+ * \brief Test the precomputed long form lengths of long lists and diversion legs.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ *
+ * \return Nothing
+ */
+static void rose_test_long_lengths(struct pri *ctrl)
+{
+	static struct rose_message msg;
+	struct roseEtsiAOCSCurrencyInfoList *list;
+	struct roseQsigDivertingLegInformation2_ARG *leg;
+	unsigned idx;
+
+	ctrl->switchtype = PRI_SWITCH_EUROISDN_E1;
+	memset(&msg, 0, sizeof(msg));
+	msg.type = ROSE_COMP_TYPE_INVOKE;
+	msg.component.invoke.operation = ROSE_ETSI_AOCSCurrency;
+	msg.component.invoke.invoke_id = 200;
+	msg.component.invoke.args.etsi.AOCSCurrency.type = 1;
+	list = &msg.component.invoke.args.etsi.AOCSCurrency.currency_info;
+	list->num_records = ARRAY_LEN(list->list);
+	for (idx = 0; idx < list->num_records; ++idx) {
+		list->list[idx].charged_item = idx % 5;
+		list->list[idx].currency_type = 1;
+		strcpy((char *) list->list[idx].u.duration.currency, "Euro cents");
+		list->list[idx].u.duration.amount.currency = 16777215 - idx;
+		list->list[idx].u.duration.amount.multiplier = 6;
+		list->list[idx].u.duration.time.length = 65536 + idx;
+		list->list[idx].u.duration.time.scale = 4;
+		list->list[idx].u.duration.charging_type = 1;
+		list->list[idx].u.duration.granularity_present = 1;
+		list->list[idx].u.duration.granularity.length = 300;
+		list->list[idx].u.duration.granularity.scale = 4;
+	}
+	rose_test_long_msg(ctrl, "Long AOC-S currency list", &msg);
+
+	ctrl->switchtype = PRI_SWITCH_QSIG;
+	memset(&msg, 0, sizeof(msg));
+	msg.type = ROSE_COMP_TYPE_INVOKE;
+	msg.component.invoke.operation = ROSE_QSIG_DivertingLegInformation2;
+	msg.component.invoke.invoke_id = 201;
+	leg = &msg.component.invoke.args.qsig.DivertingLegInformation2;
+	leg->diversion_counter = 15;
+	leg->diversion_reason = 3;
+	leg->original_diversion_reason_present = 1;
+	leg->original_diversion_reason = 2;
+	leg->diverting_present = 1;
+	leg->diverting.presentation = 0;
+	leg->diverting.number.plan = 1;
+	leg->diverting.number.ton = 1;
+	leg->diverting.number.length = 20;
+	strcpy((char *) leg->diverting.number.str, "12345678901234567890");
+	leg->original_called_present = 1;
+	leg->original_called.presentation = 0;
+	leg->original_called.number.plan = 1;
+	leg->original_called.number.ton = 1;
+	leg->original_called.number.length = 20;
+	strcpy((char *) leg->original_called.number.str, "09876543210987654321");
+	leg->redirecting_name_present = 1;
+	leg->redirecting_name.presentation = 1;
+	leg->redirecting_name.char_set = 1;
+	leg->redirecting_name.length = 50;
+	memset(leg->redirecting_name.data, 'R', 50);
+	leg->original_called_name_present = 1;
+	leg->original_called_name.presentation = 1;
+	leg->original_called_name.char_set = 1;
+	leg->original_called_name.length = 50;
+	memset(leg->original_called_name.data, 'O', 50);
+	rose_test_long_msg(ctrl, "Long diversion leg", &msg);
+}
+
+/*!
+ * \internal
+ * \brief Check a ROSE string copied to a Q.931 string.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ * \param name Test name of the string.
+ * \param copied Q.931 string the ROSE string was copied to.
+ * \param expected String the copy must give.
+ *
+ * \return Nothing
+ */
+static void rose_test_view_copy(struct pri *ctrl, const char *name, const char *copied,
+	const char *expected)
+{
+	if (strcmp(copied, expected)) {
+		pri_error(ctrl, "Error: String views test: %s is \"%s\" not \"%s\"\n", name,
+			copied, expected);
+	}
+}
+
+/*!
+ * \internal
+ * \brief Test the party strings decoded into a facility ie are copied out.
+ *
+ * \param ctrl D channel controller for diagnostic messages or global options.
+ *
+ * \return Nothing
+ */
+static void rose_test_string_views(struct pri *ctrl)
+{
+	static struct rose_message encode_msg;
+	static struct rose_message decoded[2];
+	static struct rose_message copy;
+	static unsigned char buf[1024];
+	struct roseQsigCallRerouting_ARG *args;
+	struct asn1_string_views views;
+	struct q931_party_number number;
+	struct q931_party_subaddress subaddress;
+	struct q931_party_name name;
+	struct fac_extension_header header;
+	const unsigned char *start;
+	unsigned char *enc_end;
+	unsigned idx;
+
+	pri_message(ctrl, "\n\n"
+		"String views test\n");
+
+	encode_msg.type = ROSE_COMP_TYPE_INVOKE;
+	encode_msg.component.invoke.operation = ROSE_QSIG_CallRerouting;
+	encode_msg.component.invoke.invoke_id = 80;
+	args = &encode_msg.component.invoke.args.qsig.CallRerouting;
+	args->rerouting_reason = 3;
+	args->called.number.plan = 4;
+	args->called.number.length = 4;
+	strcpy((char *) args->called.number.str, "8340");
+	args->called.subaddress.type = 0;
+	args->called.subaddress.length = 4;
+	strcpy((char *) args->called.subaddress.u.user_specified.information, "1234");
+	args->diversion_counter = 5;
+	args->q931ie.length = 2;
+	memcpy(args->q931ie_contents, "RT", 2);
+	args->last_rerouting.presentation = 0;
+	args->last_rerouting.number.plan = 4;
+	args->last_rerouting.number.length = 4;
+	strcpy((char *) args->last_rerouting.number.str, "1111");
+	args->original_called_present = 1;
+	args->original_called.presentation = 0;
+	args->original_called.number.plan = 4;
+	args->original_called.number.length = 4;
+	strcpy((char *) args->original_called.number.str, "2222");
+	args->subscription_option = 2;
+	args->calling_subaddress.type = 1;
+	args->calling_subaddress.length = 4;
+	strcpy((char *) args->calling_subaddress.u.nsap, "3253");
+	args->calling.presentation = 0;
+	args->calling.screened.number.plan = 4;
+	args->calling.screened.number.length = 4;
+	strcpy((char *) args->calling.screened.number.str, "5555");
+	args->calling_name_present = 1;
+	args->calling_name.presentation = 1;
+	args->calling_name.char_set = 1;
+	args->calling_name.length = 5;
+	strcpy((char *) args->calling_name.data, "Alice");
+	args->redirecting_name_present = 1;
+	args->redirecting_name.presentation = 1;
+	args->redirecting_name.char_set = 1;
+	args->redirecting_name.length = 3;
+	strcpy((char *) args->redirecting_name.data, "Bob");
+	args->original_called_name_present = 1;
+	args->original_called_name.presentation = 1;
+	args->original_called_name.char_set = 1;
+	args->original_called_name.length = 5;
+	strcpy((char *) args->original_called_name.data, "Carol");
+
+	enc_end = rose_encode(ctrl, facility_encode_header(ctrl, buf, buf + sizeof(buf),
+		&fac_headers[0]), buf + sizeof(buf), &encode_msg);
+	if (!enc_end) {
+		pri_error(ctrl, "Error: String views test: Message failed to encode\n");
+		return;
+	}
+
+	/*
+	 * Decode the component twice without forgetting the views of the
+	 * first.  The second decode runs out of views part way through so
+	 * the rest of its strings must be copied instead.
+	 */
+	memset(&views, 0, sizeof(views));
+	ctrl->rose_string_views = &views;
+	start = facility_decode_header(ctrl, buf, enc_end, &header);
+	for (idx = 0; start && idx < ARRAY_LEN(decoded); ++idx) {
+		if (!rose_decode(ctrl, start, enc_end, &decoded[idx])) {
+			start = NULL;
+		}
+	}
+	if (!start) {
+		pri_error(ctrl, "Error: String views test: Message failed to decode\n");
+		ctrl->rose_string_views = NULL;
+		return;
+	}
+	if (views.num_views != ARRAY_LEN(views.view)) {
+		pri_error(ctrl, "Error: String views test: %u views recorded\n", views.num_views);
+	}
+	if (decoded[0].component.invoke.args.qsig.CallRerouting.calling_name.data[0]
+		|| decoded[0].component.invoke.args.qsig.CallRerouting.called.number.str[0]) {
+		pri_error(ctrl, "Error: String views test: Strings not left in place\n");
+	}
+	if (!decoded[1].component.invoke.args.qsig.CallRerouting.original_called_name.data[0]) {
+		pri_error(ctrl, "Error: String views test: Strings not copied without views\n");
+	}
+
+	for (idx = 0; idx < ARRAY_LEN(decoded); ++idx) {
+		args = &decoded[idx].component.invoke.args.qsig.CallRerouting;
+
+		q931_party_number_init(&number);
+		rose_copy_number_to_q931(ctrl, &number, &args->called.number);
+		rose_test_view_copy(ctrl, "called number", number.str, "8340");
+		q931_party_subaddress_init(&subaddress);
+		rose_copy_subaddress_to_q931(ctrl, &subaddress, &args->called.subaddress);
+		rose_test_view_copy(ctrl, "called subaddress", (char *) subaddress.data, "1234");
+		q931_party_number_init(&number);
+		rose_copy_presented_number_unscreened_to_q931(ctrl, &number,
+			&args->original_called);
+		rose_test_view_copy(ctrl, "original called number", number.str, "2222");
+		q931_party_subaddress_init(&subaddress);
+		rose_copy_subaddress_to_q931(ctrl, &subaddress, &args->calling_subaddress);
+		rose_test_view_copy(ctrl, "calling subaddress", (char *) subaddress.data, "3253");
+		q931_party_number_init(&number);
+		rose_copy_presented_number_screened_to_q931(ctrl, &number, &args->calling);
+		rose_test_view_copy(ctrl, "calling number", number.str, "5555");
+		q931_party_name_init(&name);
+		rose_copy_name_to_q931(ctrl, &name, &args->calling_name);
+		rose_test_view_copy(ctrl, "calling name", name.str, "Alice");
+		q931_party_name_init(&name);
+		rose_copy_name_to_q931(ctrl, &name, &args->redirecting_name);
+		rose_test_view_copy(ctrl, "redirecting name", name.str, "Bob");
+		q931_party_name_init(&name);
+		rose_copy_name_to_q931(ctrl, &name, &args->original_called_name);
+		rose_test_view_copy(ctrl, "original called name", name.str, "Carol");
+	}
+
+	/* A copy of the structure has no views so its strings are empty. */
+	copy = decoded[0];
+	q931_party_name_init(&name);
+	rose_copy_name_to_q931(ctrl, &name,
+		&copy.component.invoke.args.qsig.CallRerouting.calling_name);
+	rose_test_view_copy(ctrl, "copied calling name", name.str, "");
+
+	ctrl->rose_string_views = NULL;
+
+	pri_message(ctrl, "\n\n"
+		"************************************************************\n");
+}
+
 /*!
  * \brief ROSE encode/decode test program.
  *
@@ -3061,6 +3528,12 @@ int main(int argc, char *argv[])
 	unsigned offset;
 	const char *str;
 	static struct pri dummy_ctrl;
+	static const int dialect_switches[] = {
+		PRI_SWITCH_EUROISDN_E1,
+		PRI_SWITCH_QSIG,
+		PRI_SWITCH_DMS100,
+		PRI_SWITCH_NI2,
+	};
 
 	pri_set_message(rose_pri_message);
 	pri_set_error(rose_pri_error);
@@ -3160,6 +3633,13 @@ int main(int argc, char *argv[])
 	rose_test_exception(&dummy_ctrl, "Unused components", rose_etsi_unused,
 		sizeof(rose_etsi_unused));
 
+	rose_test_decode(&dummy_ctrl, "Optional components in any order",
+		rose_etsi_optional_any_order, sizeof(rose_etsi_optional_any_order),
+		&rose_etsi_optional_any_order_msg);
+
+	rose_test_invalid(&dummy_ctrl, "Unknown optional component",
+		rose_etsi_optional_unknown, sizeof(rose_etsi_optional_unknown));
+
 	dummy_ctrl.switchtype = PRI_SWITCH_QSIG;
 
 	rose_test_exception(&dummy_ctrl, "Multiple component messages",
@@ -3171,6 +3651,26 @@ int main(int argc, char *argv[])
 	rose_test_exception(&dummy_ctrl, "2nd edition name encoded messages",
 		rose_qsig_name_2nd_encode_msg, sizeof(rose_qsig_name_2nd_encode_msg));
 
+	rose_test_long_lengths(&dummy_ctrl);
+
+	dummy_ctrl.switchtype = PRI_SWITCH_QSIG;
+
+	rose_test_string_views(&dummy_ctrl);
+
+/* ------------------------------------------------------------------- */
+
+	pri_message(&dummy_ctrl, "\n\n"
+		"Check the ROSE dialect lookup indexes\n");
+	for (index = 0; index < ARRAY_LEN(dialect_switches); ++index) {
+		dummy_ctrl.switchtype = dialect_switches[index];
+		if (rose_dialect_check(&dummy_ctrl)) {
+			pri_error(&dummy_ctrl, "Error: %s ROSE dialect lookups failed\n",
+				pri_switch2str(dialect_switches[index]));
+		}
+	}
+	pri_message(&dummy_ctrl, "\n\n"
+		"************************************************************\n");
+
 /* ------------------------------------------------------------------- */
 
 	pri_message(&dummy_ctrl, "\n\n"
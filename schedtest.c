@@ -0,0 +1,546 @@
+/*
+ * libpri: An implementation of Primary Rate ISDN
+ *
+ * See http://www.asterisk.org for more information about
+ * the Asterisk project. Please do not directly contact
+ * any of the maintainers of this project for assistance;
+ * the project provides a web site, mailing lists and IRC
+ * channels for your use.
+ *
+ * This program is free software, distributed under the terms of
+ * the GNU General Public License Version 2 as published by the
+ * Free Software Foundation. See the LICENSE file included with
+ * this program for more details.
+ *
+ * In addition, when this program is distributed with Asterisk in
+ * any form that would qualify as a 'combined work' or as a
+ * 'derivative work' (but not mere aggregation), you can redistribute
+ * and/or modify the combination under the terms of the license
+ * provided with that copy of Asterisk, instead of the license
+ * terms granted here.
+ */
+
+/*!
+ * \file
+ * \brief Timer scheduler test program
+ */
+
+
+#include "compat.h"
+#include "libpri.h"
+#include "pri_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+/* ------------------------------------------------------------------- */
+
+/*! Number of test failures found. */
+static unsigned sched_failures;
+
+/*! Number of times test_timer_expire() was called. */
+static unsigned timer_expired;
+
+/*! Timer id started by test_timer_restart(). */
+static pri_sched_id timer_restarted;
+
+/*! D channel test_timer_event() generates events on. */
+static struct pri *event_ctrl;
+
+#define SCHED_CHECK(ctrl, cond)	\
+	do {	\
+		if (!(cond)) {	\
+			pri_error(ctrl, "Error: %s:%d: Check failed: %s\n", __FILE__, __LINE__,	\
+				#cond);	\
+			++sched_failures;	\
+		}	\
+	} while (0)
+
+/* ------------------------------------------------------------------- */
+
+static void sched_pri_message(struct pri *ctrl, char *stuff)
+{
+}
+
+static void sched_pri_error(struct pri *ctrl, char *stuff)
+{
+	fprintf(stderr, "%s", stuff);
+}
+
+static int sched_io_read(struct pri *ctrl, void *buf, int buflen)
+{
+	return 0;
+}
+
+static int sched_io_write(struct pri *ctrl, void *buf, int buflen)
+{
+	return buflen;
+}
+
+/*!
+ * \internal
+ * \brief Get a time offset from the given time.
+ *
+ * \param when Filled with the offset time.
+ * \param base Time to offset.
+ * \param ms Milliseconds to add to the base time.  (May be negative)
+ *
+ * \return Nothing
+ */
+static void sched_time_offset(struct timeval *when, const struct timeval *base, int ms)
+{
+	long usec;
+
+	usec = base->tv_usec + (ms % 1000) * 1000L;
+	when->tv_sec = base->tv_sec + ms / 1000;
+	if (usec < 0) {
+		usec += 1000000;
+		--when->tv_sec;
+	} else if (1000000 <= usec) {
+		usec -= 1000000;
+		++when->tv_sec;
+	}
+	when->tv_usec = usec;
+}
+
+/*!
+ * \internal
+ * \brief Run all timers expired at the given time.
+ *
+ * \param ctrl D channel controller.
+ * \param now Current scheduler clock time to use.
+ *
+ * \return Nothing
+ */
+static void sched_run_all(struct pri *ctrl, const struct timeval *now)
+{
+	while (pri_schedule_run_tv(ctrl, now)) {
+	}
+}
+
+static void test_timer_expire(void *data)
+{
+	++timer_expired;
+}
+
+static void test_timer_restart(void *data)
+{
+	timer_restarted = pri_schedule_event(data, 1000, test_timer_expire, NULL);
+}
+
+static void test_timer_event(void *data)
+{
+	memset(&event_ctrl->ev, 0, sizeof(event_ctrl->ev));
+	event_ctrl->ev.command_done.e = PRI_EVENT_COMMAND_DONE;
+	event_ctrl->ev.command_done.data = data;
+	pri_event_ready(event_ctrl);
+}
+
+static void test_reactor_event(void *data)
+{
+	struct pri *ctrl = data;
+
+	memset(&ctrl->ev, 0, sizeof(ctrl->ev));
+	ctrl->ev.command_done.e = PRI_EVENT_COMMAND_DONE;
+	ctrl->ev.command_done.data = ctrl;
+	pri_event_ready(ctrl);
+}
+
+static void test_reactor_burst(void *data)
+{
+	test_reactor_event(data);
+	test_reactor_event(data);
+	test_reactor_event(data);
+}
+
+/* ------------------------------------------------------------------- */
+
+/*!
+ * \internal
+ * \brief Test the supplied scheduler time only applies during the run.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return Nothing
+ */
+static void sched_test_run_tv(struct pri *ctrl)
+{
+	struct timeval now;
+	struct timeval when;
+	pri_sched_id id;
+
+	/* A timer restarted by an expired timer is relative to the supplied time. */
+	pri_schedule_now(&now);
+	sched_time_offset(&when, &now, 60000);
+	timer_expired = 0;
+	timer_restarted = 0;
+	id = pri_schedule_event(ctrl, 0, test_timer_restart, ctrl);
+	SCHED_CHECK(ctrl, id != 0);
+	sched_run_all(ctrl, &when);
+	SCHED_CHECK(ctrl, timer_restarted != 0);
+	SCHED_CHECK(ctrl, pri_schedule_next_ms(ctrl, &when) == 1000);
+	sched_time_offset(&when, &when, 999);
+	sched_run_all(ctrl, &when);
+	SCHED_CHECK(ctrl, timer_expired == 0);
+	sched_time_offset(&when, &when, 1);
+	sched_run_all(ctrl, &when);
+	SCHED_CHECK(ctrl, timer_expired == 1);
+
+	/* A timer started after the run uses the scheduler clock again. */
+	pri_schedule_now(&now);
+	sched_time_offset(&when, &now, -10000);
+	sched_run_all(ctrl, &when);
+	timer_expired = 0;
+	id = pri_schedule_event(ctrl, 5000, test_timer_expire, NULL);
+	SCHED_CHECK(ctrl, id != 0);
+	pri_schedule_now(&now);
+	sched_run_all(ctrl, &now);
+	SCHED_CHECK(ctrl, timer_expired == 0);
+	SCHED_CHECK(ctrl, pri_schedule_check(ctrl, id, test_timer_expire, NULL));
+	SCHED_CHECK(ctrl, 4000 < pri_schedule_next_ms(ctrl, &now));
+	pri_schedule_del(ctrl, id);
+
+	/* Partial milliseconds round up even when the microseconds borrow. */
+	pri_schedule_now(&now);
+	sched_time_offset(&when, &now, 60000);
+	when.tv_usec = 500;
+	timer_restarted = 0;
+	id = pri_schedule_event(ctrl, 0, test_timer_restart, ctrl);
+	SCHED_CHECK(ctrl, id != 0);
+	sched_run_all(ctrl, &when);
+	SCHED_CHECK(ctrl, timer_restarted != 0);
+	/* The timer now expires at when + 1000 ms which has tv_usec 500. */
+	now.tv_sec = when.tv_sec;
+	now.tv_usec = 999000;
+	SCHED_CHECK(ctrl, pri_schedule_next_ms(ctrl, &now) == 2);
+	now.tv_usec = 999600;
+	SCHED_CHECK(ctrl, pri_schedule_next_ms(ctrl, &now) == 1);
+	now.tv_sec = when.tv_sec - 1;
+	now.tv_usec = 999000;
+	SCHED_CHECK(ctrl, pri_schedule_next_ms(ctrl, &now) == 1002);
+	id = timer_restarted;
+	pri_schedule_del(ctrl, id);
+}
+
+/*!
+ * \internal
+ * \brief Test collecting the events of several expired timers in one call.
+ *
+ * \param ctrl D channel controller.
+ * \param queue_size Size of the event queue to use.  (0 for no queue)
+ *
+ * \return Nothing
+ */
+static void sched_test_batch(struct pri *ctrl, unsigned queue_size)
+{
+	static char marks[5];
+	pri_event events[3];
+	struct timeval now;
+	unsigned idx;
+	int count;
+
+	SCHED_CHECK(ctrl, !pri_event_queue_enable(ctrl, queue_size));
+	event_ctrl = ctrl;
+	for (idx = 0; idx < ARRAY_LEN(marks); ++idx) {
+		pri_schedule_event(ctrl, idx, test_timer_event, &marks[idx]);
+	}
+	pri_schedule_now(&now);
+	sched_time_offset(&now, &now, 100);
+
+	count = pri_schedule_run_batch(ctrl, &now, events, NULL, ARRAY_LEN(events));
+	SCHED_CHECK(ctrl, count == 3);
+	for (idx = 0; idx < count; ++idx) {
+		SCHED_CHECK(ctrl, events[idx].e == PRI_EVENT_COMMAND_DONE
+			&& events[idx].command_done.data == &marks[idx]);
+	}
+	count = pri_schedule_run_batch(ctrl, &now, events, NULL, ARRAY_LEN(events));
+	SCHED_CHECK(ctrl, count == 2);
+	for (idx = 0; idx < count; ++idx) {
+		SCHED_CHECK(ctrl, events[idx].e == PRI_EVENT_COMMAND_DONE
+			&& events[idx].command_done.data == &marks[3 + idx]);
+	}
+	count = pri_schedule_run_batch(ctrl, &now, events, NULL, ARRAY_LEN(events));
+	SCHED_CHECK(ctrl, count == 0);
+	SCHED_CHECK(ctrl, !pri_event_next(ctrl));
+
+	SCHED_CHECK(ctrl, !pri_event_queue_enable(ctrl, 0));
+}
+
+/*!
+ * \internal
+ * \brief Create a D channel controller for the tests.
+ *
+ * \return D channel controller or NULL on error.
+ */
+static struct pri *sched_new_ctrl(void)
+{
+	/* A PTMP NT controller starts no timers of its own until a TEI is assigned. */
+	return pri_new_bri_cb(-1, 0, PRI_NETWORK, PRI_SWITCH_EUROISDN_E1, sched_io_read,
+		sched_io_write, NULL);
+}
+
+/*!
+ * \internal
+ * \brief Test a stale timer id stays stale however often its slot is reused.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return Nothing
+ */
+static void sched_test_stale_id(struct pri *ctrl)
+{
+	pri_sched_id stale;
+	pri_sched_id id;
+	unsigned count;
+	unsigned failed;
+
+	stale = pri_schedule_event(ctrl, 1000, test_timer_expire, NULL);
+	SCHED_CHECK(ctrl, stale != 0);
+	pri_schedule_del(ctrl, stale);
+	SCHED_CHECK(ctrl, !pri_schedule_check(ctrl, stale, test_timer_expire, NULL));
+
+	/* Cycle through the free list so every slot gets reused hundreds of times. */
+	failed = 0;
+	for (count = 500 * ctrl->sched.num_slots; count--;) {
+		id = pri_schedule_event(ctrl, 1000, test_timer_expire, NULL);
+		if (!id || id == stale || pri_schedule_check(ctrl, stale, test_timer_expire, NULL)) {
+			++failed;
+		}
+		pri_schedule_del(ctrl, stale);
+		if (!pri_schedule_check(ctrl, id, test_timer_expire, NULL)) {
+			/* Deleting the stale id deleted the new timer. */
+			++failed;
+		}
+		pri_schedule_del(ctrl, id);
+	}
+	SCHED_CHECK(ctrl, failed == 0);
+}
+
+/*!
+ * \internal
+ * \brief Test the timer pool grows well past the old slot limits.
+ *
+ * \param ctrl D channel controller.
+ *
+ * \return Nothing
+ */
+static void sched_test_grow(struct pri *ctrl)
+{
+	static pri_sched_id ids[300000];
+	struct timeval now;
+	unsigned idx;
+	unsigned failed;
+
+	failed = 0;
+	for (idx = 0; idx < ARRAY_LEN(ids); ++idx) {
+		ids[idx] = pri_schedule_event(ctrl, 1000 + idx % 1000, test_timer_expire, NULL);
+		if (!ids[idx]) {
+			++failed;
+		}
+	}
+	SCHED_CHECK(ctrl, failed == 0);
+	SCHED_CHECK(ctrl, ARRAY_LEN(ids) <= ctrl->sched.num_active);
+
+	/* Delete every other timer and let the rest expire. */
+	for (idx = 0; idx < ARRAY_LEN(ids); idx += 2) {
+		pri_schedule_del(ctrl, ids[idx]);
+	}
+	pri_schedule_now(&now);
+	sched_time_offset(&now, &now, 3000);
+	timer_expired = 0;
+	sched_run_all(ctrl, &now);
+	SCHED_CHECK(ctrl, timer_expired == ARRAY_LEN(ids) / 2);
+	for (idx = 0; idx < ARRAY_LEN(ids); ++idx) {
+		if (pri_schedule_check(ctrl, ids[idx], test_timer_expire, NULL)) {
+			++failed;
+		}
+	}
+	SCHED_CHECK(ctrl, failed == 0);
+}
+
+/*!
+ * \internal
+ * \brief Test timer ids of different D channels never alias.
+ *
+ * \return Nothing
+ */
+static void sched_test_tags(void)
+{
+	static struct pri *ctrls[300];
+	struct pri *master;
+	pri_sched_id id;
+	unsigned idx;
+	unsigned other;
+	unsigned failed;
+
+	failed = 0;
+	for (idx = 0; idx < ARRAY_LEN(ctrls); ++idx) {
+		ctrls[idx] = sched_new_ctrl();
+		if (!ctrls[idx]) {
+			++failed;
+			break;
+		}
+		for (other = 0; other < idx; ++other) {
+			if (ctrls[other]->sched.tag == ctrls[idx]->sched.tag) {
+				++failed;
+			}
+		}
+	}
+	SCHED_CHECK(NULL, failed == 0);
+	if (failed) {
+		return;
+	}
+
+	/* A timer started on one NFAS D channel can be deleted through another. */
+	master = ctrls[0];
+	pri_enslave(master, ctrls[ARRAY_LEN(ctrls) - 1]);
+	id = pri_schedule_event(ctrls[ARRAY_LEN(ctrls) - 1], 1000, test_timer_expire, NULL);
+	SCHED_CHECK(master, pri_schedule_check(master, id, test_timer_expire, NULL));
+	pri_schedule_del(master, id);
+	SCHED_CHECK(master, !pri_schedule_check(ctrls[ARRAY_LEN(ctrls) - 1], id,
+		test_timer_expire, NULL));
+}
+
+/*!
+ * \internal
+ * \brief Test the reactor runs the timers of its controllers in deadline order.
+ *
+ * \return Nothing
+ */
+static void sched_test_reactor(void)
+{
+	static struct pri *ctrls[40];
+	struct pri_reactor *reactor;
+	struct pri *ctrl;
+	pri_event *e;
+	pri_sched_id id;
+	int fds[ARRAY_LEN(ctrls)][2];
+	unsigned idx;
+	unsigned count;
+
+	reactor = pri_reactor_new();
+	if (!reactor) {
+		/* The reactor is not available on this platform. */
+		return;
+	}
+	for (idx = 0; idx < ARRAY_LEN(ctrls); ++idx) {
+		if (pipe(fds[idx])) {
+			SCHED_CHECK(NULL, 0);
+			return;
+		}
+		ctrls[idx] = pri_new_bri_cb(fds[idx][0], 0, PRI_NETWORK, PRI_SWITCH_EUROISDN_E1,
+			sched_io_read, sched_io_write, NULL);
+		SCHED_CHECK(NULL, ctrls[idx] && !pri_reactor_add(reactor, ctrls[idx]));
+		if (!ctrls[idx] || ctrls[idx]->sched.reactor != reactor) {
+			return;
+		}
+	}
+
+	/* Each controller starts with an immediate D channel up timer. */
+	for (count = 0; count < ARRAY_LEN(ctrls); ++count) {
+		e = pri_reactor_run(reactor, 1000, &ctrl);
+		SCHED_CHECK(NULL, e != NULL && e->e == PRI_EVENT_DCHAN_UP);
+	}
+	for (idx = 0; idx < ARRAY_LEN(ctrls); ++idx) {
+		SCHED_CHECK(ctrls[idx], ctrls[idx]->sched.reactor_pos == (unsigned) -1);
+	}
+
+	/*
+	 * Controller idx gets a timer expiring after (idx * 7) % 40 steps.
+	 * An earlier timer deleted again must not leave a stale deadline.
+	 */
+	for (idx = 0; idx < ARRAY_LEN(ctrls); ++idx) {
+		id = pri_schedule_event(ctrls[idx], 1, test_timer_expire, NULL);
+		pri_schedule_event(ctrls[idx], 20 + 3 * ((idx * 7) % ARRAY_LEN(ctrls)),
+			test_reactor_event, ctrls[idx]);
+		pri_schedule_del(ctrls[idx], id);
+	}
+	SCHED_CHECK(NULL, !pri_reactor_remove(reactor, ctrls[5]));
+	SCHED_CHECK(NULL, ctrls[5]->sched.reactor == NULL);
+	for (count = 0; count < ARRAY_LEN(ctrls); ++count) {
+		if (count == (5 * 7) % ARRAY_LEN(ctrls)) {
+			/* The removed controller is not run. */
+			continue;
+		}
+		ctrl = NULL;
+		e = pri_reactor_run(reactor, 1000, &ctrl);
+		if (!e) {
+			SCHED_CHECK(NULL, e != NULL);
+			break;
+		}
+		SCHED_CHECK(ctrl, e->e == PRI_EVENT_COMMAND_DONE && e->command_done.data == ctrl);
+		for (idx = 0; idx < ARRAY_LEN(ctrls) && ctrls[idx] != ctrl; ++idx) {
+		}
+		SCHED_CHECK(ctrl, idx < ARRAY_LEN(ctrls) && (idx * 7) % ARRAY_LEN(ctrls) == count);
+		SCHED_CHECK(ctrl, ctrl->sched.reactor_pos == (unsigned) -1);
+	}
+	SCHED_CHECK(NULL, pri_reactor_run(reactor, 0, &ctrl) == NULL);
+
+	/* Every event queued by one controller is returned before moving on. */
+	SCHED_CHECK(ctrls[0], !pri_event_queue_enable(ctrls[0], 16));
+	pri_schedule_event(ctrls[0], 10, test_reactor_burst, ctrls[0]);
+	pri_schedule_event(ctrls[1], 10, test_reactor_event, ctrls[1]);
+	usleep(20000);
+	for (count = 0; count < 3; ++count) {
+		ctrl = NULL;
+		e = pri_reactor_run(reactor, count ? 0 : 1000, &ctrl);
+		SCHED_CHECK(ctrl, e != NULL && ctrl == ctrls[0]);
+		pri_event_release(ctrls[0]);
+	}
+	e = pri_reactor_run(reactor, 1000, &ctrl);
+	SCHED_CHECK(ctrl, e != NULL && ctrl == ctrls[1]);
+	SCHED_CHECK(NULL, pri_reactor_run(reactor, 0, &ctrl) == NULL);
+
+	pri_reactor_destroy(reactor);
+	for (idx = 0; idx < ARRAY_LEN(ctrls); ++idx) {
+		SCHED_CHECK(ctrls[idx], ctrls[idx]->sched.reactor == NULL);
+		close(fds[idx][0]);
+		close(fds[idx][1]);
+	}
+}
+
+/* ------------------------------------------------------------------- */
+
+/*!
+ * \brief Timer scheduler test program.
+ *
+ * \param argc Program argument count.
+ * \param argv Program argument string array.
+ *
+ * \retval 0 on success.
+ * \retval Nonzero on error.
+ */
+int main(int argc, char *argv[])
+{
+	struct pri *ctrl;
+
+	pri_set_message(sched_pri_message);
+	pri_set_error(sched_pri_error);
+
+	ctrl = sched_new_ctrl();
+	if (!ctrl) {
+		fprintf(stderr, "Could not create D channel controller\n");
+		return 1;
+	}
+	sched_test_run_tv(ctrl);
+	sched_test_batch(ctrl, 0);
+	sched_test_batch(ctrl, 16);
+	sched_test_stale_id(ctrl);
+	sched_test_grow(ctrl);
+
+	sched_test_tags();
+	sched_test_reactor();
+
+	if (sched_failures) {
+		fprintf(stderr, "%u scheduler checks failed\n", sched_failures);
+		return 1;
+	}
+	printf("Scheduler tests passed\n");
+	return 0;
+}
+
+/* ------------------------------------------------------------------- */
+/* end schedtest.c */